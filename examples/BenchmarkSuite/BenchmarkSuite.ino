@@ -0,0 +1,364 @@
+/*
+* Harmonic Scheduler benchmark suite.
+* Measures, for the configured profile level and dispatch policy:
+* - dispatch_idle: Loop() pass cost with N attached tasks, none due (ns per pass).
+* - dispatch_run: cost per task run with N always due tasks (ns per run, including the pass).
+* - attach / detach: cost per Attach() and per Detach() of the first task, the worst case (ns per call).
+* - timer_lateness_avg / max: periodic task start lateness, with idle sleep disabled and enabled (us).
+*   The difference between both is the idle sleep wake cost.
+* - isr_*_avg / max: trigger pin write to listener call, for each Interrupt* task type (us).
+*   Measured with the scheduler awake. On AVR the external interrupt fires on an output write, no wiring is needed;
+*   on other platforms wire TriggerPin to InterruptPin. Without it, the rows report "na".
+*
+* Results are printed once as CSV rows (benchmark,tasks,value,unit), after '#' comment lines with the configuration.
+* Save the output per platform and release, then compare two captures with compare_benchmarks.py:
+*   python3 compare_benchmarks.py baseline.csv current.csv --threshold 10
+*/
+
+//#define HARMONIC_SKIP_CHECKS // Uncomment to skip safety checks.
+//#define HARMONIC_WIDE_TASK_ID // Uncomment for 16-bit task IDs, to measure 1024 tasks.
+
+#include <Arduino.h>
+
+#include <HarmonicScheduler.h>
+#include "BenchmarkTasks.h"
+
+static constexpr auto ProfileLevel = Harmonic::ProfileLevelEnum::None;
+static constexpr auto Dispatch = Harmonic::DispatchPolicyEnum::Linear;
+
+// Largest task count measured, limited by RAM on small AVR boards.
+#if defined(ARDUINO_AVR_MEGA2560)
+static constexpr Harmonic::task_id_t MaxTaskCount = 128;
+#elif defined(ARDUINO_ARCH_AVR)
+static constexpr Harmonic::task_id_t MaxTaskCount = 32;
+#elif defined(HARMONIC_WIDE_TASK_ID)
+static constexpr Harmonic::task_id_t MaxTaskCount = 1024;
+#else
+static constexpr Harmonic::task_id_t MaxTaskCount = Harmonic::TASK_MAX_COUNT;
+#endif
+static constexpr uint16_t TaskCounts[] = { 1, 8, 32, 128, 254, 1024 };
+
+// Interrupt pins: the ISR benchmark writes TriggerPin and listens on InterruptPin.
+#if defined(ARDUINO_ARCH_AVR) || defined(HARMONIC_PLATFORM_HOST)
+static constexpr uint8_t InterruptPin = 2;
+static constexpr uint8_t TriggerPin = InterruptPin;
+#else
+static constexpr uint8_t InterruptPin = 2;
+static constexpr uint8_t TriggerPin = 3;
+#endif
+
+static constexpr uint32_t DispatchWork = 8192;
+static constexpr uint32_t AttachWork = 1024;
+static constexpr uint32_t TimerPeriod = 10;
+static constexpr uint16_t TimerRuns = 50;
+static constexpr uint8_t IsrRuns = 32;
+static constexpr uint32_t IsrTimeout = 100000;
+
+// Dispatch and Attach/Detach runner, with idle sleep disabled.
+Harmonic::TemplateScheduler<MaxTaskCount, false, ProfileLevel, Dispatch> Runner{};
+Benchmark::EmptyTask Tasks[MaxTaskCount]{};
+Benchmark::LatenessProbeTask Probe(Runner);
+
+// Idle sleep runner, for timer lateness and ISR latency.
+Harmonic::TemplateScheduler<6, true, ProfileLevel, Dispatch> SleepRunner{};
+Benchmark::LatenessProbeTask SleepProbe(SleepRunner);
+Benchmark::EmptyTask KeepAlive{};
+
+// Interrupt task types, sharing a single probe listener.
+Benchmark::InterruptProbe IsrProbe{};
+Harmonic::InterruptFlag::CallbackTask FlagTask(SleepRunner);
+Harmonic::InterruptSignal::CallbackTask<uint8_t> SignalTask(SleepRunner);
+Harmonic::InterruptEvent::CallbackTask<> EventTask(SleepRunner);
+Harmonic::InterruptBuffer::CallbackTask<uint8_t, 4> BufferTask(SleepRunner);
+
+enum class IsrSourceEnum : uint8_t
+{
+	Flag,
+	Signal,
+	Event,
+	Buffer
+};
+
+volatile IsrSourceEnum IsrSource = IsrSourceEnum::Flag;
+uint8_t TriggerLevel = LOW;
+
+void OnBenchmarkInterrupt()
+{
+	switch (IsrSource)
+	{
+	case IsrSourceEnum::Flag:
+		FlagTask.OnInterrupt();
+		break;
+	case IsrSourceEnum::Signal:
+		SignalTask.OnInterrupt();
+		break;
+	case IsrSourceEnum::Event:
+		EventTask.OnInterrupt();
+		break;
+	default:
+		BufferTask.OnInterrupt(0);
+		break;
+	}
+}
+
+void PrintRow(const __FlashStringHelper* name, const uint16_t tasks, const uint32_t value, const __FlashStringHelper* unit)
+{
+	Serial.print(name);
+	Serial.print(',');
+	Serial.print(tasks);
+	Serial.print(',');
+	Serial.print(value);
+	Serial.print(',');
+	Serial.println(unit);
+}
+
+void PrintMissingRow(const __FlashStringHelper* name, const __FlashStringHelper* unit)
+{
+	Serial.print(name);
+	Serial.print(F(",1,na,"));
+	Serial.println(unit);
+}
+
+uint32_t GetNanosPerOp(const uint32_t elapsedMicros, const uint32_t operations)
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(elapsedMicros) * 1000) / operations);
+}
+
+void PrintConfiguration()
+{
+	Serial.println(F("# HarmonicScheduler benchmark suite"));
+	Serial.print(F("# platform="));
+#if defined(ARDUINO_ARCH_AVR)
+	Serial.print(F("avr"));
+#elif defined(ARDUINO_ARCH_ESP32)
+	Serial.print(F("esp32"));
+#elif defined(ARDUINO_ARCH_ESP8266)
+	Serial.print(F("esp8266"));
+#elif defined(ARDUINO_ARCH_RP2040)
+	Serial.print(F("rp2040"));
+#elif defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_STM32F1) || defined(ARDUINO_ARCH_STM32F4)
+	Serial.print(F("stm32"));
+#elif defined(ARDUINO_ARCH_NRF52)
+	Serial.print(F("nrf52"));
+#elif defined(HARMONIC_PLATFORM_HOST)
+	Serial.print(F("host"));
+#else
+	Serial.print(F("other"));
+#endif
+	Serial.print(F(" f_cpu="));
+#if defined(F_CPU)
+	Serial.println(static_cast<uint32_t>(F_CPU));
+#else
+	Serial.println(0);
+#endif
+
+	Serial.print(F("# profile="));
+	switch (ProfileLevel)
+	{
+	case Harmonic::ProfileLevelEnum::Base:
+		Serial.print(F("Base"));
+		break;
+	case Harmonic::ProfileLevelEnum::Full:
+		Serial.print(F("Full"));
+		break;
+	case Harmonic::ProfileLevelEnum::Latency:
+		Serial.print(F("Latency"));
+		break;
+	default:
+		Serial.print(F("None"));
+		break;
+	}
+	Serial.print(F(" dispatch="));
+	Serial.print((Dispatch == Harmonic::DispatchPolicyEnum::Deadline) ? F("Deadline") : F("Linear"));
+	Serial.print(F(" skip_checks="));
+#if defined(HARMONIC_SKIP_CHECKS)
+	Serial.println(1);
+#else
+	Serial.println(0);
+#endif
+	Serial.println(F("benchmark,tasks,value,unit"));
+}
+
+bool AttachTasks(const Harmonic::task_id_t taskCount)
+{
+	for (Harmonic::task_id_t i = 0; i < taskCount; i++)
+	{
+		if (!Runner.Attach(&Tasks[i], Harmonic::Platform::MillisToTicks(60000), true))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void DetachTasks(const Harmonic::task_id_t taskCount)
+{
+	// Detach the first task each time, which moves or shifts the others.
+	for (Harmonic::task_id_t i = 0; i < taskCount; i++)
+	{
+		Runner.Detach(&Tasks[i]);
+	}
+}
+
+bool BenchmarkDispatch(const Harmonic::task_id_t taskCount)
+{
+	// Scale the pass and cycle counts so every task count does similar work.
+	const uint32_t passes = (DispatchWork / taskCount) > 32 ? (DispatchWork / taskCount) : 32;
+	const uint32_t cycles = (AttachWork / taskCount) > 1 ? (AttachWork / taskCount) : 1;
+
+	uint32_t attachTime = 0;
+	uint32_t detachTime = 0;
+	for (uint32_t c = 0; c < cycles; c++)
+	{
+		uint32_t start = micros();
+		if (!AttachTasks(taskCount))
+		{
+			return false;
+		}
+		attachTime += micros() - start;
+
+		start = micros();
+		DetachTasks(taskCount);
+		detachTime += micros() - start;
+	}
+	PrintRow(F("attach"), taskCount, GetNanosPerOp(attachTime, cycles * taskCount), F("ns"));
+	PrintRow(F("detach"), taskCount, GetNanosPerOp(detachTime, cycles * taskCount), F("ns"));
+
+	if (!AttachTasks(taskCount))
+	{
+		return false;
+	}
+
+	// No task due: the pass only scans.
+	uint32_t start = micros();
+	for (uint32_t p = 0; p < passes; p++)
+	{
+		Runner.Loop();
+	}
+	PrintRow(F("dispatch_idle"), taskCount, GetNanosPerOp(micros() - start, passes), F("ns"));
+
+	// Every task due on every pass.
+	for (Harmonic::task_id_t i = 0; i < taskCount; i++)
+	{
+		Runner.SetPeriod(Runner.GetTaskIdAt(i), 0);
+	}
+	start = micros();
+	for (uint32_t p = 0; p < passes; p++)
+	{
+		Runner.Loop();
+	}
+	PrintRow(F("dispatch_run"), taskCount, GetNanosPerOp(micros() - start, passes * taskCount), F("ns"));
+
+	DetachTasks(taskCount);
+
+	return Runner.GetTaskCount() == 0;
+}
+
+template<typename Scheduler>
+void BenchmarkTimer(Scheduler& scheduler, Benchmark::LatenessProbeTask& probe, const uint8_t idleSleep)
+{
+	if (!probe.Start(TimerPeriod, TimerRuns))
+	{
+		return;
+	}
+
+	while (!probe.IsDone())
+	{
+		scheduler.Loop();
+	}
+	probe.Detach();
+
+	PrintRow(idleSleep ? F("timer_lateness_avg_sleep") : F("timer_lateness_avg"), 1, probe.LatenessSum / TimerRuns, F("us"));
+	PrintRow(idleSleep ? F("timer_lateness_max_sleep") : F("timer_lateness_max"), 1, probe.LatenessMax, F("us"));
+}
+
+void BenchmarkIsr(const IsrSourceEnum source, const __FlashStringHelper* avgName, const __FlashStringHelper* maxName)
+{
+	IsrSource = source;
+
+	uint32_t sum = 0;
+	uint32_t max = 0;
+	for (uint_fast8_t i = 0; i < IsrRuns; i++)
+	{
+		IsrProbe.Done = false;
+		TriggerLevel = (TriggerLevel == LOW) ? HIGH : LOW;
+		const uint32_t trigger = micros();
+		digitalWrite(TriggerPin, TriggerLevel);
+
+		while (!IsrProbe.Done)
+		{
+			SleepRunner.Loop();
+			if ((micros() - trigger) > IsrTimeout)
+			{
+				PrintMissingRow(avgName, F("us"));
+				PrintMissingRow(maxName, F("us"));
+				return;
+			}
+		}
+
+		const uint32_t latency = IsrProbe.ListenerTime - trigger;
+		sum += latency;
+		if (latency > max)
+		{
+			max = latency;
+		}
+	}
+
+	PrintRow(avgName, 1, sum / IsrRuns, F("us"));
+	PrintRow(maxName, 1, max, F("us"));
+}
+
+void setup()
+{
+	Serial.begin(115200);
+
+	while (!Serial)
+		;;
+
+	delay(1000);
+
+	PrintConfiguration();
+
+	for (uint_fast8_t c = 0; c < (sizeof(TaskCounts) / sizeof(TaskCounts[0])); c++)
+	{
+		if (TaskCounts[c] <= MaxTaskCount && !BenchmarkDispatch(TaskCounts[c]))
+		{
+			Serial.println(F("# dispatch setup error"));
+		}
+	}
+
+	BenchmarkTimer(Runner, Probe, 0);
+	BenchmarkTimer(SleepRunner, SleepProbe, 1);
+
+	// The keep alive bounds idle sleep, should the interrupt never fire.
+	if (!SleepRunner.Attach(&KeepAlive, Harmonic::Platform::MillisToTicks(TimerPeriod), true)
+		|| !FlagTask.AttachListener(&IsrProbe)
+		|| !SignalTask.AttachListener(&IsrProbe)
+		|| !EventTask.AttachListener(&IsrProbe)
+		|| !BufferTask.AttachListener(&IsrProbe))
+	{
+		Serial.println(F("# isr setup error"));
+	}
+	else
+	{
+		pinMode(TriggerPin, OUTPUT);
+		digitalWrite(TriggerPin, TriggerLevel);
+		if (TriggerPin != InterruptPin)
+		{
+			pinMode(InterruptPin, INPUT);
+		}
+		attachInterrupt(digitalPinToInterrupt(InterruptPin), OnBenchmarkInterrupt, CHANGE);
+
+		BenchmarkIsr(IsrSourceEnum::Flag, F("isr_flag_avg"), F("isr_flag_max"));
+		BenchmarkIsr(IsrSourceEnum::Signal, F("isr_signal_avg"), F("isr_signal_max"));
+		BenchmarkIsr(IsrSourceEnum::Event, F("isr_event_avg"), F("isr_event_max"));
+		BenchmarkIsr(IsrSourceEnum::Buffer, F("isr_buffer_avg"), F("isr_buffer_max"));
+	}
+
+	Serial.println(F("# done"));
+}
+
+void loop()
+{
+}
@@ -0,0 +1,130 @@
+#ifndef _BENCHMARK_TASKS_h
+#define _BENCHMARK_TASKS_h
+
+#include <HarmonicScheduler.h>
+
+namespace Benchmark
+{
+	/// <summary>
+	/// Task with an empty Run(), for dispatch and Attach/Detach costs.
+	/// Tracks its own ID, so Detach by pointer is O(1) to resolve.
+	/// </summary>
+	class EmptyTask : public Harmonic::ITask
+	{
+	private:
+		Harmonic::task_id_t Id = Harmonic::TASK_INVALID_ID;
+
+	public:
+		void Run() final {}
+
+		void OnTaskIdUpdated(const Harmonic::task_id_t taskId) final
+		{
+			Id = taskId;
+		}
+
+		bool GetAssignedTaskId(Harmonic::task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+	};
+
+	/// <summary>
+	/// Periodic task measuring how late each run starts, relative to its first run.
+	/// </summary>
+	class LatenessProbeTask : public Harmonic::DynamicTask
+	{
+	private:
+		uint32_t FirstRun = 0;
+		uint32_t PeriodMicros = 0;
+		uint16_t Target = 0;
+
+	public:
+		uint32_t LatenessSum = 0;
+		uint32_t LatenessMax = 0;
+		uint16_t Runs = 0;
+
+	public:
+		LatenessProbeTask(Harmonic::TaskRegistry& registry) : Harmonic::DynamicTask(registry) {}
+
+		bool Start(const uint32_t periodMillis, const uint16_t runs)
+		{
+			PeriodMicros = periodMillis * 1000;
+			Target = runs;
+			LatenessSum = 0;
+			LatenessMax = 0;
+			Runs = 0;
+
+			return Attach(Harmonic::Platform::MillisToTicks(periodMillis), true);
+		}
+
+		bool IsDone() const
+		{
+			return Runs > Target;
+		}
+
+		void Run() final
+		{
+			const uint32_t now = micros();
+			if (Runs == 0)
+			{
+				FirstRun = now;
+			}
+			else
+			{
+				const uint32_t elapsed = now - FirstRun;
+				const uint32_t scheduled = uint32_t(Runs) * PeriodMicros;
+				const uint32_t lateness = (elapsed > scheduled) ? elapsed - scheduled : 0;
+				LatenessSum += lateness;
+				if (lateness > LatenessMax)
+				{
+					LatenessMax = lateness;
+				}
+			}
+			Runs++;
+		}
+	};
+
+	/// <summary>
+	/// Listener for every Interrupt* task type, stamping the time its Run() reached the listener.
+	/// </summary>
+	class InterruptProbe
+		: public Harmonic::InterruptFlag::InterruptListener
+		, public Harmonic::InterruptSignal::InterruptListener<uint8_t>
+		, public Harmonic::InterruptEvent::InterruptListener<uint8_t>
+		, public Harmonic::InterruptBuffer::InterruptListener<uint8_t>
+	{
+	public:
+		uint32_t ListenerTime = 0;
+		bool Done = false;
+
+	public:
+		void OnFlagInterrupt() final
+		{
+			Stamp();
+		}
+
+		void OnSignalInterrupt(const uint8_t /*signalCount*/) final
+		{
+			Stamp();
+		}
+
+		void OnEventInterrupt(const uint32_t /*timestamp*/, const uint8_t /*interruptions*/) final
+		{
+			Stamp();
+		}
+
+		void OnBufferInterrupt(const Harmonic::InterruptBuffer::EventBatch<uint8_t>& /*events*/, const uint32_t /*overflowCount*/) final
+		{
+			Stamp();
+		}
+
+	private:
+		void Stamp()
+		{
+			ListenerTime = micros();
+			Done = true;
+		}
+	};
+}
+#endif
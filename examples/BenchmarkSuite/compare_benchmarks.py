@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Regression table for Harmonic Scheduler benchmark suite captures (BenchmarkSuite.ino).
+
+Compares two saved serial captures, row by row, and prints one table with the
+relative change. Every benchmark is a cost or a latency: higher is worse.
+Exits with status 1 if any row regressed beyond the threshold, for use in scripts.
+
+Usage:
+    python3 compare_benchmarks.py baseline.csv current.csv --threshold 10
+
+Capture format: '#' comment lines with the configuration, a
+"benchmark,tasks,value,unit" header, then one row per result. Values may be
+"na" when a benchmark could not run (e.g. the interrupt pins are not wired).
+"""
+
+import argparse
+import sys
+
+
+def load(path):
+    config = []
+    rows = {}
+    with open(path, encoding="utf-8", errors="replace") as capture:
+        for line in capture:
+            line = line.strip()
+            if not line:
+                continue
+            if line.startswith("#"):
+                if "=" in line:
+                    config.append(line[1:].strip())
+                continue
+            fields = line.split(",")
+            if len(fields) != 4 or fields[0] == "benchmark":
+                continue
+            name, tasks, value, unit = fields
+            try:
+                rows[(name, int(tasks))] = (None if value == "na" else int(value), unit)
+            except ValueError:
+                continue
+    return config, rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two Harmonic Scheduler benchmark suite captures.")
+    parser.add_argument("baseline", help="baseline capture file")
+    parser.add_argument("current", help="current capture file")
+    parser.add_argument("--threshold", type=float, default=10.0, help="regression threshold in percent")
+    parser.add_argument("--min-delta", type=int, default=2, help="ignore changes up to this many units, below timer resolution")
+    args = parser.parse_args()
+
+    base_config, base_rows = load(args.baseline)
+    current_config, current_rows = load(args.current)
+
+    print("baseline: " + " | ".join(base_config))
+    print("current:  " + " | ".join(current_config))
+    print("{:<26}{:>6}{:>12}{:>12}{:>9}  {}".format("BENCHMARK", "TASKS", "BASELINE", "CURRENT", "CHANGE", "UNIT"))
+
+    regressions = 0
+    for key in sorted(set(base_rows) | set(current_rows)):
+        base, unit = base_rows.get(key, (None, ""))
+        current, unit = current_rows.get(key, (None, unit))
+
+        status = ""
+        if base is None or current is None:
+            change = "-"
+        else:
+            delta = current - base
+            change = "{:+.1f}%".format(100.0 * delta / base) if base else "-"
+            if delta > args.min_delta and (base == 0 or (100.0 * delta / base) > args.threshold):
+                status = "  REGRESSION"
+                regressions += 1
+
+        print("{:<26}{:>6}{:>12}{:>12}{:>9}  {}{}".format(
+            key[0], key[1],
+            "na" if base is None else base,
+            "na" if current is None else current,
+            change, unit, status))
+
+    if regressions:
+        print("{} regression(s) above {}%".format(regressions, args.threshold))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+/*
+* Harmonic Scheduler binary trace example.
+* Streams full profiling traces as compact binary frames, instead of text.
+* Decode on the host with decode_trace.py, e.g.:
+*   python3 decode_trace.py /dev/ttyUSB0 --baud 115200
+* Frames are written a chunk at a time, so the log task never stalls the scheduler on serial output.
+*/
+
+#include <Arduino.h>
+#include <HarmonicScheduler.h>
+
+// Scheduler configuration, binary traces require full profiling.
+static constexpr bool IdleSleep = true;
+static constexpr uint8_t MaxTaskCount = 3 + 1; // 3 test tasks + 1 log task.
+
+Harmonic::TemplateScheduler<MaxTaskCount, IdleSleep, Harmonic::ProfileLevelEnum::Full> Runner{};
+
+// Binary trace log task: one frame per second, in chunks of up to 16 bytes.
+Harmonic::BinaryTraceLogTask<MaxTaskCount, 1000, 16> LogTask(Runner, Runner, Serial);
+
+// Test tasks.
+void BlinkFunction()
+{
+	digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+}
+
+void BusyFunction()
+{
+	delayMicroseconds(500);
+}
+
+void LongFunction()
+{
+	delay(5);
+}
+
+Harmonic::CallableTask Blink(Runner, BlinkFunction);
+Harmonic::CallableTask Busy(Runner, BusyFunction);
+Harmonic::CallableTask Long(Runner, LongFunction);
+
+void halt()
+{
+	while (true)
+	{
+		delay(1000);
+	}
+}
+
+void setup()
+{
+	Serial.begin(115200);
+	pinMode(LED_BUILTIN, OUTPUT);
+
+	// No text on the output: the decoder resynchronizes on the frame sync bytes anyway.
+	if (!LogTask.Start()
+		|| !Blink.Attach(500, true)
+		|| !Busy.Attach(2, true)
+		|| !Long.Attach(333, true))
+	{
+		halt();
+	}
+}
+
+void loop()
+{
+	Runner.Loop();
+}
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Decoder for Harmonic Scheduler binary trace frames (BinaryTraceLogTask).
+
+Reads frames from a serial port (requires pyserial) or a capture file and
+prints one table per frame, in the same layout as the text FullTraceLogTask.
+
+Usage:
+    python3 decode_trace.py /dev/ttyUSB0 --baud 115200
+    python3 decode_trace.py capture.bin --file
+
+Frame layout (little-endian), see src/Task/BinaryTraceLogTask.h:
+    sync 0xA5 0x5A | version u8 | sequence u16 | task count u8
+    | iterations u32 | scheduling us u32 | idle sleep us u32
+    | task count x (task id u16 | duration us u32 | max duration us u32 | iterations u32)
+    | crc16 u16 (CCITT-FALSE, over version .. last task record)
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+VERSION = 1
+HEADER = struct.Struct("<BHB")
+GLOBAL = struct.Struct("<III")
+TASK = struct.Struct("<HIII")
+CRC = struct.Struct("<H")
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class FrameDecoder:
+    """Incremental decoder, feed it bytes and collect complete frames."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.last_sequence = None
+        self.dropped = 0
+        self.corrupted = 0
+
+    def feed(self, data):
+        self.buffer.extend(data)
+        frames = []
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                # Keep a possible partial sync byte.
+                del self.buffer[:-1]
+                return frames
+            del self.buffer[:start]
+
+            body_start = len(SYNC)
+            if len(self.buffer) < body_start + HEADER.size:
+                return frames
+            version, sequence, task_count = HEADER.unpack_from(self.buffer, body_start)
+            size = body_start + HEADER.size + GLOBAL.size + task_count * TASK.size + CRC.size
+            if version != VERSION:
+                # Not a frame start, skip this sync.
+                del self.buffer[:1]
+                continue
+            if len(self.buffer) < size:
+                return frames
+
+            body = bytes(self.buffer[body_start:size - CRC.size])
+            (crc,) = CRC.unpack_from(self.buffer, size - CRC.size)
+            if crc16(body) != crc:
+                self.corrupted += 1
+                del self.buffer[:1]
+                continue
+            del self.buffer[:size]
+
+            if self.last_sequence is not None:
+                self.dropped += (sequence - self.last_sequence - 1) & 0xFFFF
+            self.last_sequence = sequence
+            frames.append(decode_body(body))
+
+
+def decode_body(body):
+    _, sequence, task_count = HEADER.unpack_from(body, 0)
+    iterations, scheduling, idle_sleep = GLOBAL.unpack_from(body, HEADER.size)
+    tasks = []
+    for i in range(task_count):
+        offset = HEADER.size + GLOBAL.size + i * TASK.size
+        task_id, duration, max_duration, task_iterations = TASK.unpack_from(body, offset)
+        tasks.append({"id": task_id, "duration": duration, "max": max_duration, "iterations": task_iterations})
+    return {"sequence": sequence, "iterations": iterations, "scheduling": scheduling,
+            "idle_sleep": idle_sleep, "tasks": tasks}
+
+
+def percent(value, total):
+    return (value * 100) // total if total > 0 else 0
+
+
+def print_frame(frame, out=sys.stdout):
+    busy = sum(task["duration"] for task in frame["tasks"])
+    total = frame["scheduling"] + frame["idle_sleep"]
+    idle = frame["scheduling"] - busy
+    out.write("\n#%d\n" % frame["sequence"])
+    out.write("ID\tCPU(%)\tCALLS\tTIME(us)\tMAX(us)\n")
+    out.write("BUSY\t%d\t%d\t%d\t\t%d\n" % (percent(busy, total), frame["iterations"], busy, total))
+    out.write("IDLE\t%d\n" % percent(idle, total))
+    out.write("SLEEP\t%d\t\t%d\n" % (percent(frame["idle_sleep"], total), frame["idle_sleep"]))
+    out.write("-" * 47 + "\n")
+    for task in frame["tasks"]:
+        out.write("Task%d\t%d\t%d\t%d\t\t%d\n" % (task["id"], percent(task["duration"], total),
+                                                  task["iterations"], task["duration"], task["max"]))
+
+
+def read_chunks(args):
+    if args.file:
+        with open(args.source, "rb") as capture:
+            while True:
+                chunk = capture.read(4096)
+                if not chunk:
+                    return
+                yield chunk
+    else:
+        import serial  # pyserial
+        with serial.Serial(args.source, args.baud, timeout=0.1) as port:
+            while True:
+                yield port.read(256)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode Harmonic Scheduler binary trace frames.")
+    parser.add_argument("source", help="serial port, or capture file with --file")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate")
+    parser.add_argument("--file", action="store_true", help="read from a capture file instead of a serial port")
+    args = parser.parse_args()
+
+    decoder = FrameDecoder()
+    try:
+        for chunk in read_chunks(args):
+            for frame in decoder.feed(chunk):
+                print_frame(frame)
+    except KeyboardInterrupt:
+        pass
+    sys.stderr.write("dropped frames: %d, corrupted frames: %d\n" % (decoder.dropped, decoder.corrupted))
+
+
+if __name__ == "__main__":
+    main()
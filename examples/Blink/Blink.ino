@@ -1,7 +1,7 @@
 /*
 * Harmonic Task Blink example.
 * Showcases Blink LED task running on Harmonic scheduler.
-* Example implementations for OOP, static, function, and lambda task variants.
+* Example implementations for OOP, static, function, lambda and template lambda task variants.
 * Enable one of the USE_X_TASK to use a specific variants.
 */
 
@@ -10,6 +10,7 @@
 //#define USE_STATIC_TASK
 //#define USE_FUNCTION_TASK
 //#define USE_LAMBDA_TASK
+//#define USE_TEMPLATE_LAMBDA_TASK
 
 #include <Arduino.h>
 #include <HarmonicScheduler.h>
@@ -67,8 +68,15 @@ Harmonic::CallableTask BlinkTask(Runner,
 		digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));  // Toggle the LED state.
 	}
 );
+#elif defined(USE_TEMPLATE_LAMBDA_TASK)
+// Template lambda task: MakeTask binds the lambda type at compile time, no function pointers stored or checked.
+auto BlinkTask = Harmonic::MakeTask(Runner,
+	[]() {
+		digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));  // Toggle the LED state.
+	}
+);
 #else
-#error No option selected for task. Options: USE_OOP_TASK, USE_STATIC_TASK, USE_FUNCTION_TASK or USE_LAMBDA_TASK.
+#error No option selected for task. Options: USE_OOP_TASK, USE_STATIC_TASK, USE_FUNCTION_TASK, USE_LAMBDA_TASK or USE_TEMPLATE_LAMBDA_TASK.
 #endif
 
 
@@ -83,7 +91,7 @@ void setup()
 #elif defined(USE_FUNCTION_TASK)
 	BlinkTask.Attach(500, true);
 	pinMode(LED_BUILTIN, OUTPUT);
-#elif defined(USE_LAMBDA_TASK)
+#elif defined(USE_LAMBDA_TASK) || defined(USE_TEMPLATE_LAMBDA_TASK)
 	BlinkTask.Attach(500, true);
 	pinMode(LED_BUILTIN, OUTPUT);
 #endif
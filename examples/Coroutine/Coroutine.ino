@@ -0,0 +1,91 @@
+/*
+* Harmonic Scheduler coroutine example.
+* A multi-step sensor init written as straight-line code: power up, wait for the boot time,
+* then wait for a data ready interrupt, without blocking the loop or polling while waiting.
+*/
+
+#include <Arduino.h>
+#include <HarmonicScheduler.h>
+
+// Scheduler configuration.
+static constexpr bool IdleSleep = true;
+static constexpr uint8_t MaxTaskCount = 2; // Init coroutine + blink task.
+static constexpr uint8_t PowerPin = 4;
+static constexpr uint8_t DataReadyPin = 2;
+
+Harmonic::TemplateScheduler<MaxTaskCount, IdleSleep> Runner{};
+
+class SensorInitTask : public Harmonic::CoroutineTask
+{
+public:
+	volatile bool DataReady = false;
+	uint8_t Attempt = 0;
+
+	SensorInitTask(Harmonic::TaskRegistry& registry) : Harmonic::CoroutineTask(registry) {}
+
+protected:
+	void RunCoroutine() final
+	{
+		HARMONIC_COROUTINE_BEGIN();
+		Serial.println(F("Sensor power up"));
+		digitalWrite(PowerPin, HIGH);
+		HARMONIC_SLEEP_FOR(50); // Sensor boot time.
+
+		for (Attempt = 1; Attempt <= 3; Attempt++)
+		{
+			Serial.print(F("Configure, attempt "));
+			Serial.println(Attempt);
+			HARMONIC_YIELD(); // Let other tasks run between bus transactions.
+			HARMONIC_SLEEP_FOR(10);
+		}
+
+		// Disabled until the interrupt notifies, no polling on every pass.
+		HARMONIC_WAIT_UNTIL(DataReady);
+		Serial.println(F("Sensor ready"));
+		HARMONIC_COROUTINE_END();
+	}
+};
+
+SensorInitTask SensorInit(Runner);
+
+void OnDataReadyInterrupt()
+{
+	SensorInit.DataReady = true;
+	SensorInit.Notify();
+}
+
+void BlinkFunction()
+{
+	digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+}
+
+Harmonic::CallableTask Blink(Runner, BlinkFunction);
+
+void halt()
+{
+	while (true)
+	{
+		delay(1000);
+	}
+}
+
+void setup()
+{
+	Serial.begin(115200);
+	pinMode(LED_BUILTIN, OUTPUT);
+	pinMode(PowerPin, OUTPUT);
+	pinMode(DataReadyPin, INPUT_PULLUP);
+
+	if (!SensorInit.Start()
+		|| !Blink.Attach(500, true))
+	{
+		halt();
+	}
+
+	attachInterrupt(digitalPinToInterrupt(DataReadyPin), OnDataReadyInterrupt, FALLING);
+}
+
+void loop()
+{
+	Runner.Loop();
+}
@@ -1,7 +1,7 @@
 /*
 * Harmonic Scheduler profiling example.
 * Demonstrates full profiling with a trace log task.
-* Switch the ProfileLevel to Full, Base or None to see different profiling levels.
+* Switch the ProfileLevel to Latency, Full, Base or None to see different profiling levels.
 * IdleSleep can be enabled or disabled as needed.
 */
 
@@ -65,6 +65,9 @@ void setup()
 	case Harmonic::ProfileLevelEnum::Base:
 		Serial.println(F("Base"));
 		break;
+	case Harmonic::ProfileLevelEnum::Latency:
+		Serial.println(F("Latency"));
+		break;
 	case Harmonic::ProfileLevelEnum::Full:
 	default:
 		Serial.println(F("Full"));
@@ -0,0 +1,91 @@
+/*
+* Harmonic Scheduler Static Benchmark.
+* Same test as Benchmark, with the task in a compile-time StaticScheduler table.
+*
+* This test executes 1,000,000 cycles of a task with a counter.
+* The task's Run() is called directly and inlined into Loop(): no registry, tracker or virtual call.
+* With period 0 no timestamp is read per pass either.
+*
+* Compare the printed duration with Benchmark's ProfilerLevel None rows.
+*
+*/
+
+#include <Arduino.h>
+
+#include <HarmonicScheduler.h>
+
+static constexpr uint32_t BenchmarkSize = 1000000;
+static constexpr uint32_t BenchmarkPeriod = 0;
+
+class BenchmarkTask
+{
+private:
+	enum class StateEnum
+	{
+		Starting,
+		Counting,
+		Ended,
+		Done
+	};
+
+private:
+	uint32_t Start = 0;
+	uint32_t End = 0;
+	uint32_t Count = 0;
+	StateEnum State = StateEnum::Starting;
+
+public:
+	void Run()
+	{
+		switch (State)
+		{
+		case StateEnum::Starting:
+			Start = millis();
+			State = StateEnum::Counting;
+			break;
+		case StateEnum::Counting:
+			Count++;
+			if (Count >= BenchmarkSize)
+			{
+				State = StateEnum::Ended;
+			}
+			break;
+		case StateEnum::Ended:
+			State = StateEnum::Done;
+			OnEnd();
+			break;
+		default:
+			break;
+		}
+	}
+
+private:
+	void OnEnd()
+	{
+		End = millis();
+
+		Serial.println(F("done."));
+		Serial.print(F("Tstart =")); Serial.println(Start);
+		Serial.print(F("Tfinish=")); Serial.println(End);
+		Serial.print(F("Duration=")); Serial.println(End - Start);
+	}
+};
+
+Harmonic::StaticScheduler<Harmonic::StaticTask<BenchmarkTask, BenchmarkPeriod>> Runner{};
+
+void setup()
+{
+	Serial.begin(115200);
+
+	while (!Serial)
+		;;
+
+	delay(1000);
+
+	Serial.print(F("Start..."));
+}
+
+void loop()
+{
+	Runner.Loop();
+}
@@ -6,13 +6,32 @@
  * On some platforms (AVR, STM32, etc...), hardware timer interrupt wake is also tested.
  *
  * Toggle the #define HARMONIC_SKIP_CHECKS to enable/disable safety checks.
+ * Toggle the #define HARMONIC_STABLE_TASK_ID to test stable task IDs with O(1) detach.
+ * Toggle the #define HARMONIC_TASK_BUDGET to test execution time budgets.
+ * Toggle the #define HARMONIC_ENABLED_MASK to test skipping disabled tasks with the enabled bitmap.
+ * Toggle the #define HARMONIC_OVERLOAD to test miss counts and elastic periods.
+ * Toggle the #define HARMONIC_TASK_GROUPS to test bulk group updates.
+ * Toggle the #define HARMONIC_WIDE_TASK_ID to test registries past 255 tasks with 16-bit task IDs.
+ * Toggle the #define HARMONIC_INTERRUPT_TRACE to test interrupt task latency instrumentation.
  * Toggle IdleSleep to test idle sleep behavior.
- * Switch ProfileLevel to test different profiling levels (None, Base, Full).
+ * Switch ProfileLevel to test different profiling levels (None, Base, Full, Latency).
+ * Switch Dispatch to test deadline-ordered dispatch (ProfileLevel None only).
  *
  * All combinations must pass for full verification.
+ *
+ * Also runs on a PC, with the host platform backend:
+ *   g++ -std=c++11 -O2 -I src -I src/Platform/Host -DHARMONIC_HOST_MAIN -x c++ SchedulerBehaviorTests.ino -o tests -lpthread
+ *   ./tests 60
  */
 
  //#define HARMONIC_SKIP_CHECKS
+ //#define HARMONIC_STABLE_TASK_ID
+ //#define HARMONIC_TASK_BUDGET
+ //#define HARMONIC_ENABLED_MASK
+ //#define HARMONIC_OVERLOAD
+ //#define HARMONIC_TASK_GROUPS
+ //#define HARMONIC_WIDE_TASK_ID
+ //#define HARMONIC_INTERRUPT_TRACE
 
 #include <Arduino.h>
 #include <HarmonicScheduler.h>
@@ -20,15 +39,48 @@
 #include "TestTasks.h"
 #include "TestCoordinatorTask.h"
 
-// Configuration: profiling level and idle sleep.
+void InterruptCallback();
+
+// Configuration: profiling level, dispatch policy and idle sleep.
 static constexpr Harmonic::ProfileLevelEnum ProfileLevel = Harmonic::ProfileLevelEnum::None;
+static constexpr Harmonic::DispatchPolicyEnum Dispatch = Harmonic::DispatchPolicyEnum::Linear;
 static constexpr bool IdleSleep = false;
 
-// Number of test tasks in this suite.
-static constexpr auto TestCount = 19;
+// Number of test tasks in this suite, including the ones for optional features.
+#if defined(HARMONIC_TASK_BUDGET)
+static constexpr auto BudgetTestCount = 3;
+#else
+static constexpr auto BudgetTestCount = 0;
+#endif
+#if defined(HARMONIC_ENABLED_MASK)
+static constexpr auto EnabledMaskTestCount = 1;
+#else
+static constexpr auto EnabledMaskTestCount = 0;
+#endif
+#if defined(HARMONIC_OVERLOAD)
+static constexpr auto OverloadTestCount = 2;
+#else
+static constexpr auto OverloadTestCount = 0;
+#endif
+#if defined(HARMONIC_TASK_GROUPS)
+static constexpr auto GroupTestCount = 1;
+#else
+static constexpr auto GroupTestCount = 0;
+#endif
+#if defined(HARMONIC_WIDE_TASK_ID)
+static constexpr auto WideTestCount = 1;
+#else
+static constexpr auto WideTestCount = 0;
+#endif
+#if defined(HARMONIC_INTERRUPT_TRACE)
+static constexpr auto InterruptTraceTestCount = 1;
+#else
+static constexpr auto InterruptTraceTestCount = 0;
+#endif
+static constexpr auto TestCount = 38 + BudgetTestCount + EnabledMaskTestCount + OverloadTestCount + GroupTestCount + WideTestCount + InterruptTraceTestCount;
 
 // Main scheduler instance, manages all tasks (including coordinator).
-Harmonic::TemplateScheduler<TestCount + 1, IdleSleep, ProfileLevel> Runner{};
+Harmonic::TemplateScheduler<TestCount + 1, IdleSleep, ProfileLevel, Dispatch> Runner{};
 
 // Coordinator task: orchestrates execution and reporting of all test tasks.
 Harmonic::TestCoordinatorTask<TestCount> TestCoordinator(Runner);
@@ -53,6 +105,46 @@ Harmonic::TestTasks::TestTaskDetachReattach Test16(Runner);
 Harmonic::TestTasks::TestTaskDoubleDetach Test17(Runner);
 Harmonic::TestTasks::TestTaskDetachThenSetProperties Test18(Runner);
 Harmonic::TestTasks::TestTaskOverrunHandling Test19(Runner);
+Harmonic::TestTasks::TestTaskDetachKeepsOthers Test20(Runner);
+Harmonic::TestTasks::TestTaskAttachOtherRegistry Test21(Runner);
+Harmonic::TestTasks::TestTaskPriorityOrder Test22(Runner);
+Harmonic::TestTasks::TestTaskInterruptBuffer Test23(Runner);
+Harmonic::TestTasks::TestTaskWakeMask Test24(Runner);
+Harmonic::TestTasks::TestTaskMultiCore Test25(Runner);
+Harmonic::TestTasks::TestTaskStaticTable Test26(Runner);
+Harmonic::TestTasks::TestTaskTemplateCallable Test27(Runner);
+Harmonic::TestTasks::TestTaskLatencyHistogram Test28(Runner);
+Harmonic::TestTasks::TestTaskProfileSampling Test29(Runner);
+Harmonic::TestTasks::TestTaskBinaryTrace Test30(Runner);
+Harmonic::TestTasks::TestTaskTimeline Test31(Runner);
+Harmonic::TestTasks::TestTaskPhaseSpread Test32(Runner);
+Harmonic::TestTasks::TestTaskTimerService Test33(Runner);
+Harmonic::TestTasks::TestTaskCoroutine Test34(Runner);
+Harmonic::TestTasks::TestTaskChannel Test35(Runner);
+Harmonic::TestTasks::TestTaskRephaseFromRun Test36(Runner);
+Harmonic::TestTasks::TestTaskAttachFromRun Test37(Runner);
+Harmonic::TestTasks::TestTaskWakeHigher Test38(Runner);
+#if defined(HARMONIC_TASK_BUDGET)
+Harmonic::TestTasks::TestTaskBudgetOverrun TestBudget1(Runner);
+Harmonic::TestTasks::TestTaskPassBudget TestBudget2(Runner);
+Harmonic::TestTasks::TestTaskPassBudgetPriority TestBudget3(Runner);
+#endif
+#if defined(HARMONIC_ENABLED_MASK)
+Harmonic::TestTasks::TestTaskEnabledMask TestEnabledMask1(Runner);
+#endif
+#if defined(HARMONIC_OVERLOAD)
+Harmonic::TestTasks::TestTaskMissCount TestOverload1(Runner);
+Harmonic::TestTasks::TestTaskElasticPeriod TestOverload2(Runner);
+#endif
+#if defined(HARMONIC_TASK_GROUPS)
+Harmonic::TestTasks::TestTaskGroups TestGroup1(Runner);
+#endif
+#if defined(HARMONIC_WIDE_TASK_ID)
+Harmonic::TestTasks::TestTaskWideTaskId TestWide1(Runner);
+#endif
+#if defined(HARMONIC_INTERRUPT_TRACE)
+Harmonic::TestTasks::TestTaskInterruptTrace TestInterruptTrace1(Runner);
+#endif
 
 
 void error()
@@ -90,6 +182,46 @@ void setup()
 		|| !TestCoordinator.AddTestTask(&Test17)
 		|| !TestCoordinator.AddTestTask(&Test18)
 		|| !TestCoordinator.AddTestTask(&Test19)
+		|| !TestCoordinator.AddTestTask(&Test20)
+		|| !TestCoordinator.AddTestTask(&Test21)
+		|| !TestCoordinator.AddTestTask(&Test22)
+		|| !TestCoordinator.AddTestTask(&Test23)
+		|| !TestCoordinator.AddTestTask(&Test24)
+		|| !TestCoordinator.AddTestTask(&Test25)
+		|| !TestCoordinator.AddTestTask(&Test26)
+		|| !TestCoordinator.AddTestTask(&Test27)
+		|| !TestCoordinator.AddTestTask(&Test28)
+		|| !TestCoordinator.AddTestTask(&Test29)
+		|| !TestCoordinator.AddTestTask(&Test30)
+		|| !TestCoordinator.AddTestTask(&Test31)
+		|| !TestCoordinator.AddTestTask(&Test32)
+		|| !TestCoordinator.AddTestTask(&Test33)
+		|| !TestCoordinator.AddTestTask(&Test34)
+		|| !TestCoordinator.AddTestTask(&Test35)
+		|| !TestCoordinator.AddTestTask(&Test36)
+		|| !TestCoordinator.AddTestTask(&Test37)
+		|| !TestCoordinator.AddTestTask(&Test38)
+#if defined(HARMONIC_TASK_BUDGET)
+		|| !TestCoordinator.AddTestTask(&TestBudget1)
+		|| !TestCoordinator.AddTestTask(&TestBudget2)
+		|| !TestCoordinator.AddTestTask(&TestBudget3)
+#endif
+#if defined(HARMONIC_ENABLED_MASK)
+		|| !TestCoordinator.AddTestTask(&TestEnabledMask1)
+#endif
+#if defined(HARMONIC_OVERLOAD)
+		|| !TestCoordinator.AddTestTask(&TestOverload1)
+		|| !TestCoordinator.AddTestTask(&TestOverload2)
+#endif
+#if defined(HARMONIC_TASK_GROUPS)
+		|| !TestCoordinator.AddTestTask(&TestGroup1)
+#endif
+#if defined(HARMONIC_WIDE_TASK_ID)
+		|| !TestCoordinator.AddTestTask(&TestWide1)
+#endif
+#if defined(HARMONIC_INTERRUPT_TRACE)
+		|| !TestCoordinator.AddTestTask(&TestInterruptTrace1)
+#endif
 		)
 	{
 		Serial.print(F("Task Setup failed."));
@@ -113,6 +245,48 @@ void setup()
 	Serial.println(F("\tOptimizations: Disabled"));
 #endif
 
+#if defined(HARMONIC_STABLE_TASK_ID)
+	Serial.println(F("\tTask IDs: Stable"));
+#else
+	Serial.println(F("\tTask IDs: Compact"));
+#endif
+
+#if defined(HARMONIC_TASK_BUDGET)
+	Serial.println(F("\tTask Budgets: Enabled"));
+#else
+	Serial.println(F("\tTask Budgets: Disabled"));
+#endif
+
+#if defined(HARMONIC_ENABLED_MASK)
+	Serial.println(F("\tEnabled Mask: Enabled"));
+#else
+	Serial.println(F("\tEnabled Mask: Disabled"));
+#endif
+
+#if defined(HARMONIC_OVERLOAD)
+	Serial.println(F("\tOverload: Enabled"));
+#else
+	Serial.println(F("\tOverload: Disabled"));
+#endif
+
+#if defined(HARMONIC_TASK_GROUPS)
+	Serial.println(F("\tTask Groups: Enabled"));
+#else
+	Serial.println(F("\tTask Groups: Disabled"));
+#endif
+
+#if defined(HARMONIC_WIDE_TASK_ID)
+	Serial.println(F("\tTask ID Width: 16 bit"));
+#else
+	Serial.println(F("\tTask ID Width: 8 bit"));
+#endif
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+	Serial.println(F("\tInterrupt Trace: Enabled"));
+#else
+	Serial.println(F("\tInterrupt Trace: Disabled"));
+#endif
+
 	if (IdleSleep)
 		Serial.println(F("\tIdle Sleep: Enabled"));
 	else
@@ -126,11 +300,18 @@ void setup()
 	case Harmonic::ProfileLevelEnum::Base:
 		Serial.println(F("\tProfile Level: Base"));
 		break;
+	case Harmonic::ProfileLevelEnum::Latency:
+		Serial.println(F("\tProfile Level: Latency"));
+		break;
 	case Harmonic::ProfileLevelEnum::Full:
 	default:
 		Serial.println(F("\tProfile Level: Full"));
 		break;
 	}
+	if (Dispatch == Harmonic::DispatchPolicyEnum::Deadline)
+		Serial.println(F("\tDispatch: Deadline"));
+	else
+		Serial.println(F("\tDispatch: Linear"));
 	Serial.println();
 
 	delay(1000);
@@ -42,6 +42,19 @@ namespace Harmonic
 			{
 				TestListener = testListener;
 			}
+
+		protected:
+			// Runs the test's own cleanup, detaches the test task and reports the result.
+			void Finish(const bool pass)
+			{
+				OnFinish();
+				Detach();
+				if (TestListener)
+					TestListener->OnTestTaskDone(pass);
+			}
+
+			// Cleanup before the test task is detached: helper tasks, listeners and local schedulers.
+			virtual void OnFinish() {}
 		};
 
 		// Tests that a task attached in the constructor is registered and can be enabled.
@@ -1039,6 +1052,2506 @@ namespace Harmonic
 			}
 		};
 
+		// Tests that detaching a task keeps the remaining tasks addressable by their task ID.
+		// With HARMONIC_STABLE_TASK_ID, the remaining task IDs must not change.
+		class TestTaskDetachKeepsOthers : public AbstractTestTask
+		{
+		private:
+			class HelperTask : public DynamicTask
+			{
+			public:
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final
+				{
+					SetEnabled(false);
+				}
+			};
+
+			static constexpr uint32_t TestPeriod = 123;
+
+			HelperTask Helper;
+
+		public:
+			TestTaskDetachKeepsOthers(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Helper(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskDetachKeepsOthers"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				if (Helper.Attach(0, false) && Attach(TestPeriod, false))
+				{
+					const task_id_t idBefore = GetTaskId();
+					const bool detached = Helper.Detach();
+
+					task_id_t idFound = TASK_INVALID_ID;
+					bool pass = detached
+						&& Registry.GetTaskId(this, idFound)
+						&& idFound == GetTaskId()
+						&& GetPeriod() == TestPeriod;
+#if defined(HARMONIC_STABLE_TASK_ID)
+					pass = pass && GetTaskId() == idBefore;
+#else
+					pass = pass && GetTaskId() == idBefore - 1;
+#endif
+					Detach();
+					if (TestListener)
+						TestListener->OnTestTaskDone(pass);
+				}
+				else
+				{
+					Helper.Detach();
+					Detach();
+					if (TestListener)
+						TestListener->OnTestTaskDone(false);
+				}
+			}
+
+			void Run() final
+			{
+				// Should never run while disabled.
+				if (TestListener)
+					TestListener->OnTestTaskDone(false);
+			}
+		};
+
+		// Tests that a task attached to one registry is rejected by another, and accepted once detached.
+		class TestTaskAttachOtherRegistry : public AbstractTestTask
+		{
+		private:
+			SchedulerNoProfiling<1> Other{};
+
+		public:
+			TestTaskAttachOtherRegistry(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskAttachOtherRegistry"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				if (Attach(10, false))
+				{
+					const bool rejected = !Other.Attach(this)
+						&& !Other.TaskExists(this)
+						&& Registry.TaskExists(this);
+
+					const bool moved = Detach()
+						&& Other.Attach(this, 10, false)
+						&& Other.TaskExists(this)
+						&& !Registry.TaskExists(this);
+
+					const bool released = Other.Detach(this)
+						&& !Other.TaskExists(this)
+						&& GetTaskId() == TASK_INVALID_ID;
+
+					if (TestListener)
+						TestListener->OnTestTaskDone(rejected && moved && released);
+				}
+				else
+				{
+					if (TestListener)
+						TestListener->OnTestTaskDone(false);
+				}
+			}
+
+			void Run() final
+			{
+				// Should never run while disabled.
+				if (TestListener)
+					TestListener->OnTestTaskDone(false);
+			}
+		};
+
+		// Tests that due tasks run in priority order, regardless of attach order,
+		// and that task IDs stay consistent as tasks are moved between priority bands.
+		class TestTaskPriorityOrder : public AbstractTestTask
+		{
+		private:
+			class HelperTask : public DynamicTask
+			{
+			public:
+				uint8_t* Counter = nullptr;
+				uint8_t RunOrder = 0;
+
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final
+				{
+					RunOrder = ++(*Counter);
+					SetEnabled(false);
+				}
+
+				bool IsConsistent(const TaskPriorityEnum priority) const
+				{
+					task_id_t idFound = TASK_INVALID_ID;
+
+					return Registry.GetTaskId(this, idFound)
+						&& idFound == GetTaskId()
+						&& GetPriority() == priority;
+				}
+			};
+
+			static constexpr uint32_t TestPeriod = 20;
+
+			HelperTask LowHelper;
+			HelperTask HighHelper;
+			uint8_t Counter = 0;
+
+		public:
+			TestTaskPriorityOrder(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, LowHelper(registry)
+				, HighHelper(registry)
+			{
+				LowHelper.Counter = &Counter;
+				HighHelper.Counter = &Counter;
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskPriorityOrder"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Counter = 0;
+				LowHelper.RunOrder = 0;
+				HighHelper.RunOrder = 0;
+
+				// Attach in reverse priority order.
+				if (!LowHelper.Attach(0, true, TaskPriorityEnum::Low)
+					|| !HighHelper.Attach(0, true, TaskPriorityEnum::High)
+					|| !Attach(TestPeriod, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				bool pass = HighHelper.RunOrder == 1
+					&& LowHelper.RunOrder == 2
+					&& HighHelper.IsConsistent(TaskPriorityEnum::High)
+					&& LowHelper.IsConsistent(TaskPriorityEnum::Low)
+					&& GetPriority() == TaskPriorityEnum::Normal;
+
+				// Removing the high priority task must keep the others coherent.
+				pass = pass && HighHelper.Detach()
+					&& LowHelper.IsConsistent(TaskPriorityEnum::Low)
+					&& GetPriority() == TaskPriorityEnum::Normal;
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				HighHelper.Detach();
+				LowHelper.Detach();
+			}
+		};
+
+		// Tests that a wake mask wakes every task in it, and only those.
+		class TestTaskWakeMask : public AbstractTestTask
+		{
+		private:
+			class HelperTask : public DynamicTask
+			{
+			public:
+				uint8_t RunCount = 0;
+
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final
+				{
+					RunCount++;
+					SetEnabled(false);
+				}
+			};
+
+			static constexpr uint32_t LongPeriod = 100000;
+			static constexpr uint32_t TestPeriod = 20;
+
+			HelperTask First;
+			HelperTask Second;
+			HelperTask Other;
+
+		public:
+			TestTaskWakeMask(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, First(registry)
+				, Second(registry)
+				, Other(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskWakeMask"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				First.RunCount = 0;
+				Second.RunCount = 0;
+				Other.RunCount = 0;
+				if (First.Attach(LongPeriod, false)
+					&& Second.Attach(LongPeriod, false)
+					&& Other.Attach(LongPeriod, true)
+					&& Attach(TestPeriod, true))
+				{
+					Registry.WakeMaskFromISR((uint32_t(1) << First.GetTaskId()) | (uint32_t(1) << Second.GetTaskId()));
+				}
+				else
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				Finish(First.RunCount == 1
+					&& Second.RunCount == 1
+					&& Other.RunCount == 0);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				First.Detach();
+				Second.Detach();
+				Other.Detach();
+			}
+		};
+
+		// Tests that buffered interrupt events are drained in push order, in one batch,
+		// and that events pushed into a full buffer are counted and reported.
+		class TestTaskInterruptBuffer : public AbstractTestTask, public InterruptBuffer::InterruptListener<uint16_t>
+		{
+		private:
+			static constexpr uint8_t Capacity = 4;
+			static constexpr uint8_t Overflows = 2;
+
+			InterruptBuffer::CallbackTask<uint16_t, Capacity> Buffer;
+			uint8_t Stage = 0;
+			bool Pass = true;
+
+		public:
+			TestTaskInterruptBuffer(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Buffer(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskInterruptBuffer"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Stage = 0;
+				Pass = true;
+				if (Buffer.AttachListener(this) && Attach(0, false))
+				{
+					// Fill the buffer past capacity, as an ISR would.
+					for (uint16_t i = 1; i <= Capacity + Overflows; i++)
+					{
+						Pass = Pass && (Buffer.OnInterrupt(i) == (i <= Capacity));
+					}
+				}
+				else
+				{
+					Finish(false);
+				}
+			}
+
+			void OnBufferInterrupt(const InterruptBuffer::EventBatch<uint16_t>& events, const uint32_t overflowCount) final
+			{
+				if (Stage == 0)
+				{
+					// First batch: the full buffer, and the dropped events.
+					Pass = Pass && events.GetCount() == Capacity && overflowCount == Overflows;
+					for (uint8_t i = 0; i < events.GetCount(); i++)
+					{
+						Pass = Pass && events[i] == i + 1;
+					}
+					Stage = 1;
+					SetEnabled(true);
+				}
+				else
+				{
+					// Second batch: pushed after the drain, across the buffer wrap.
+					Pass = Pass && events.GetCount() == 2 && overflowCount == 0
+						&& events[0] == 100 && events[1] == 101
+						&& Buffer.GetOverflowCount() == Overflows;
+					Stage = 3;
+					SetEnabled(true);
+				}
+			}
+
+			void Run() final
+			{
+				SetEnabled(false);
+				if (Stage == 1)
+				{
+					Stage = 2;
+					Pass = Pass && Buffer.OnInterrupt(100) && Buffer.OnInterrupt(101);
+				}
+				else if (Stage == 3)
+				{
+					Finish(Pass);
+				}
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Buffer.Detach();
+			}
+		};
+
+		// Tests that cross-core requests are queued until the target core's Loop(),
+		// and that tasks migrate between cores, manually and when a core is over its busy threshold.
+		// Runs on a single core: the calling core is core 0, core 1 is driven by Loop(1).
+		class TestTaskMultiCore : public AbstractTestTask
+		{
+		private:
+			class ProbeTask : public ITask
+			{
+			public:
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunCount++;
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					(void)taskId;
+				}
+			};
+
+			static constexpr uint32_t LongPeriod = 100000;
+
+			MultiCoreScheduler<2, false, ProfileLevelEnum::None, DispatchPolicyEnum::Linear, 2> Cores{};
+			ProbeTask Probe{};
+			ProbeTask Other{};
+
+		public:
+			TestTaskMultiCore(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskMultiCore"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Probe.RunCount = 0;
+				if (!Cores.Attach(1, &Probe, LongPeriod, false, TaskPriorityEnum::High)
+					|| !Cores.Attach(0, &Other, LongPeriod, true)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				bool pass = true;
+				task_id_t taskId;
+				pass = pass && Cores.GetCore(1).GetTaskId(&Probe, taskId);
+
+				// Cross-core enable: pending until core 1 runs.
+				pass = pass && Cores.SetEnabled(1, taskId, true);
+				pass = pass && !Cores.GetCore(1).IsEnabled(taskId);
+				Cores.Loop(1);
+				pass = pass && Cores.GetCore(1).IsEnabled(taskId) && Probe.RunCount == 0;
+
+				// Cross-core wake: pending until core 1 runs.
+				pass = pass && Cores.WakeFromISR(1, taskId);
+				pass = pass && Probe.RunCount == 0;
+				Cores.Loop(1);
+				pass = pass && Probe.RunCount == 1;
+
+				// Waking cleared the period, restore it from across cores.
+				pass = pass && Cores.SetPeriod(1, taskId, LongPeriod);
+				pass = pass && Cores.GetCore(1).GetPeriod(taskId) == 0;
+				Cores.Loop(1);
+				pass = pass && Cores.GetCore(1).GetPeriod(taskId) == LongPeriod;
+
+				// Migration from core 1: detached by core 1, attached by core 0.
+				pass = pass && Cores.Migrate(1, &Probe, 0);
+				pass = pass && Cores.GetCore(1).TaskExists(&Probe);
+				Cores.Loop(1);
+				pass = pass && !Cores.GetCore(1).TaskExists(&Probe) && !Cores.GetCore(0).TaskExists(&Probe);
+				Cores.Loop(0);
+				pass = pass && Cores.GetCore(0).GetTaskId(&Probe, taskId)
+					&& Cores.GetCore(0).GetPeriod(taskId) == LongPeriod
+					&& Cores.GetCore(0).IsEnabled(taskId)
+					&& Cores.GetCore(0).GetPriority(taskId) == TaskPriorityEnum::High;
+
+				// Balancing: under the threshold, nothing moves.
+				// Traces follow the TaskList order: the high priority Probe first.
+				Profiling::FullTrace trace{ 1, 1000, 0, 2 };
+				Profiling::TaskTrace taskTraces[2]{ { 200, 200, 1 }, { 200, 200, 1 } };
+				Cores.SetBalanceThreshold(50);
+				pass = pass && !Cores.Balance(0, trace, taskTraces, 2)
+					&& Cores.GetBusyPercent(0) == 40;
+
+				// Over the threshold, the heaviest task moves to the idle core.
+				taskTraces[0].Duration = 500;
+				taskTraces[1].Duration = 400;
+				pass = pass && Cores.Balance(0, trace, taskTraces, 2)
+					&& !Cores.GetCore(0).TaskExists(&Probe)
+					&& Cores.GetCore(0).TaskExists(&Other);
+				Cores.Loop(1);
+				pass = pass && Cores.GetCore(1).TaskExists(&Probe);
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Cores.GetCore(0).Clear();
+				Cores.GetCore(1).Clear();
+			}
+		};
+
+		// Tests that a static task table runs period 0 tasks on every pass,
+		// and periodic tasks at their constant period, driven from this task's runs.
+		class TestTaskStaticTable : public AbstractTestTask
+		{
+		private:
+			struct CountTask
+			{
+				uint16_t RunCount = 0;
+
+				void Run()
+				{
+					RunCount++;
+				}
+			};
+
+			static constexpr uint32_t SlowPeriod = 10;
+			static constexpr uint16_t PassCount = 50;
+
+			StaticScheduler<StaticTask<CountTask>, StaticTask<CountTask, SlowPeriod>> Table{};
+			uint16_t Passes = 0;
+
+		public:
+			TestTaskStaticTable(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskStaticTable"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Passes = 0;
+				Table.GetTask<0>().RunCount = 0;
+				Table.GetTask<1>().RunCount = 0;
+				if (!Attach(1, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				Table.Loop();
+				Passes++;
+				if (Passes >= PassCount)
+				{
+					// ~50 ms at 1 ms per pass: the 10 ms task runs 4 or 5 times, wide bounds for host timing.
+					const uint16_t slowCount = Table.GetTask<1>().RunCount;
+					const bool pass = Table.GetTask<0>().RunCount == PassCount
+						&& slowCount >= 2 && slowCount <= 7
+						&& Table.GetTimeUntilNextRun() == 0
+						&& decltype(Table)::TaskCount == 2;
+					Finish(pass);
+				}
+			}
+		};
+
+		// Tests that a template callable task runs its bound functor, with captured context.
+		class TestTaskTemplateCallable : public AbstractTestTask
+		{
+		private:
+			struct RunCounter
+			{
+				uint8_t* Count;
+
+				void operator()() const
+				{
+					(*Count)++;
+				}
+			};
+
+			uint8_t CallCount = 0;
+			TemplateCallableTask<RunCounter> Callable;
+
+		public:
+			TestTaskTemplateCallable(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Callable(registry, RunCounter{ &CallCount })
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskTemplateCallable"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				CallCount = 0;
+				if (!Callable.Attach(0, true) || !Attach(1, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				if (CallCount > 0)
+				{
+					Finish(Callable.IsEnabled());
+				}
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Callable.Detach();
+			}
+		};
+
+		// Tests log2 histogram bucketing and percentile extraction used by latency profiling.
+		class TestTaskLatencyHistogram : public AbstractTestTask
+		{
+		public:
+			TestTaskLatencyHistogram(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskLatencyHistogram"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				if (!Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				bool pass = Profiling::GetHistogramBucket(0) == 0
+					&& Profiling::GetHistogramBucket(1) == 1
+					&& Profiling::GetHistogramBucket(3) == 2
+					&& Profiling::GetHistogramBucket(4) == 3
+					&& Profiling::GetHistogramBucket(UINT32_MAX) == Profiling::LATENCY_BUCKET_COUNT - 1;
+
+				Profiling::Histogram histogram{};
+				pass = pass && Profiling::GetHistogramPercentile(histogram, 50) == 0;
+
+				// 98 samples of 10 and 2 of 1000: the median sits in [8;15], the tail in [512;1023].
+				for (uint8_t i = 0; i < 98; i++)
+				{
+					Profiling::AddHistogramSample(histogram, 10);
+				}
+				Profiling::AddHistogramSample(histogram, 1000);
+				Profiling::AddHistogramSample(histogram, 1000);
+				pass = pass && Profiling::GetHistogramPercentile(histogram, 50) == 15
+					&& Profiling::GetHistogramPercentile(histogram, 98) == 15
+					&& Profiling::GetHistogramPercentile(histogram, 99) == 1023;
+
+				Finish(pass);
+			}
+		};
+
+		// Tests that a sampled full profiler runs tasks on every pass, but only traces one pass in each interval.
+		class TestTaskProfileSampling : public AbstractTestTask
+		{
+		private:
+			class ProbeTask : public ITask
+			{
+			public:
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunCount++;
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					(void)taskId;
+				}
+			};
+
+			static constexpr uint8_t SampleInterval = 5;
+			static constexpr uint8_t PassCount = 10;
+
+			SchedulerFullProfiling<1> Profiler{};
+			ProbeTask Probe{};
+
+		public:
+			TestTaskProfileSampling(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskProfileSampling"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Probe.RunCount = 0;
+				if (!Profiler.Attach(&Probe, 0, true) || !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				Profiler.SetSampleInterval(SampleInterval);
+				for (uint8_t i = 0; i < PassCount; i++)
+				{
+					Profiler.Loop();
+				}
+
+				Profiling::FullTrace trace{};
+				Profiling::TaskTrace taskTrace{};
+				const bool pass = Probe.RunCount == PassCount
+					&& Profiler.GetTrace(trace, &taskTrace, 1)
+					&& trace.Iterations == PassCount / SampleInterval
+					&& taskTrace.Iterations == PassCount / SampleInterval;
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Profiler.Clear();
+			}
+		};
+
+		// Tests that a binary trace frame is streamed in chunks capped to the output's free space, with a valid layout and CRC.
+		class TestTaskBinaryTrace : public AbstractTestTask
+		{
+		private:
+			struct MockProfiler : public Profiling::IFullProfiler
+			{
+				bool GetTrace(Profiling::FullTrace& trace, Profiling::TaskTrace* tracesBuffer, const task_id_t maxTraces) final
+				{
+					trace = Profiling::FullTrace{ 3, 1000, 500, 1 };
+					if (maxTraces > 0)
+					{
+						tracesBuffer[0] = Profiling::TaskTrace{ 0x12345678, 200, 7 };
+					}
+					return true;
+				}
+			};
+
+			class BufferPrint : public Print
+			{
+			public:
+				static constexpr uint8_t Capacity = 64;
+				static constexpr uint8_t FreeSpace = 5;
+
+				uint8_t Buffer[Capacity]{};
+				uint8_t Count = 0;
+				uint8_t MaxWrite = 0;
+
+				size_t write(uint8_t value) final
+				{
+					return write(&value, 1);
+				}
+
+				size_t write(const uint8_t* buffer, size_t size) final
+				{
+					if (size > MaxWrite)
+						MaxWrite = static_cast<uint8_t>(size);
+					for (size_t i = 0; i < size && Count < Capacity; i++)
+						Buffer[Count++] = buffer[i];
+					return size;
+				}
+
+				int availableForWrite() final
+				{
+					return FreeSpace;
+				}
+			};
+
+			static constexpr uint16_t FrameSize = TraceLogging::GetBinaryTraceFrameSize(1);
+
+			SchedulerNoProfiling<1> Logger{};
+			MockProfiler Profiler{};
+			BufferPrint Output{};
+			BinaryTraceLogTask<1, 1000, 8> LogTask;
+
+		public:
+			TestTaskBinaryTrace(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, LogTask(Logger, Profiler, Output)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskBinaryTrace"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Output.Count = 0;
+				Output.MaxWrite = 0;
+				if (!LogTask.Start() || !Attach(0, true))
+				{
+					Finish(false);
+					return;
+				}
+
+				// Make the first frame due now, instead of after the log period.
+				Logger.SetPeriod(Logger.GetTaskIdAt(0), 0);
+			}
+
+			void Run() final
+			{
+				for (uint8_t i = 0; i < 100 && Output.Count < FrameSize; i++)
+				{
+					Logger.Loop();
+				}
+
+				uint16_t crc = 0xFFFF;
+				for (uint8_t i = 2; i < FrameSize - 2; i++)
+				{
+					crc = TraceLogging::UpdateCrc16(crc, Output.Buffer[i]);
+				}
+
+				const uint8_t* frame = Output.Buffer;
+				const bool pass = Output.Count == FrameSize
+					&& Output.MaxWrite <= BufferPrint::FreeSpace
+					&& frame[0] == 0xA5 && frame[1] == 0x5A
+					&& frame[2] == TraceLogging::BINARY_TRACE_VERSION
+					&& frame[5] == 1
+					&& frame[6] == 3
+					&& frame[20] == 0x78 && frame[23] == 0x12
+					&& frame[FrameSize - 2] == static_cast<uint8_t>(crc)
+					&& frame[FrameSize - 1] == static_cast<uint8_t>(crc >> 8);
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				LogTask.Stop();
+			}
+		};
+
+		// Tests that the timeline keeps the latest runs and exports them as Chrome trace events, relative to the first one.
+		class TestTaskTimeline : public AbstractTestTask
+		{
+		private:
+			class BufferPrint : public Print
+			{
+			public:
+				static constexpr uint16_t Capacity = 512;
+
+				char Buffer[Capacity + 1]{};
+				uint16_t Count = 0;
+
+				size_t write(uint8_t value) final
+				{
+					if (Count < Capacity)
+						Buffer[Count++] = static_cast<char>(value);
+					Buffer[Count] = 0;
+					return 1;
+				}
+			};
+
+			SchedulerNoProfiling<1> Exporter{};
+			TemplateTimelineRecorder<3> Recorder{};
+			BufferPrint Output{};
+			TimelineExportTask<1000> ExportTask;
+
+		public:
+			TestTaskTimeline(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, ExportTask(Exporter, Recorder, Output)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskTimeline"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Output.Count = 0;
+				Output.Buffer[0] = 0;
+				if (!ExportTask.Start() || !Attach(0, true))
+				{
+					Finish(false);
+					return;
+				}
+
+				// Make the export due now, instead of after the log period.
+				Exporter.SetPeriod(Exporter.GetTaskIdAt(0), 0);
+			}
+
+			void Run() final
+			{
+				// 4 runs in a 3 run ring: the first one is dropped.
+				Recorder.OnTaskRun(5, Platform::MicrosToProfilerTicks(100), Platform::MicrosToProfilerTicks(10), 0);
+				Recorder.OnTaskRun(1, Platform::MicrosToProfilerTicks(1000), Platform::MicrosToProfilerTicks(300), 0);
+				Recorder.OnTaskRun(2, Platform::MicrosToProfilerTicks(1500), Platform::MicrosToProfilerTicks(200), 0);
+				Recorder.OnTaskRun(1, Platform::MicrosToProfilerTicks(4000), Platform::MicrosToProfilerTicks(50), Platform::MillisToTicks(2));
+				bool pass = Recorder.GetCount() == 3;
+
+				for (uint8_t i = 0; i < 10; i++)
+				{
+					Exporter.Loop();
+					if (!Recorder.IsFrozen())
+						break;
+
+					// Runs during the export are not recorded.
+					Recorder.OnTaskRun(6, 0, 0, 0);
+				}
+
+				uint8_t eventCount = 0;
+				for (const char* event = strstr(Output.Buffer, "\"ph\":\"X\""); event != nullptr; event = strstr(event + 1, "\"ph\":\"X\""))
+				{
+					eventCount++;
+				}
+
+				pass = pass && eventCount == 3
+					&& Output.Buffer[0] == '['
+					&& strstr(Output.Buffer, "Task 5") == nullptr
+					&& strstr(Output.Buffer, "Task 6") == nullptr
+					&& strstr(Output.Buffer, "{\"name\":\"Task 1\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0,\"dur\":300,\"args\":{\"late\":0}}") != nullptr
+					&& strstr(Output.Buffer, ",{\"name\":\"Task 2\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":500,\"dur\":200,") != nullptr
+					&& strstr(Output.Buffer, "\"ts\":3000,\"dur\":50,\"args\":{\"late\":2000}}") != nullptr
+					&& strchr(Output.Buffer, ']') != nullptr
+					&& !Recorder.IsFrozen();
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				ExportTask.Stop();
+			}
+		};
+
+		// Tests that spread phases stagger harmonic tasks evenly across the shortest period, so an idle loop runs them in separate passes,
+		// and that an explicit attach phase delays the first run by the phase instead of a full period.
+		// Slots are a third of a 30 ms period apart, so the wall clock bounds hold with a loaded host.
+		class TestTaskPhaseSpread : public AbstractTestTask
+		{
+		private:
+			class HelperTask : public DynamicTask
+			{
+			public:
+				uint32_t FirstRun = 0;
+				uint32_t LastPass = 0;
+				uint32_t* Pass = nullptr;
+
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final
+				{
+					if (FirstRun == 0)
+					{
+						FirstRun = micros();
+					}
+					LastPass = *Pass;
+				}
+			};
+
+			static constexpr uint32_t BasePeriod = 30;
+			static constexpr uint32_t Phase = 5;
+			static constexpr uint32_t TestDuration = 3 * 4 * BasePeriod;
+
+			SchedulerNoProfiling<4> Local{};
+			HelperTask Fast;
+			HelperTask Medium;
+			HelperTask Slow;
+			HelperTask Phased;
+			uint32_t Pass = 0;
+
+		public:
+			TestTaskPhaseSpread(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Fast(Local)
+				, Medium(Local)
+				, Slow(Local)
+				, Phased(Local)
+			{
+				Fast.Pass = &Pass;
+				Medium.Pass = &Pass;
+				Slow.Pass = &Pass;
+				Phased.Pass = &Pass;
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskPhaseSpread"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				if (!Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				Fast.FirstRun = 0;
+				Medium.FirstRun = 0;
+				Slow.FirstRun = 0;
+				Phased.FirstRun = 0;
+				Pass = 1;
+
+				// Attached together, all three would be due in the same pass every 4 base periods.
+				const uint32_t start = micros();
+				bool pass = Fast.Attach(Platform::MillisToTicks(BasePeriod), true)
+					&& Medium.Attach(Platform::MillisToTicks(BasePeriod * 2), true)
+					&& Slow.Attach(Platform::MillisToTicks(BasePeriod * 4), true)
+					&& Local.SpreadPhases() == 3
+					&& Phased.Attach(Platform::MillisToTicks(BasePeriod * 8), true, TaskPriorityEnum::Normal, Platform::MillisToTicks(Phase));
+
+				bool collision = false;
+				while (pass && (micros() - start) < (TestDuration * 1000))
+				{
+					Local.Loop();
+					const uint8_t ran = (Fast.LastPass == Pass) + (Medium.LastPass == Pass) + (Slow.LastPass == Pass);
+					collision |= ran > 1;
+					Pass++;
+				}
+
+				// Thirds of the base period apart, the phased task after its phase.
+				const uint32_t third = (BasePeriod * 1000) / 3;
+				pass = pass && !collision
+					&& Fast.FirstRun != 0 && Medium.FirstRun != 0 && Slow.FirstRun != 0 && Phased.FirstRun != 0
+					&& (Medium.FirstRun - Fast.FirstRun) > (third / 2)
+					&& (Slow.FirstRun - Medium.FirstRun) > (third / 2)
+					&& (Slow.FirstRun - start) < (BasePeriod * 1000)
+					&& (Phased.FirstRun - start) >= ((Phase - 1) * 1000)
+					&& (Phased.FirstRun - start) < ((Phase * 1000) + third);
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Fast.Detach();
+				Medium.Detach();
+				Slow.Detach();
+				Phased.Detach();
+			}
+		};
+
+		// Tests that a task re-phasing itself from its own Run() keeps the new phase,
+		// instead of the run advancing its last run timestamp past it.
+		class TestTaskRephaseFromRun : public AbstractTestTask
+		{
+		private:
+			class RephaseTask : public ITask
+			{
+			public:
+				TaskRegistry* Registry = nullptr;
+				task_id_t Id = TASK_INVALID_ID;
+				uint32_t Phase = 0;
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunCount++;
+					Registry->SetPhase(Id, Phase);
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					Id = taskId;
+				}
+			};
+
+			static constexpr uint32_t PeriodMillis = 20;
+
+			SchedulerNoProfiling<1> Local{};
+			RephaseTask Rephased{};
+
+		public:
+			TestTaskRephaseFromRun(TaskRegistry& registry) : AbstractTestTask(registry)
+			{
+				Rephased.Registry = &Local;
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskRephaseFromRun"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Rephased.RunCount = 0;
+				Rephased.Phase = Platform::MillisToTicks(PeriodMillis);
+				if (!Local.Attach(&Rephased, Platform::MillisToTicks(PeriodMillis), true, TaskPriorityEnum::Normal, 0)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				// Due right away with phase 0, then re-phased a full period from its run.
+				const uint32_t start = micros();
+				while (Rephased.RunCount == 0 && (micros() - start) < (PeriodMillis * 1000))
+				{
+					Local.Loop();
+				}
+
+				const uint32_t timeUntilNext = Local.GetTimeUntilNextRun();
+				Local.Loop();
+				bool pass = Rephased.RunCount == 1
+					&& timeUntilNext > (Platform::MillisToTicks(PeriodMillis) / 2)
+					&& timeUntilNext <= Platform::MillisToTicks(PeriodMillis);
+#if defined(HARMONIC_OVERLOAD)
+				pass = pass && Local.GetMissCount(Rephased.Id) == 0;
+#endif
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Local.Clear();
+			}
+		};
+
+		// Tests that a task attaching a higher priority task from its own Run() keeps its schedule and ID,
+		// as its tracker moves below the new band, and that its overrun is reported with its ID.
+		class TestTaskAttachFromRun : public AbstractTestTask
+#if defined(HARMONIC_TASK_BUDGET)
+			, public IBudgetListener
+#endif
+		{
+		private:
+			class SpawnerTask : public ITask
+			{
+			public:
+				TaskRegistry* Registry = nullptr;
+				ITask* Spawned = nullptr;
+				task_id_t Id = TASK_INVALID_ID;
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunCount++;
+					Registry->Attach(Spawned, 0, false, TaskPriorityEnum::High);
+#if defined(HARMONIC_TASK_BUDGET)
+					// Overrun on the profiler clock, which keeps real time with virtual time too.
+					const uint32_t start = Platform::GetProfilerTimestamp();
+					while (Platform::ProfilerTicksToMicros(Platform::GetProfilerTimestamp() - start) < RunMicros)
+					{
+					}
+#endif
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					Id = taskId;
+				}
+			};
+
+			class SpawnedTask : public ITask
+			{
+			public:
+				void Run() final {}
+				void OnTaskIdUpdated(const task_id_t) final {}
+			};
+
+			static constexpr uint32_t PeriodMillis = 20;
+#if defined(HARMONIC_TASK_BUDGET)
+			static constexpr uint32_t BudgetMicros = 200;
+			static constexpr uint32_t RunMicros = 1000;
+
+			task_id_t OverrunId = TASK_INVALID_ID;
+#endif
+
+			SchedulerNoProfiling<2> Local{};
+			SpawnerTask Spawner{};
+			SpawnedTask Spawned{};
+
+		public:
+			TestTaskAttachFromRun(TaskRegistry& registry) : AbstractTestTask(registry)
+			{
+				Spawner.Registry = &Local;
+				Spawner.Spawned = &Spawned;
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskAttachFromRun"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Spawner.RunCount = 0;
+				if (!Local.Attach(&Spawner, Platform::MillisToTicks(PeriodMillis), true, TaskPriorityEnum::Normal, 0)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+#if defined(HARMONIC_TASK_BUDGET)
+				OverrunId = TASK_INVALID_ID;
+				Local.SetBudgetListener(this);
+				Local.SetBudget(Spawner.Id, BudgetMicros);
+#endif
+			}
+
+#if defined(HARMONIC_TASK_BUDGET)
+			void OnBudgetOverrun(const task_id_t taskId, const uint32_t) final
+			{
+				OverrunId = taskId;
+			}
+#endif
+
+			void Run() final
+			{
+				// Due right away with phase 0: its run moves it after the new high priority task.
+				const uint32_t start = micros();
+				while (Spawner.RunCount == 0 && (micros() - start) < (PeriodMillis * 1000))
+				{
+					Local.Loop();
+				}
+
+				task_id_t spawnerId = TASK_INVALID_ID;
+				const uint32_t timeUntilNext = Local.GetTimeUntilNextRun();
+				Local.Loop();
+				bool pass = Spawner.RunCount == 1
+					&& Local.GetTaskCount() == 2
+					&& Local.GetTaskId(&Spawner, spawnerId)
+					&& spawnerId == Spawner.Id
+					&& Local.GetPriority(spawnerId) == TaskPriorityEnum::Normal
+					&& timeUntilNext > (Platform::MillisToTicks(PeriodMillis) / 2)
+					&& timeUntilNext <= Platform::MillisToTicks(PeriodMillis);
+#if defined(HARMONIC_TASK_BUDGET)
+				pass = pass && OverrunId == Spawner.Id;
+#endif
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+#if defined(HARMONIC_TASK_BUDGET)
+				Local.SetBudgetListener(nullptr);
+#endif
+				Local.Clear();
+			}
+		};
+
+		// Tests that a high priority task woken by a lower priority run goes before the rest of the pass,
+		// and that an always due high priority task isn't run again after every lower priority run.
+		class TestTaskWakeHigher : public AbstractTestTask
+		{
+		private:
+			class OrderTask : public ITask
+			{
+			public:
+				TaskRegistry* Registry = nullptr;
+				uint8_t* Counter = nullptr;
+				task_id_t Id = TASK_INVALID_ID;
+				task_id_t WakeId = TASK_INVALID_ID;
+				uint8_t RunOrder = 0;
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunOrder = ++(*Counter);
+					RunCount++;
+					if (WakeId != TASK_INVALID_ID)
+					{
+						Registry->WakeFromISR(WakeId);
+					}
+					else if (Registry->GetPeriod(Id) != 0)
+					{
+						Registry->SetEnabled(Id, false);
+					}
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					Id = taskId;
+				}
+			};
+
+			SchedulerNoProfiling<4> Local{};
+			OrderTask Always{};
+			OrderTask Woken{};
+			OrderTask Waker{};
+			OrderTask Next{};
+			uint8_t Counter = 0;
+
+		public:
+			TestTaskWakeHigher(TaskRegistry& registry) : AbstractTestTask(registry)
+			{
+				OrderTask* tasks[] = { &Always, &Woken, &Waker, &Next };
+				for (OrderTask* task : tasks)
+				{
+					task->Registry = &Local;
+					task->Counter = &Counter;
+				}
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskWakeHigher"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Counter = 0;
+				OrderTask* tasks[] = { &Always, &Woken, &Waker, &Next };
+				for (OrderTask* task : tasks)
+				{
+					task->RunOrder = 0;
+					task->RunCount = 0;
+					task->WakeId = TASK_INVALID_ID;
+				}
+
+				// The woken task has a long period, only its wake makes it due.
+				const uint32_t longPeriod = Platform::MillisToTicks(1000);
+				if (!Local.Attach(&Always, 0, true, TaskPriorityEnum::High)
+					|| !Local.Attach(&Woken, longPeriod, true, TaskPriorityEnum::High)
+					|| !Local.Attach(&Waker, 0, true, TaskPriorityEnum::Normal)
+					|| !Local.Attach(&Next, 0, true, TaskPriorityEnum::Normal)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				// Ids are final once all are attached.
+				Waker.WakeId = Woken.Id;
+				Local.Loop();
+
+				Finish(Always.RunCount == 1 && Always.RunOrder == 1
+					&& Waker.RunOrder == 2
+					&& Woken.RunCount == 1 && Woken.RunOrder == 3
+					&& Next.RunOrder == 4);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Local.Clear();
+			}
+		};
+
+		// Tests that one-shot timers fire once, in due order and never early, from a single service task,
+		// and that cancelled, fired and pool exhausting timers are rejected.
+		class TestTaskTimerService : public AbstractTestTask, public ITimerListener
+		{
+		private:
+			static constexpr uint8_t FiredCapacity = 8;
+			static constexpr uint32_t TestPeriod = 60;
+
+			TemplateTimerServiceTask<4> Service;
+			timer_id_t Fired[FiredCapacity]{};
+			uint32_t FiredTime[FiredCapacity]{};
+			uint8_t FiredCount = 0;
+			uint32_t StartTime = 0;
+			timer_id_t First = TIMER_INVALID_ID;
+			timer_id_t Last = TIMER_INVALID_ID;
+			timer_id_t Restarted = TIMER_INVALID_ID;
+			timer_id_t Equal1 = TIMER_INVALID_ID;
+			timer_id_t Equal2 = TIMER_INVALID_ID;
+
+		public:
+			TestTaskTimerService(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, ITimerListener()
+				, Service(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskTimerService"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				FiredCount = 0;
+				Restarted = TIMER_INVALID_ID;
+
+				timer_id_t cancelled;
+				timer_id_t overflow;
+				StartTime = micros();
+				const bool pass = !Service.StartTimer(this, 1, overflow) // Not started.
+					&& Service.Start()
+					&& Service.StartTimer(this, Platform::MillisToTicks(30), Last)
+					&& Service.StartTimer(this, Platform::MillisToTicks(10), First)
+					&& Service.StartTimer(this, Platform::MillisToTicks(20), cancelled)
+					&& Service.CancelTimer(cancelled)
+					&& !Service.CancelTimer(cancelled)
+					&& !Service.IsTimerPending(cancelled)
+					&& Service.StartTimer(this, Platform::MillisToTicks(15), Equal1)
+					&& Service.StartTimer(this, Platform::MillisToTicks(15), Equal2)
+					&& !Service.StartTimer(this, Platform::MillisToTicks(15), overflow) // Pool exhausted.
+					&& overflow == TIMER_INVALID_ID
+					&& Service.GetPendingCount() == 4
+					&& Attach(Platform::MillisToTicks(TestPeriod), true);
+				if (!pass)
+				{
+					Finish(false);
+				}
+			}
+
+			void OnTimer(const timer_id_t timerId) final
+			{
+				if (FiredCount < FiredCapacity)
+				{
+					Fired[FiredCount] = timerId;
+					FiredTime[FiredCount] = micros() - StartTime;
+					FiredCount++;
+				}
+
+				// Restart from the listener without delay: fires on the next service run.
+				if (timerId == First)
+				{
+					Service.StartTimer(this, 0, Restarted);
+				}
+			}
+
+			void Run() final
+			{
+				bool pass = FiredCount == 5
+					&& Fired[0] == First && Fired[1] == Restarted
+					&& Fired[2] == Equal1 && Fired[3] == Equal2 && Fired[4] == Last
+					&& FiredTime[0] >= 10000 && FiredTime[2] >= 15000 && FiredTime[4] >= 30000
+					&& FiredTime[4] < (TestPeriod * 1000)
+					&& Service.GetPendingCount() == 0
+					&& !Service.IsTimerPending(Last)
+					&& !Service.CancelTimer(Last);
+#if defined(HARMONIC_OVERLOAD)
+				// Rearming from the service's Run() must not leave a stale period behind,
+				// a spurious run right after each fire counts as a miss.
+				task_id_t serviceId;
+				pass = pass && Service.GetAssignedTaskId(serviceId)
+					&& Registry.GetMissCount(serviceId) == 0;
+#endif
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Service.Stop();
+			}
+		};
+
+		// Tests that a coroutine resumes after a yield, sleeps for at least the delay without spurious runs,
+		// and stays disabled while waiting until notified with its condition met.
+		class TestTaskCoroutine : public AbstractTestTask
+		{
+		private:
+			static constexpr uint32_t SleepMillis = 10;
+			static constexpr uint32_t TestPeriod = 40;
+
+			class WorkerTask : public CoroutineTask
+			{
+			public:
+				uint32_t SleepStart = 0;
+				uint32_t Slept = 0;
+				volatile bool Ready = false;
+				uint8_t Step = 0;
+
+				WorkerTask(TaskRegistry& registry) : CoroutineTask(registry) {}
+
+			protected:
+				void RunCoroutine() final
+				{
+					HARMONIC_COROUTINE_BEGIN();
+					Step = 1;
+					HARMONIC_YIELD();
+					Step = 2;
+					SleepStart = micros();
+					HARMONIC_SLEEP_FOR(SleepMillis);
+					HARMONIC_SLEEP_FOR(SleepMillis); // Sleeps again, from a running sleep period.
+					Slept = micros() - SleepStart;
+					Step = 3;
+					HARMONIC_WAIT_UNTIL(Ready);
+					Step = 4;
+					HARMONIC_COROUTINE_END();
+				}
+			};
+
+			WorkerTask Worker;
+			uint8_t RunCount = 0;
+
+		public:
+			TestTaskCoroutine(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Worker(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskCoroutine"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				RunCount = 0;
+				Worker.Ready = false;
+				Worker.Step = 0;
+				if (!Worker.Start()
+					|| !Attach(Platform::MillisToTicks(TestPeriod), true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				RunCount++;
+				if (RunCount == 1)
+				{
+					// Waiting: off the dispatch path until notified.
+					if (Worker.Step != 3 || Worker.IsEnabled() || Worker.IsDone()
+						|| Worker.Slept < (2 * SleepMillis * 1000))
+					{
+						Finish(false);
+						return;
+					}
+#if defined(HARMONIC_OVERLOAD)
+					// Sleeping from inside Run() must not leave a stale period behind, as a spurious catch-up run.
+					if (Registry.GetMissCount(Worker.GetTaskId()) != 0)
+					{
+						Finish(false);
+						return;
+					}
+#endif
+					Worker.Ready = true;
+					Worker.Notify();
+				}
+				else
+				{
+					Finish(Worker.Step == 4 && Worker.IsDone() && !Worker.IsEnabled());
+				}
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Worker.Stop();
+			}
+		};
+
+		// Tests that channel posts wake the disabled consumer once, with the whole batch in order, and that overflow is counted.
+		class TestTaskChannel : public AbstractTestTask
+		{
+		private:
+			static constexpr uint8_t Capacity = 4;
+			static constexpr uint32_t TestPeriod = 10;
+
+			class SinkTask : public Channel::ConsumerTask<uint16_t, Capacity>
+			{
+			public:
+				uint16_t Sum = 0;
+				uint8_t BatchCount = 0;
+				uint8_t MessageCount = 0;
+				uint32_t Dropped = 0;
+				bool Ordered = true;
+
+				SinkTask(TaskRegistry& registry) : Channel::ConsumerTask<uint16_t, Capacity>(registry) {}
+
+			protected:
+				void OnMessages(const Channel::MessageBatch<uint16_t>& messages, const uint32_t droppedCount) final
+				{
+					BatchCount++;
+					Dropped += droppedCount;
+					for (uint8_t i = 0; i < messages.GetCount(); i++)
+					{
+						if (messages[i] != (uint16_t)(MessageCount + 1))
+						{
+							Ordered = false;
+						}
+						MessageCount++;
+						Sum += messages[i];
+					}
+				}
+			};
+
+			SinkTask Sink;
+			uint8_t RunCount = 0;
+
+		public:
+			TestTaskChannel(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Sink(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskChannel"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				RunCount = 0;
+				Sink.Sum = 0;
+				Sink.BatchCount = 0;
+				Sink.MessageCount = 0;
+				Sink.Dropped = 0;
+				Sink.Ordered = true;
+				if (!Sink.Start()
+					|| !Attach(Platform::MillisToTicks(TestPeriod), true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				RunCount++;
+				switch (RunCount)
+				{
+				case 1:
+					// Idle consumer: disabled until the first post.
+					if (Sink.IsEnabled())
+					{
+						Finish(false);
+						return;
+					}
+					Sink.Post(1);
+					Sink.Post(2);
+					Sink.Post(3);
+					break;
+				case 2:
+					// One batch, in post order. Fill up and overflow.
+					if (Sink.BatchCount != 1 || Sink.MessageCount != 3 || !Sink.Ordered
+						|| Sink.IsEnabled() || Sink.GetPendingCount() != 0)
+					{
+						Finish(false);
+						return;
+					}
+					for (uint16_t i = 4; i < 4 + Capacity; i++)
+					{
+						Sink.Post(i);
+					}
+					if (Sink.Post(99) || Sink.GetDroppedCount() != 1)
+					{
+						Finish(false);
+						return;
+					}
+					break;
+				default:
+					Finish(Sink.BatchCount == 2 && Sink.MessageCount == 3 + Capacity
+						&& Sink.Ordered && Sink.Dropped == 1 && !Sink.IsEnabled());
+					break;
+				}
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Sink.Stop();
+			}
+		};
+
+#if defined(HARMONIC_TASK_BUDGET)
+		// Tests that a run exceeding its budget is reported to the budget listener, with the task's ID.
+		class TestTaskBudgetOverrun : public AbstractTestTask, public IBudgetListener
+		{
+		private:
+			static constexpr uint32_t BudgetMicros = 500;
+			static constexpr uint32_t RunMicros = 2000;
+
+			uint8_t RunCount = 0;
+			uint8_t OverrunCount = 0;
+			bool Pass = true;
+
+		public:
+			TestTaskBudgetOverrun(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskBudgetOverrun"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				RunCount = 0;
+				OverrunCount = 0;
+				Pass = true;
+				Registry.SetBudgetListener(this);
+				if (Attach(0, true))
+				{
+					SetBudget(BudgetMicros);
+					Pass = Registry.GetBudget(GetTaskId()) == BudgetMicros;
+				}
+				else
+				{
+					Finish(false);
+				}
+			}
+
+			void OnBudgetOverrun(const task_id_t taskId, const uint32_t duration) final
+			{
+				OverrunCount++;
+				Pass = Pass && taskId == GetTaskId() && duration >= RunMicros;
+			}
+
+			void Run() final
+			{
+				RunCount++;
+				if (RunCount == 1)
+				{
+					// First run: overrun the budget.
+					delayMicroseconds(RunMicros);
+				}
+				else
+				{
+					// Second run: within budget, exactly one overrun reported.
+					Finish(Pass && OverrunCount == 1);
+				}
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Registry.SetBudgetListener(nullptr);
+			}
+		};
+
+		// Tests that the pass budget defers due tasks to the next pass, without starving the ones after it.
+		class TestTaskPassBudget : public AbstractTestTask
+		{
+		private:
+			class HelperTask : public DynamicTask
+			{
+			public:
+				uint16_t RunCount = 0;
+
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final
+				{
+					RunCount++;
+					delayMicroseconds(RunMicros);
+				}
+			};
+
+			static constexpr uint32_t PassBudgetMicros = 100;
+			static constexpr uint32_t RunMicros = 300;
+			static constexpr uint32_t TestPeriod = 50;
+
+			HelperTask First;
+			HelperTask Second;
+
+		public:
+			TestTaskPassBudget(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, First(registry)
+				, Second(registry)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskPassBudget"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				First.RunCount = 0;
+				Second.RunCount = 0;
+
+				// Every pass runs out of budget after one run.
+				Registry.SetPassBudget(PassBudgetMicros);
+				if (!First.Attach(0, true)
+					|| !Second.Attach(0, true)
+					|| !Attach(TestPeriod, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				// Both always-due tasks must get their turn.
+				const uint16_t minimum = (TestPeriod * 1000) / (RunMicros * 4);
+				const int32_t difference = int32_t(First.RunCount) - int32_t(Second.RunCount);
+				const bool pass = First.RunCount >= minimum
+					&& Second.RunCount >= minimum
+					&& difference <= 2 && difference >= -2;
+
+				if (!pass)
+				{
+					Serial.print(F("\tFAIL: Runs "));
+					Serial.print(First.RunCount);
+					Serial.print(F(" / "));
+					Serial.println(Second.RunCount);
+				}
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Registry.SetPassBudget(0);
+				First.Detach();
+				Second.Detach();
+			}
+		};
+
+		// Tests that a pass cut off by its budget resumes inside its own band on the next pass,
+		// after the higher priority tasks, instead of rotating them behind the resumed ones.
+		class TestTaskPassBudgetPriority : public AbstractTestTask
+		{
+		private:
+			class OrderTask : public ITask
+			{
+			public:
+				uint8_t* Counter = nullptr;
+				uint32_t RunMicros = 0;
+				uint8_t RunOrder = 0;
+				uint16_t RunCount = 0;
+
+				void Run() final
+				{
+					RunOrder = ++(*Counter);
+					RunCount++;
+
+					// Busy on the profiler clock, which keeps real time with virtual time too.
+					const uint32_t start = Platform::GetProfilerTimestamp();
+					while (Platform::ProfilerTicksToMicros(Platform::GetProfilerTimestamp() - start) < RunMicros)
+					{
+					}
+				}
+
+				void OnTaskIdUpdated(const task_id_t) final {}
+			};
+
+			static constexpr uint32_t PassBudgetMicros = 500;
+			static constexpr uint32_t RunMicros = 1500;
+			static constexpr uint8_t PassCount = 6;
+
+			SchedulerNoProfiling<3> Local{};
+			OrderTask High{};
+			OrderTask First{};
+			OrderTask Second{};
+			uint8_t Counter = 0;
+
+		public:
+			TestTaskPassBudgetPriority(TaskRegistry& registry) : AbstractTestTask(registry)
+			{
+				High.Counter = &Counter;
+				First.Counter = &Counter;
+				Second.Counter = &Counter;
+				First.RunMicros = RunMicros;
+				Second.RunMicros = RunMicros;
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskPassBudgetPriority"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				High.RunCount = 0;
+				First.RunCount = 0;
+				Second.RunCount = 0;
+
+				// Every pass runs out of budget after one normal priority run.
+				Local.SetPassBudget(PassBudgetMicros);
+				if (!Local.Attach(&First, 0, true)
+					|| !Local.Attach(&Second, 0, true)
+					|| !Local.Attach(&High, 0, true, TaskPriorityEnum::High)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				bool pass = true;
+				for (uint8_t i = 0; i < PassCount && pass; i++)
+				{
+					Counter = 0;
+					High.RunOrder = 0;
+					First.RunOrder = 0;
+					Second.RunOrder = 0;
+					Local.Loop();
+
+					// The high priority task first, then a single normal priority one, taking turns.
+					pass = High.RunOrder == 1
+						&& (First.RunOrder + Second.RunOrder) == 2;
+				}
+
+				Finish(pass
+					&& High.RunCount == PassCount
+					&& First.RunCount == (PassCount / 2)
+					&& Second.RunCount == (PassCount / 2));
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Local.SetPassBudget(0);
+				Local.Clear();
+			}
+		};
+#endif
+
+#if defined(HARMONIC_ENABLED_MASK)
+		// Tests that the enabled mask keeps in step with the tasks past the first mask word:
+		// enabled and woken tasks run, disabled ones are skipped, and the bits follow tasks moved by a detach or a band change.
+		class TestTaskEnabledMask : public AbstractTestTask
+		{
+		private:
+			class ProbeTask : public ITask
+			{
+			public:
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunCount++;
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					(void)taskId;
+				}
+			};
+
+			static constexpr task_id_t ProbeCount = 36;
+			static constexpr task_id_t TargetIndex = TaskMask::WordBits;
+			static constexpr uint32_t LongPeriod = 100000;
+
+			TemplateScheduler<ProbeCount> Local{};
+			ProbeTask Probes[ProbeCount]{};
+
+		public:
+			TestTaskEnabledMask(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskEnabledMask"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				for (task_id_t i = 0; i < ProbeCount; i++)
+				{
+					Probes[i].RunCount = 0;
+					if (!Local.Attach(&Probes[i], LongPeriod, false))
+					{
+						Finish(false);
+						return;
+					}
+				}
+
+				if (!Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				ProbeTask& target = Probes[TargetIndex];
+				task_id_t taskId;
+
+				// All disabled: nothing runs.
+				Local.Loop();
+				bool pass = IsOnlyTargetRun(0)
+					&& Local.GetTaskId(&target, taskId)
+					&& taskId == TargetIndex;
+
+				// Enabled and due: runs. Disabled: skipped. Woken: runs again.
+				Local.SetPeriodAndEnabled(taskId, 0, true);
+				Local.Loop();
+				pass = pass && IsOnlyTargetRun(1);
+				Local.SetEnabled(taskId, false);
+				Local.Loop();
+				pass = pass && IsOnlyTargetRun(1);
+				Local.WakeFromISR(taskId);
+				Local.Loop();
+				pass = pass && IsOnlyTargetRun(2);
+
+				// Detaching a task before it moves the enabled target into the first mask word, it keeps running.
+				pass = pass && Local.Detach(&Probes[0])
+					&& Local.GetTaskId(&target, taskId);
+				Local.Loop();
+				pass = pass && IsOnlyTargetRun(3);
+
+				// Disabled, then moved back past the first word by a higher priority attach: woken, it runs.
+				Local.SetEnabled(taskId, false);
+				pass = pass && Local.Attach(&Probes[0], LongPeriod, false, TaskPriorityEnum::High)
+					&& Local.GetTaskId(&target, taskId);
+				Local.Loop();
+				pass = pass && IsOnlyTargetRun(3);
+				Local.WakeFromISR(taskId);
+				Local.Loop();
+				pass = pass && IsOnlyTargetRun(4);
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Local.Clear();
+			}
+
+			bool IsOnlyTargetRun(const uint8_t targetRunCount) const
+			{
+				for (task_id_t i = 0; i < ProbeCount; i++)
+				{
+					if (Probes[i].RunCount != ((i == TargetIndex) ? targetRunCount : 0))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		};
+#endif
+
+#if defined(HARMONIC_OVERLOAD)
+		// Tests that a run more than one period late counts the dropped periods in the task's miss count.
+		class TestTaskMissCount : public AbstractTestTask
+		{
+		private:
+			static constexpr uint32_t PeriodMillis = 10;
+			static constexpr uint32_t StallMillis = (PeriodMillis * 3) + (PeriodMillis / 2);
+
+			uint8_t RunCount = 0;
+
+		public:
+			TestTaskMissCount(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskMissCount"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				RunCount = 0;
+				if (!Attach(Platform::MillisToTicks(PeriodMillis), true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				RunCount++;
+				if (RunCount == 1)
+				{
+					// First run: stall past 3 periods, the next run drops the missed ones.
+					if (Registry.GetMissCount(GetTaskId()) != 0)
+					{
+						Finish(false);
+						return;
+					}
+					delay(StallMillis);
+				}
+				else if (RunCount > 2)
+				{
+					// The late second run resynced after returning, counting the dropped periods.
+					const uint16_t missCount = Registry.GetMissCount(GetTaskId());
+					Registry.ClearMissCount(GetTaskId());
+					Finish(missCount >= 2 && missCount <= 3
+						&& Registry.GetMissCount(GetTaskId()) == 0);
+				}
+			}
+		};
+
+		// Tests that elastic periods stretch up to their max under overload, hold in between, and are restored to their min.
+		class TestTaskElasticPeriod : public AbstractTestTask
+		{
+		private:
+			struct MockProfiler : public Profiling::IBaseProfiler
+			{
+				uint32_t Busy = 0;
+
+				bool GetTrace(Profiling::BaseTrace& trace) final
+				{
+					trace = Profiling::BaseTrace{ 1, 1000, Busy, 0 };
+					return true;
+				}
+			};
+
+			class HelperTask : public DynamicTask
+			{
+			public:
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final {}
+			};
+
+			static constexpr uint32_t MinPeriod = 100;
+			static constexpr uint32_t MaxPeriod = 160;
+			static constexpr uint32_t FixedPeriod = 50;
+
+			SchedulerNoProfiling<2> Elastic{};
+			MockProfiler Profiler{};
+			HelperTask ElasticTask;
+			HelperTask FixedTask;
+			OverloadTask<1000> Manager;
+
+		public:
+			TestTaskElasticPeriod(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, ElasticTask(Elastic)
+				, FixedTask(Elastic)
+				, Manager(Elastic, Profiler, 90, 70)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskElasticPeriod"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				if (!ElasticTask.Attach(MinPeriod, true)
+					|| !FixedTask.Attach(FixedPeriod, true)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				const task_id_t elasticId = ElasticTask.GetTaskId();
+				bool pass = !Elastic.SetElastic(elasticId, MaxPeriod, MinPeriod)
+					&& Elastic.SetElastic(elasticId, MinPeriod, MaxPeriod);
+
+				// Overloaded: 125, 156, then clamped to the max.
+				Profiler.Busy = 950;
+				Manager.Run();
+				pass = pass && Manager.GetLoad() == 95 && Manager.IsStretched()
+					&& Elastic.GetPeriod(elasticId) == 125;
+				for (uint8_t i = 0; i < 4; i++)
+				{
+					Manager.Run();
+				}
+				pass = pass && Elastic.GetPeriod(elasticId) == MaxPeriod;
+
+				// Between thresholds: held.
+				Profiler.Busy = 800;
+				Manager.Run();
+				pass = pass && Elastic.GetPeriod(elasticId) == MaxPeriod;
+
+				// Load dropped: restored step by step, down to the min.
+				Profiler.Busy = 100;
+				Manager.Run();
+				pass = pass && Elastic.GetPeriod(elasticId) == 130;
+				for (uint8_t i = 0; i < 10 && Manager.IsStretched(); i++)
+				{
+					Manager.Run();
+				}
+
+				pass = pass && !Manager.IsStretched()
+					&& Elastic.GetPeriod(elasticId) == MinPeriod
+					&& Elastic.GetPeriod(FixedTask.GetTaskId()) == FixedPeriod;
+
+				// Period set above the max: clamped back on the next stretch, instead of wrapping the headroom.
+				Elastic.SetPeriod(elasticId, MaxPeriod * 2);
+				Profiler.Busy = 950;
+				Manager.Run();
+
+				Finish(pass && Elastic.GetPeriod(elasticId) == MaxPeriod);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				ElasticTask.Detach();
+				FixedTask.Detach();
+			}
+		};
+#endif
+
+#if defined(HARMONIC_TASK_GROUPS)
+		// Tests that a task group is disabled, re-periodized, enabled and re-phased in one call,
+		// and that only its members are affected, including tasks in several groups.
+		class TestTaskGroups : public AbstractTestTask
+		{
+		private:
+			class HelperTask : public DynamicTask
+			{
+			public:
+				uint8_t RunCount = 0;
+
+				HelperTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+				void Run() final
+				{
+					RunCount++;
+				}
+			};
+
+			static constexpr uint32_t HelperPeriod = 5;
+			static constexpr uint32_t GroupPeriod = 7;
+			static constexpr uint32_t TestPeriod = 30;
+
+			HelperTask First;
+			HelperTask Shared;
+			HelperTask Other;
+			TaskGroup Radio;
+			TaskGroup Sensors;
+			uint8_t Step = 0;
+
+		public:
+			TestTaskGroups(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, First(registry)
+				, Shared(registry)
+				, Other(registry)
+				, Radio(registry, 0)
+				, Sensors(registry, 1)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskGroups"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				Step = 0;
+				if (!First.Attach(Platform::MillisToTicks(HelperPeriod), true)
+					|| !Shared.Attach(Platform::MillisToTicks(HelperPeriod), true)
+					|| !Other.Attach(Platform::MillisToTicks(HelperPeriod), true)
+					|| !Radio.Add(&First)
+					|| !Radio.Add(&Shared)
+					|| !Sensors.Add(&Shared)
+					|| !Sensors.Add(&Other)
+					|| !Attach(Platform::MillisToTicks(TestPeriod), true))
+				{
+					Finish(false);
+					return;
+				}
+
+				// An out of range group has no members.
+				if (TaskGroup(Registry, TASK_GROUP_COUNT).SetEnabled(false) != 0
+					|| Radio.SetEnabled(false) != 2
+					|| First.IsEnabled() || Shared.IsEnabled() || !Other.IsEnabled())
+				{
+					Finish(false);
+					return;
+				}
+				First.RunCount = 0;
+				Shared.RunCount = 0;
+				Other.RunCount = 0;
+			}
+
+			void Run() final
+			{
+				Step++;
+				if (Step == 1)
+				{
+					// Disabled members never ran, the other group kept running.
+					if (First.RunCount != 0 || Shared.RunCount != 0 || Other.RunCount == 0
+						|| Sensors.SetPeriod(Platform::MillisToTicks(GroupPeriod)) != 2
+						|| First.GetPeriod() != Platform::MillisToTicks(HelperPeriod)
+						|| Shared.GetPeriod() != Platform::MillisToTicks(GroupPeriod)
+						|| Other.GetPeriod() != Platform::MillisToTicks(GroupPeriod)
+						|| Radio.SetEnabled(true) != 2
+						|| !First.IsEnabled() || !Shared.IsEnabled()
+						|| Registry.RephaseGroup(Radio.GetMask() | Sensors.GetMask()) != 3)
+					{
+						Finish(false);
+					}
+				}
+				else
+				{
+					const bool pass = First.RunCount > 0 && Shared.RunCount > 0
+						&& Sensors.Remove(Shared.GetTaskId())
+						&& !Sensors.Contains(Shared.GetTaskId())
+						&& Radio.Contains(Shared.GetTaskId());
+					Finish(pass);
+				}
+			}
+
+		private:
+			void OnFinish() final
+			{
+				First.Detach();
+				Shared.Detach();
+				Other.Detach();
+			}
+		};
+#endif
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+		// Tests that an interrupt task measures its wake-to-run latency and counts coalesced interrupts,
+		// and that the full profiler snapshots it with the task traces, for interrupt tasks only, clearing it on read.
+		class TestTaskInterruptTrace : public AbstractTestTask, public InterruptFlag::InterruptListener
+		{
+		private:
+			class ProbeTask : public ITask
+			{
+			public:
+				void Run() final {}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					(void)taskId;
+				}
+			};
+
+			static constexpr uint32_t LongPeriod = 100000;
+
+			TemplateScheduler<2, false, ProfileLevelEnum::Full> Local{};
+			InterruptFlag::CallbackTask Flag;
+			ProbeTask Other{};
+			uint8_t FlagCount = 0;
+
+		public:
+			TestTaskInterruptTrace(TaskRegistry& registry)
+				: AbstractTestTask(registry)
+				, Flag(Local)
+			{
+			}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskInterruptTrace"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				FlagCount = 0;
+				if (!Flag.AttachListener(this)
+					|| !Local.Attach(&Other, LongPeriod, false)
+					|| !Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void OnFlagInterrupt() final
+			{
+				FlagCount++;
+			}
+
+			void Run() final
+			{
+				Profiling::InterruptTrace interruptTrace{};
+				Profiling::FullTrace trace{};
+				Profiling::TaskTrace taskTraces[2]{};
+
+				// Nothing measured yet.
+				bool pass = !Flag.GetInterruptTrace(interruptTrace);
+
+				// Two interrupts before the run, as an ISR would: the second is coalesced.
+				Flag.OnInterrupt();
+				Flag.OnInterrupt();
+				Local.Loop();
+				pass = pass && FlagCount == 1
+					&& Local.GetTrace(trace, taskTraces, 2)
+					&& trace.TaskCount == 2;
+
+				// The flag task is first in the TaskList, the probe has no interrupt trace.
+				pass = pass && !Local.GetInterruptTrace(1, interruptTrace)
+					&& !Local.GetInterruptTrace(2, interruptTrace)
+					&& Local.GetInterruptTrace(0, interruptTrace)
+					&& interruptTrace.Wakes == 1
+					&& interruptTrace.Dropped == 1
+					&& interruptTrace.MinLatency == interruptTrace.MaxLatency
+					&& interruptTrace.TotalLatency == interruptTrace.MaxLatency;
+
+				// Cleared on read.
+				pass = pass && !Local.GetInterruptTrace(0, interruptTrace);
+
+				// Snapshot with the task traces: the row stays with the flag task after the probe takes its position.
+				Flag.OnInterrupt();
+				Local.Loop();
+				pass = pass && Local.GetTrace(trace, taskTraces, 2)
+					&& Flag.Detach()
+					&& Local.GetInterruptTrace(0, interruptTrace)
+					&& interruptTrace.Wakes == 1
+					&& interruptTrace.Dropped == 0;
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Local.Clear();
+			}
+		};
+#endif
+
+#if defined(HARMONIC_WIDE_TASK_ID)
+		// Tests that a registry holds more than 255 tasks with 16-bit task IDs,
+		// and that IDs past the 8-bit range are woken and run.
+		class TestTaskWideTaskId : public AbstractTestTask
+		{
+		private:
+			class ProbeTask : public ITask
+			{
+			public:
+				uint8_t RunCount = 0;
+
+				void Run() final
+				{
+					RunCount++;
+				}
+
+				void OnTaskIdUpdated(const task_id_t taskId) final
+				{
+					(void)taskId;
+				}
+			};
+
+			static constexpr task_id_t ProbeCount = 300;
+			static constexpr uint32_t LongPeriod = 100000;
+
+			TemplateScheduler<ProbeCount> Wide{};
+			ProbeTask Probes[ProbeCount]{};
+
+		public:
+			TestTaskWideTaskId(TaskRegistry& registry) : AbstractTestTask(registry) {}
+
+			void PrintName() final
+			{
+				Serial.print(F("TestTaskWideTaskId"));
+			}
+
+			void StartTest(ITester* testListener) final
+			{
+				AbstractTestTask::StartTest(testListener);
+				for (task_id_t i = 0; i < ProbeCount; i++)
+				{
+					Probes[i].RunCount = 0;
+					if (!Wide.Attach(&Probes[i], LongPeriod, false))
+					{
+						Finish(false);
+						return;
+					}
+				}
+
+				if (!Attach(0, true))
+				{
+					Finish(false);
+				}
+			}
+
+			void Run() final
+			{
+				ProbeTask& last = Probes[ProbeCount - 1];
+				task_id_t taskId;
+				bool pass = TASK_MAX_COUNT > UINT8_MAX
+					&& Wide.GetTaskCount() == ProbeCount
+					&& !Wide.Attach(this, LongPeriod, false)
+					&& Wide.GetTaskId(&last, taskId)
+					&& taskId == ProbeCount - 1;
+
+				// Wake the last task through its mask word, only it runs.
+				if (pass)
+				{
+					Wide.WakeMaskFromISR(uint32_t(1) << (taskId % TaskMask::WordBits), taskId / TaskMask::WordBits);
+					Wide.Loop();
+					for (task_id_t i = 0; i < ProbeCount - 1; i++)
+					{
+						pass = pass && Probes[i].RunCount == 0;
+					}
+					pass = pass && last.RunCount == 1;
+				}
+
+				// Detaching below the 8-bit range keeps the upper tasks attached.
+				pass = pass && Wide.Detach(&Probes[0])
+					&& Wide.TaskExists(&last)
+					&& Wide.GetTaskCount() == ProbeCount - 1;
+
+				Finish(pass);
+			}
+
+		private:
+			void OnFinish() final
+			{
+				Wide.Clear();
+			}
+		};
+#endif
+
 		// Tests scheduler overrun handling: after an overrun, the second run should be ASAP (immediately),
 		// and the third run should be on schedule (period after the second run).
 		class TestTaskOverrunHandling : public AbstractTestTask
@@ -0,0 +1,65 @@
+/*
+* Harmonic Tickless Idle example.
+* Showcases deep idle sleep on AVR: instead of waking on every millis() tick,
+* the scheduler sleeps in power-down until the next task is due, woken by the watchdog.
+* The time slept is credited back to the scheduler clock, so task periods are kept.
+*/
+
+#include <Arduino.h>
+#include <HarmonicScheduler.h>
+
+#if !defined(ARDUINO_ARCH_AVR)
+#error This example requires an AVR board.
+#endif
+
+// Idle sleep must be enabled for tickless sleep.
+Harmonic::TemplateScheduler<1, true> Runner{};
+
+// Watchdog based wakeup source for power-down sleep.
+Harmonic::Platform::AvrWatchdogTicklessTimer TicklessTimer{};
+
+// Forward the watchdog interrupt to the tickless timer.
+ISR(WDT_vect)
+{
+	TicklessTimer.OnInterrupt();
+}
+
+// Short LED flash every 2 seconds, sleeping in between.
+class FlashTask final : public Harmonic::DynamicTask
+{
+private:
+	bool On = false;
+
+public:
+	FlashTask(Harmonic::TaskRegistry& registry)
+		: Harmonic::DynamicTask(registry)
+	{
+	}
+
+	bool Setup()
+	{
+		pinMode(LED_BUILTIN, OUTPUT);
+
+		return Attach(2000, true);
+	}
+
+	void Run() final
+	{
+		On = !On;
+		digitalWrite(LED_BUILTIN, On ? HIGH : LOW);
+
+		// Stay on for 20 ms, off for 2 s.
+		SetPeriod(On ? 20 : 2000);
+	}
+} Flash(Runner);
+
+void setup()
+{
+	Flash.Setup();
+	Runner.SetTicklessTimer(&TicklessTimer);
+}
+
+void loop()
+{
+	Runner.Loop();
+}
@@ -0,0 +1,73 @@
+/*
+* Harmonic Scheduler timeline example.
+* Records every task run in a ring buffer and dumps it as Chrome trace JSON, once per second.
+* Copy one array, from its "[" line to its "]" line, into a .json file
+* and open it in ui.perfetto.dev or chrome://tracing to see which task delayed which.
+*/
+
+// Feed every run to the timeline recorder.
+#define HARMONIC_TIMELINE
+
+#include <Arduino.h>
+#include <HarmonicScheduler.h>
+
+// Scheduler configuration, the timeline requires a profiling scheduler.
+static constexpr bool IdleSleep = true;
+static constexpr uint8_t MaxTaskCount = 3 + 1; // 3 test tasks + 1 export task.
+
+Harmonic::TemplateScheduler<MaxTaskCount, IdleSleep, Harmonic::ProfileLevelEnum::Base> Runner{};
+
+// Timeline of the latest 64 runs.
+Harmonic::TemplateTimelineRecorder<64> Recorder{};
+
+// Timeline export task: one window per second.
+Harmonic::TimelineExportTask<1000> ExportTask(Runner, Recorder, Serial);
+
+// Test tasks.
+void BlinkFunction()
+{
+	digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+}
+
+void BusyFunction()
+{
+	delayMicroseconds(500);
+}
+
+void LongFunction()
+{
+	delay(5);
+}
+
+Harmonic::CallableTask Blink(Runner, BlinkFunction);
+Harmonic::CallableTask Busy(Runner, BusyFunction);
+Harmonic::CallableTask Long(Runner, LongFunction);
+
+void halt()
+{
+	while (true)
+	{
+		delay(1000);
+	}
+}
+
+void setup()
+{
+	Serial.begin(115200);
+	pinMode(LED_BUILTIN, OUTPUT);
+
+	Runner.SetTimelineRecorder(&Recorder);
+
+	if (!ExportTask.Start()
+		|| !Blink.Attach(500, true)
+		|| !Busy.Attach(20, true)
+		|| !Long.Attach(333, true))
+	{
+		halt();
+	}
+}
+
+void loop()
+{
+	Runner.Loop();
+}
@@ -0,0 +1,93 @@
+/*
+* Harmonic Scheduler timer service example.
+* One-shot timers share a single task slot: a button is debounced from its interrupt,
+* and a flaky operation is retried with a growing delay, without any task of their own.
+*/
+
+#include <Arduino.h>
+#include <HarmonicScheduler.h>
+
+// Scheduler configuration.
+static constexpr bool IdleSleep = true;
+static constexpr uint8_t MaxTaskCount = 1; // Timer service only.
+static constexpr uint8_t ButtonPin = 2;
+static constexpr uint32_t DebounceMillis = 30;
+
+Harmonic::TemplateScheduler<MaxTaskCount, IdleSleep> Runner{};
+
+// Up to 8 pending timers, behind the one service task.
+Harmonic::TemplateTimerServiceTask<8> Timers(Runner);
+
+// Debounce: every edge restarts the timer, the button is read once it settled.
+struct ButtonDebouncer : Harmonic::ITimerListener
+{
+	volatile Harmonic::timer_id_t Pending = Harmonic::TIMER_INVALID_ID;
+
+	void OnEdge()
+	{
+		Timers.CancelTimer(Pending);
+		Harmonic::timer_id_t timerId;
+		Timers.StartTimer(this, Harmonic::Platform::MillisToTicks(DebounceMillis), timerId);
+		Pending = timerId;
+	}
+
+	void OnTimer(const Harmonic::timer_id_t /*timerId*/) final
+	{
+		Serial.print(F("Button "));
+		Serial.println(digitalRead(ButtonPin) == LOW ? F("pressed") : F("released"));
+	}
+} Debouncer;
+
+void OnButtonInterrupt()
+{
+	Debouncer.OnEdge();
+}
+
+// Retry with backoff: the pending retry is just a timer entry.
+struct RetryOperation : Harmonic::ITimerListener
+{
+	uint32_t BackoffMillis = 250;
+	uint8_t Attempt = 0;
+
+	void OnTimer(const Harmonic::timer_id_t /*timerId*/) final
+	{
+		Attempt++;
+		const bool success = Attempt >= 3; // Stand-in for a flaky operation.
+		Serial.print(F("Attempt "));
+		Serial.print(Attempt);
+		Serial.println(success ? F(" succeeded") : F(" failed"));
+
+		if (!success)
+		{
+			BackoffMillis *= 2;
+			Timers.StartTimer(this, Harmonic::Platform::MillisToTicks(BackoffMillis));
+		}
+	}
+} Retry;
+
+void halt()
+{
+	while (true)
+	{
+		delay(1000);
+	}
+}
+
+void setup()
+{
+	Serial.begin(115200);
+	pinMode(ButtonPin, INPUT_PULLUP);
+
+	if (!Timers.Start()
+		|| !Timers.StartTimer(&Retry, Harmonic::Platform::MillisToTicks(Retry.BackoffMillis)))
+	{
+		halt();
+	}
+
+	attachInterrupt(digitalPinToInterrupt(ButtonPin), OnButtonInterrupt, CHANGE);
+}
+
+void loop()
+{
+	Runner.Loop();
+}
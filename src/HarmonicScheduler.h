@@ -7,43 +7,74 @@
 #include "Platform/Timestamp.h"
 #include "Platform/IdleSleep.h"
 #include "Platform/Atomic.h"
+#include "Platform/TicklessTimer.h"
+#include "Platform/Core.h"
 
 // Core task model headers
 // - Define the base task interface, registry, and tracking utilities.
 #include "Model/ITask.h"
 #include "Model/TaskRegistry.h"
 #include "Model/TaskTracker.h"
+#include "Model/TaskMask.h"
+#include "Model/TaskPriority.h"
+#include "Model/TaskBudget.h"
+#include "Model/Timeline.h"
+#include "Model/TaskGroup.h"
+#include "Model/InterruptLatency.h"
 
-// Profiling level definitions
-// - Define profiling levels for use in template scheduler/profiler selection.
+// Profiling level and dispatch policy definitions
+// - Define profiling levels and dispatch policies for use in template scheduler/profiler selection.
 #include "Model/Profiling.h"
+#include "Model/DispatchPolicy.h"
 
 // Scheduler implementations
 // - TemplateScheduler provides templated selector for scheduler configurations.
-// - NoProfiling, BaseProfiling, and FullProfiling provide specific scheduler implementations.
+// - NoProfiling, BaseProfiling, FullProfiling and LatencyProfiling provide specific scheduler implementations.
+// - Deadline provides deadline-ordered dispatch, touching only due tasks.
+// - MultiCore runs one scheduler per core, with cross-core requests and task migration.
+// - Static runs a compile-time task table, with direct non-virtual dispatch.
+// - Thread runs a scheduler in its own RTOS thread, for preemptive scheduler tiers.
 #include "Scheduler/NoProfiling.h"
 #include "Scheduler/BaseProfiling.h"
 #include "Scheduler/FullProfiling.h"
+#include "Scheduler/LatencyProfiling.h"
+#include "Scheduler/Deadline.h"
 #include "Scheduler/Template.h"
+#include "Scheduler/MultiCore.h"
+#include "Scheduler/Static.h"
+#include "Scheduler/Thread.h"
 
 // Profile trace logging tasks
-// - Provide templated tasks for logging profiling traces.
+// - Provide templated tasks for logging profiling traces, as text or binary frames.
+// - TimelineExportTask dumps recorded task runs as Chrome trace JSON.
+// - OverloadTask stretches elastic task periods under load, requires HARMONIC_OVERLOAD.
 #include "Task/TraceLogTask.h"
+#include "Task/BinaryTraceLogTask.h"
+#include "Task/TimelineExportTask.h"
+#include "Task/OverloadTask.h"
 
 // Task types and wrappers
 // - DynamicTask: Base class for runtime-configurable tasks.
 // - ExposedDynamicTask: Dynamic task variant exposing additional interfaces.
 // - DynamicTaskWrapper: Utility for wrapping tasks with additional behavior.
 // - CallableTask: Task implementation for callable objects (e.g., functions, lambdas).
+// - TemplateCallableTask: CallableTask bound to the callable type at compile time, created with MakeTask().
+// - TimerServiceTask: Pool of one-shot timers behind a single task.
+// - CoroutineTask: Resumable task base, with yield, sleep and wait macros.
+// - ChannelTask: Fixed-capacity message channel, waking its consumer task on post.
 #include "Task/DynamicTask.h"
 #include "Task/ExposedDynamicTask.h"
 #include "Task/DynamicTaskWrapper.h"
 #include "Task/CallableTask.h"
+#include "Task/TimerServiceTask.h"
+#include "Task/CoroutineTask.h"
+#include "Task/ChannelTask.h"
 
 // Interrupt-driven task types
-// - Provide ready-to-use tasks for flag, signal, and event-based interrupt handling.
+// - Provide ready-to-use tasks for flag, signal, event and buffered event interrupt handling.
 #include "Task/InterruptFlagTask.h"
 #include "Task/InterruptSignalTask.h"
 #include "Task/InterruptEventTask.h"
+#include "Task/InterruptBufferTask.h"
 
 #endif
\ No newline at end of file
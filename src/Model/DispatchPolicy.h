@@ -0,0 +1,19 @@
+#ifndef _HARMONIC_SCHEDULER_DISPATCH_POLICY_h
+#define _HARMONIC_SCHEDULER_DISPATCH_POLICY_h
+
+#include <stdint.h>
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Task dispatch strategy for the scheduler loop.
+	/// - Linear: every registered task is checked on every Loop() pass, O(TaskCount).
+	/// - Deadline: tasks are kept in a min-heap ordered on their due timestamp, only due tasks are touched.
+	/// </summary>
+	enum class DispatchPolicyEnum : uint8_t
+	{
+		Linear = 0,
+		Deadline = 1
+	};
+}
+#endif
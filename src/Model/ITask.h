@@ -5,6 +5,13 @@
 
 namespace Harmonic
 {
+#if defined(HARMONIC_INTERRUPT_TRACE)
+	namespace Profiling
+	{
+		struct InterruptTrace;
+	}
+#endif
+
 	/// <summary>
 	/// Abstract interface for a cooperative task in the Harmonic framework.
 	/// 
@@ -30,6 +37,32 @@ namespace Harmonic
 		/// </summary>
 		/// <param name="taskId">The new task ID value.</param>
 		virtual void OnTaskIdUpdated(const task_id_t taskId) = 0;
+
+		/// <summary>
+		/// Returns the task ID last received in OnTaskIdUpdated, for O(1) membership checks by the registry.
+		/// Tasks that store their ID should override this; otherwise the registry falls back to a scan.
+		/// </summary>
+		/// <param name="taskId">Output: last assigned task ID, TASK_INVALID_ID if not registered.</param>
+		/// <returns>True if the task tracks its own ID.</returns>
+		virtual bool GetAssignedTaskId(task_id_t& taskId) const
+		{
+			(void)taskId;
+			return false;
+		}
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+		/// <summary>
+		/// Retrieves and clears the task's wake-to-run latency statistics, for interrupt tasks.
+		/// Requires #define HARMONIC_INTERRUPT_TRACE.
+		/// </summary>
+		/// <param name="trace">Output interrupt trace.</param>
+		/// <returns>True if the task is an interrupt task, with a wake or a dropped interrupt since the last call.</returns>
+		virtual bool GetInterruptTrace(Profiling::InterruptTrace& trace)
+		{
+			(void)trace;
+			return false;
+		}
+#endif
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef _HARMONIC_INTERRUPT_LATENCY_h
+#define _HARMONIC_INTERRUPT_LATENCY_h
+
+#include "Profiling.h"
+#include "../Platform/Platform.h"
+#include "../Platform/Timestamp.h"
+#include "../Platform/Atomic.h"
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+namespace Harmonic
+{
+	namespace Profiling
+	{
+		/// <summary>
+		/// Measures an interrupt task's wake-to-run latency, and counts its dropped interrupts.
+		/// Requires #define HARMONIC_INTERRUPT_TRACE.
+		///
+		/// - OnWake() stamps the first interrupt of a batch with the profiler timestamp, later ones keep the stamp.
+		/// - OnDispatch() closes the batch in Run(), once the interrupts are taken, adding its latency to the min/max/total.
+		/// - OnDrop() counts an interrupt the task could not keep: coalesced or saturated.
+		/// - GetTrace() returns the statistics since the last call, and clears them.
+		///
+		/// Costs 24 bytes per task, a profiler timestamp read and a critical section per wake and per run.
+		///
+		/// Thread/ISR Safety:
+		///   - OnWake, OnDrop: Safe to call from an ISR.
+		///   - OnDispatch: Call from the task's Run() only.
+		///   - GetTrace: Safe to call at any time, but NOT from an ISR.
+		/// </summary>
+		class InterruptLatencyMeter
+		{
+		private:
+			/// <summary>
+			/// Profiler timestamp of the first interrupt since the last dispatch.
+			/// </summary>
+			volatile uint32_t WakeTimestamp = 0;
+
+			volatile uint32_t Dropped = 0;
+
+			/// <summary>
+			/// Latencies in profiler ticks.
+			/// </summary>
+			uint32_t MinLatency = UINT32_MAX;
+			uint32_t MaxLatency = 0;
+			uint32_t TotalLatency = 0;
+
+			uint32_t Wakes = 0;
+
+			/// <summary>
+			/// Set by OnWake(), cleared by OnDispatch().
+			/// </summary>
+			volatile bool Pending = false;
+
+		public:
+			/// <summary>
+			/// Called from the ISR path, before the task is woken.
+			/// </summary>
+			void OnWake()
+			{
+				Platform::AtomicGuard guard;
+				if (!Pending)
+				{
+					WakeTimestamp = Platform::GetProfilerTimestamp();
+					Pending = true;
+				}
+			}
+
+			/// <summary>
+			/// Called from the ISR path for an interrupt that was coalesced or ignored.
+			/// </summary>
+			void OnDrop()
+			{
+				Platform::AtomicGuard guard;
+				if (Dropped < UINT32_MAX)
+				{
+					Dropped = Dropped + 1;
+				}
+			}
+
+			/// <summary>
+			/// Called from Run(), right after the pending interrupts are taken.
+			/// A wake between both is left unmeasured, rather than stretching the next batch.
+			/// </summary>
+			void OnDispatch()
+			{
+				Platform::AtomicGuard guard;
+				if (Pending)
+				{
+					Pending = false;
+
+					// Stamped under guard, so a wake can't land after it.
+					const uint32_t latency = Platform::GetProfilerTimestamp() - WakeTimestamp;
+					if (latency < MinLatency)
+						MinLatency = latency;
+					if (latency > MaxLatency)
+						MaxLatency = latency;
+					TotalLatency += latency;
+					Wakes++;
+				}
+			}
+
+			/// <summary>
+			/// Retrieves and clears the statistics since the last call, with latencies in microseconds.
+			/// </summary>
+			/// <param name="trace">Output interrupt trace.</param>
+			/// <returns>True if there was a wake or a dropped interrupt since the last call.</returns>
+			bool GetTrace(InterruptTrace& trace)
+			{
+				Platform::AtomicGuard guard;
+				trace.MinLatency = (Wakes > 0) ? Platform::ProfilerTicksToMicros(MinLatency) : 0;
+				trace.MaxLatency = Platform::ProfilerTicksToMicros(MaxLatency);
+				trace.TotalLatency = Platform::ProfilerTicksToMicros(TotalLatency);
+				trace.Wakes = Wakes;
+				trace.Dropped = Dropped;
+
+				MinLatency = UINT32_MAX;
+				MaxLatency = 0;
+				TotalLatency = 0;
+				Wakes = 0;
+				Dropped = 0;
+
+				return trace.Wakes > 0 || trace.Dropped > 0;
+			}
+		};
+	}
+}
+#endif
+#endif
@@ -2,6 +2,7 @@
 #define _HARMONIC_SCHEDULER_PROFILING_h
 
 #include <stdint.h>
+#include "../Platform/Platform.h"
 
 namespace Harmonic
 {
@@ -9,7 +10,8 @@ namespace Harmonic
 	{
 		None = 0,
 		Base = 1,
-		Full = 2
+		Full = 2,
+		Latency = 3
 	};
 
 	namespace Profiling
@@ -34,9 +36,127 @@ namespace Harmonic
 			uint32_t Iterations;
 			uint32_t Scheduling;
 			uint32_t IdleSleep;
-			uint8_t TaskCount;
+			task_id_t TaskCount;
 		};
 
+		/// <summary>
+		/// Wake-to-run latency of an interrupt task, from OnInterrupt() to the listener call in Run().
+		/// Requires #define HARMONIC_INTERRUPT_TRACE.
+		/// </summary>
+		struct InterruptTrace
+		{
+			/// <summary>
+			/// Latencies in microseconds, over the measured wakes. Average is TotalLatency / Wakes.
+			/// </summary>
+			uint32_t MinLatency;
+			uint32_t MaxLatency;
+			uint32_t TotalLatency;
+
+			/// <summary>
+			/// Measured wakes: the first interrupt of each batch.
+			/// </summary>
+			uint32_t Wakes;
+
+			/// <summary>
+			/// Interrupts lost before Run(): coalesced into a pending flag, or past a saturated counter.
+			/// </summary>
+			uint32_t Dropped;
+		};
+
+		/// <summary>
+		/// Number of log2 buckets in a latency histogram.
+		/// Bucket 0 counts samples of 0, bucket b counts samples in [2^(b-1), 2^b - 1], the last bucket everything from 2^(LATENCY_BUCKET_COUNT-2) up.
+		/// </summary>
+		static constexpr uint8_t LATENCY_BUCKET_COUNT = 16;
+
+		/// <summary>
+		/// Log2 histogram of samples. Counts saturate at UINT16_MAX.
+		/// </summary>
+		struct Histogram
+		{
+			uint16_t Buckets[LATENCY_BUCKET_COUNT];
+		};
+
+		struct LatencyTaskTrace
+		{
+			/// <summary>
+			/// Run() execution time in profiler timestamp units (us).
+			/// </summary>
+			Histogram DurationHistogram;
+
+			/// <summary>
+			/// Start lateness vs the scheduled run time, in time base ticks.
+			/// </summary>
+			Histogram JitterHistogram;
+
+			uint32_t Duration;
+			uint32_t MaxDuration;
+			uint32_t MaxJitter;
+			uint32_t Iterations;
+		};
+
+		/// <summary>
+		/// Returns the histogram bucket for a sample.
+		/// </summary>
+		static uint8_t GetHistogramBucket(const uint32_t value)
+		{
+			if (value == 0)
+			{
+				return 0;
+			}
+
+			// 1 + floor(log2(value)).
+			const uint8_t bucket = static_cast<uint8_t>((sizeof(unsigned long) * 8) - __builtin_clzl(static_cast<unsigned long>(value)));
+
+			return (bucket < LATENCY_BUCKET_COUNT) ? bucket : (LATENCY_BUCKET_COUNT - 1);
+		}
+
+		/// <summary>
+		/// Counts a sample in its bucket.
+		/// </summary>
+		static void AddHistogramSample(Histogram& histogram, const uint32_t value)
+		{
+			uint16_t& count = histogram.Buckets[GetHistogramBucket(value)];
+			if (count < UINT16_MAX)
+			{
+				count++;
+			}
+		}
+
+		/// <summary>
+		/// Returns the upper bound of the bucket holding the given percentile, or the lower bound for the last bucket.
+		/// </summary>
+		/// <param name="histogram">Source histogram.</param>
+		/// <param name="percent">Percentile [1;100], e.g. 50 for the median, 99 for the tail.</param>
+		/// <returns>Percentile estimate in sample units, 0 if the histogram is empty.</returns>
+		static uint32_t GetHistogramPercentile(const Histogram& histogram, const uint8_t percent)
+		{
+			uint32_t total = 0;
+			for (uint_fast8_t i = 0; i < LATENCY_BUCKET_COUNT; i++)
+			{
+				total += histogram.Buckets[i];
+			}
+
+			if (total == 0)
+			{
+				return 0;
+			}
+
+			// Rank of the percentile sample, rounded up.
+			const uint32_t rank = ((total * percent) + 99) / 100;
+			uint32_t count = 0;
+			for (uint_fast8_t i = 0; i < LATENCY_BUCKET_COUNT - 1; i++)
+			{
+				count += histogram.Buckets[i];
+				if (count >= rank)
+				{
+					return (i == 0) ? 0 : ((uint32_t(1) << i) - 1);
+				}
+			}
+
+			return uint32_t(1) << (LATENCY_BUCKET_COUNT - 2);
+		}
+
 		struct IBaseProfiler
 		{
 			virtual bool GetTrace(BaseTrace& trace) = 0;
@@ -44,7 +164,27 @@ namespace Harmonic
 
 		struct IFullProfiler
 		{
-			virtual bool GetTrace(FullTrace& trace, TaskTrace* tracesBuffer, const uint8_t maxTraces) = 0;
+			virtual bool GetTrace(FullTrace& trace, TaskTrace* tracesBuffer, const task_id_t maxTraces) = 0;
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			/// <summary>
+			/// Retrieves the interrupt trace of a task, for interrupt tasks only, as snapshot by the last GetTrace().
+			/// </summary>
+			/// <param name="index">Task position, as in the GetTrace() traces buffer.</param>
+			/// <param name="trace">Output interrupt trace.</param>
+			/// <returns>True if the task is an interrupt task, with a wake or a dropped interrupt since the last call.</returns>
+			virtual bool GetInterruptTrace(const task_id_t index, InterruptTrace& trace)
+			{
+				(void)index;
+				(void)trace;
+				return false;
+			}
+#endif
+		};
+
+		struct ILatencyProfiler
+		{
+			virtual bool GetTrace(FullTrace& trace, LatencyTaskTrace* tracesBuffer, const task_id_t maxTraces) = 0;
 		};
 	}
 }
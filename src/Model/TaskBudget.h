@@ -0,0 +1,23 @@
+#ifndef _HARMONIC_TASK_BUDGET_h
+#define _HARMONIC_TASK_BUDGET_h
+
+#include "../Platform/Platform.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Listener for task execution budget overruns.
+	/// Requires #define HARMONIC_TASK_BUDGET.
+	/// Called from the scheduler loop, right after the offending task's run.
+	/// </summary>
+	struct IBudgetListener
+	{
+		/// <summary>
+		/// Called when a task's run took longer than its budget.
+		/// </summary>
+		/// <param name="taskId">ID of the task that overran.</param>
+		/// <param name="duration">Measured run duration in microseconds.</param>
+		virtual void OnBudgetOverrun(const task_id_t taskId, const uint32_t duration) = 0;
+	};
+}
+#endif
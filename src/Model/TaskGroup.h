@@ -0,0 +1,129 @@
+#ifndef _HARMONIC_TASK_GROUP_h
+#define _HARMONIC_TASK_GROUP_h
+
+#include "TaskRegistry.h"
+
+#if defined(HARMONIC_TASK_GROUPS)
+namespace Harmonic
+{
+	/// <summary>
+	/// Number of task groups per registry, one bit each in a tracker's group membership.
+	/// </summary>
+	static constexpr uint8_t TASK_GROUP_COUNT = 8;
+
+	/// <summary>
+	/// Handle for one task group of a registry, for subsystems whose tasks turn on and off together.
+	///
+	/// - Membership is stored in the trackers, the handle only holds the group bit: several handles may share a group.
+	/// - A task can be in several groups, and keeps its membership until detached.
+	/// - Each bulk call updates all members in a single critical section, see TaskRegistry::SetGroupEnabled().
+	///
+	/// Requires #define HARMONIC_TASK_GROUPS.
+	/// </summary>
+	class TaskGroup
+	{
+	private:
+		/// <summary>
+		/// Reference to the registry holding the members.
+		/// </summary>
+		TaskRegistry& Registry;
+
+		/// <summary>
+		/// Group bit, 0 for an out of range group.
+		/// </summary>
+		const uint8_t Mask;
+
+	public:
+		/// <summary>
+		/// Constructs a handle for a group of the registry.
+		/// </summary>
+		/// <param name="registry">Registry holding the members.</param>
+		/// <param name="group">Group index [0;TASK_GROUP_COUNT-1].</param>
+		TaskGroup(TaskRegistry& registry, const uint8_t group)
+			: Registry(registry)
+			, Mask((group < TASK_GROUP_COUNT) ? static_cast<uint8_t>(1 << group) : 0)
+		{
+		}
+
+		/// <summary>
+		/// Returns the group bit, for combining groups in TaskRegistry bulk calls.
+		/// </summary>
+		uint8_t GetMask() const
+		{
+			return Mask;
+		}
+
+		/// <summary>
+		/// Adds an attached task to the group, keeping its other groups.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <returns>True on success, false if the task ID or group is invalid.</returns>
+		bool Add(const task_id_t taskId)
+		{
+			return Mask != 0
+				&& Registry.SetTaskGroups(taskId, Registry.GetTaskGroups(taskId) | Mask);
+		}
+
+		/// <summary>
+		/// Adds an attached task to the group, keeping its other groups.
+		/// </summary>
+		/// <param name="task">Attached task.</param>
+		/// <returns>True on success, false if the task isn't attached or the group is invalid.</returns>
+		bool Add(const ITask* task)
+		{
+			task_id_t taskId;
+
+			return Registry.GetTaskId(task, taskId) && Add(taskId);
+		}
+
+		/// <summary>
+		/// Removes a task from the group, keeping its other groups.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <returns>True on success, false if the task ID is invalid.</returns>
+		bool Remove(const task_id_t taskId)
+		{
+			return Registry.SetTaskGroups(taskId, Registry.GetTaskGroups(taskId) & ~Mask);
+		}
+
+		/// <summary>
+		/// Returns true if the task is in the group.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		bool Contains(const task_id_t taskId) const
+		{
+			return (Registry.GetTaskGroups(taskId) & Mask) != 0;
+		}
+
+		/// <summary>
+		/// Enables or disables all members.
+		/// </summary>
+		/// <param name="enabled">New enabled state.</param>
+		/// <returns>Number of members updated.</returns>
+		task_id_t SetEnabled(const bool enabled)
+		{
+			return Registry.SetGroupEnabled(Mask, enabled);
+		}
+
+		/// <summary>
+		/// Sets the run period of all members.
+		/// </summary>
+		/// <param name="period">New period in time base ticks.</param>
+		/// <returns>Number of members updated.</returns>
+		task_id_t SetPeriod(const uint32_t period)
+		{
+			return Registry.SetGroupPeriod(Mask, period);
+		}
+
+		/// <summary>
+		/// Restarts the period of all members from now, so they run in phase.
+		/// </summary>
+		/// <returns>Number of members updated.</returns>
+		task_id_t Rephase()
+		{
+			return Registry.RephaseGroup(Mask);
+		}
+	};
+}
+#endif
+#endif
@@ -0,0 +1,129 @@
+#ifndef _HARMONIC_TASK_MASK_h
+#define _HARMONIC_TASK_MASK_h
+
+#include "../Platform/Platform.h"
+#include "../Platform/Atomic.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Bitmask helpers over a flat array of 32-bit words, one bit per task ID.
+	///
+	/// Set and Take are safe to call from any context, including from an ISR:
+	/// word updates are guarded, so concurrent producers and the consumer never lose bits.
+	/// </summary>
+	namespace TaskMask
+	{
+		/// <summary>
+		/// Number of task bits per mask word.
+		/// </summary>
+		static constexpr uint8_t WordBits = 32;
+
+		/// <summary>
+		/// Returns the number of mask words required to hold the given number of task bits.
+		/// </summary>
+		/// <param name="capacity">Number of task IDs to represent.</param>
+		/// <returns>Number of 32-bit words.</returns>
+		static constexpr size_t GetWordCount(const size_t capacity)
+		{
+			return (capacity + WordBits - 1) / WordBits;
+		}
+
+		/// <summary>
+		/// Sets the bit for the given task ID, for callers already holding an AtomicGuard.
+		/// </summary>
+		/// <param name="mask">Mask words.</param>
+		/// <param name="taskId">Task ID to set.</param>
+		inline void SetUnderGuard(volatile uint32_t* mask, const task_id_t taskId)
+		{
+			mask[taskId / WordBits] |= uint32_t(1) << (taskId % WordBits);
+		}
+
+		/// <summary>
+		/// Sets the bit for the given task ID.
+		/// </summary>
+		/// <param name="mask">Mask words.</param>
+		/// <param name="taskId">Task ID to set.</param>
+		inline void Set(volatile uint32_t* mask, const task_id_t taskId)
+		{
+			Platform::AtomicGuard guard;
+			SetUnderGuard(mask, taskId);
+		}
+
+		/// <summary>
+		/// Sets the bits for all task IDs in the range [first, first + count).
+		/// </summary>
+		/// <param name="mask">Mask words.</param>
+		/// <param name="first">First task ID to set.</param>
+		/// <param name="count">Number of consecutive task IDs to set.</param>
+		inline void SetRange(volatile uint32_t* mask, const task_id_t first, const task_id_t count)
+		{
+			for (task_id_t i = 0; i < count; i++)
+			{
+				Set(mask, first + i);
+			}
+		}
+
+		/// <summary>
+		/// Atomically reads and clears a single mask word.
+		/// </summary>
+		/// <param name="mask">Mask words.</param>
+		/// <param name="wordIndex">Index of the word to take.</param>
+		/// <returns>The word value before clearing.</returns>
+		inline uint32_t Take(volatile uint32_t* mask, const size_t wordIndex)
+		{
+			Platform::AtomicGuard guard;
+			const uint32_t word = mask[wordIndex];
+			mask[wordIndex] = 0;
+
+			return word;
+		}
+
+		/// <summary>
+		/// Returns the index of the lowest set bit of a non-zero word.
+		/// </summary>
+		/// <param name="word">Non-zero mask word.</param>
+		/// <returns>Bit index [0;31].</returns>
+		inline uint8_t FindFirstSet(const uint32_t word)
+		{
+			return static_cast<uint8_t>(__builtin_ctzl(static_cast<unsigned long>(word)));
+		}
+
+		/// <summary>
+		/// Atomically takes the lowest set bit in the task ID range [from, end).
+		/// </summary>
+		/// <param name="mask">Mask words.</param>
+		/// <param name="from">First task ID to look at.</param>
+		/// <param name="end">End of the task ID range.</param>
+		/// <returns>Task ID of the cleared bit, end if none was set.</returns>
+		inline task_id_t TakeFirst(volatile uint32_t* mask, const task_id_t from, const task_id_t end)
+		{
+			for (size_t w = from / WordBits; (w * WordBits) < end; w++)
+			{
+				const size_t wordStart = w * WordBits;
+
+				Platform::AtomicGuard guard;
+				uint32_t word = mask[w];
+				if (from > wordStart)
+				{
+					word &= ~((uint32_t(1) << (from - wordStart)) - 1);
+				}
+				if ((end - wordStart) < WordBits)
+				{
+					word &= (uint32_t(1) << (end - wordStart)) - 1;
+				}
+
+				if (word != 0)
+				{
+					const uint8_t bit = FindFirstSet(word);
+					mask[w] &= ~(uint32_t(1) << bit);
+
+					return static_cast<task_id_t>(wordStart + bit);
+				}
+			}
+
+			return end;
+		}
+	}
+}
+#endif
@@ -0,0 +1,35 @@
+#ifndef _HARMONIC_TASK_PRIORITY_h
+#define _HARMONIC_TASK_PRIORITY_h
+
+#include <stdint.h>
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Task priority class, set when the task is attached.
+	/// Due tasks of a higher priority class always run before due tasks of a lower one in the same Loop() pass,
+	/// and higher priority tasks are re-checked between lower priority runs.
+	/// </summary>
+	enum class TaskPriorityEnum : uint8_t
+	{
+		Low = 0,
+		Normal = 1,
+		High = 2
+	};
+
+	/// <summary>
+	/// Number of task priority classes.
+	/// </summary>
+	static constexpr uint8_t TASK_PRIORITY_COUNT = 3;
+
+	/// <summary>
+	/// Returns the storage band of a priority class. Band 0 holds the highest priority tasks.
+	/// </summary>
+	/// <param name="priority">Task priority class.</param>
+	/// <returns>Band index [0;TASK_PRIORITY_COUNT-1].</returns>
+	static constexpr uint8_t GetPriorityBand(const TaskPriorityEnum priority)
+	{
+		return static_cast<uint8_t>(TaskPriorityEnum::High) - static_cast<uint8_t>(priority);
+	}
+}
+#endif
@@ -3,9 +3,14 @@
 
 #include "ITask.h"
 #include "TaskTracker.h"
+#include "TaskMask.h"
+#include "TaskPriority.h"
+#include "TaskBudget.h"
+#include "Timeline.h"
 #include "../Platform/Platform.h"
 #include "../Platform/Timestamp.h"
 #include "../Platform/IdleSleep.h"
+#include "../Platform/Atomic.h"
 
 namespace Harmonic
 {
@@ -15,15 +20,50 @@ namespace Harmonic
 	/// Stores pointers to ITask implementations in a externally allocated array of TaskTracker objects.
 	/// Supports adding, removing, clearing, and querying tasks, as well as updating their delay and enabled state.
 	/// Task IDs are assigned and updated dynamically; tasks are notified of their current ID via OnTaskIdUpdated.
+	/// Registered tasks are always kept contiguous at the start of the TaskList, so dispatch is a linear pass.
+	/// The TaskList is ordered in priority bands, highest priority first, so dispatch order follows priority.
+	/// Attaching or detaching a task moves at most one task per lower priority band.
 	///
 	/// Callability:
 	/// - Attach, Detach, Clear: Not safe to call from an ISR.
-	/// - SetPeriod, SetEnabled, SetPeriodAndEnabled, WakeFromISR: Safe to call from any context, including from an ISR.
+	/// - SetPeriod, SetEnabled, SetPeriodAndEnabled, WakeFromISR, WakeMaskFromISR: Safe to call from any context, including from an ISR.
+	/// - SetGroupEnabled, SetGroupPeriod, RephaseGroup: Safe to call from any context, including from an ISR.
 	/// - GetTaskId, TaskExists, IsEnabled, GetPeriod: Safe to call from any context.
 	/// 
 	/// For fast and immediate wake, WakeFromISR is designed to be safely callable from an ISR.
+	/// Hot registries also cache the task with the earliest deadline, updated incrementally on every schedule change.
+	/// Idle checks are then O(1), with a full rescan only when the cached task itself changes or runs.
 	/// #define HARMONIC_SKIP_CHECKS - set flag to skip index validations for maximum performance.
 	/// Should only be enabled if you are sure no invalid task IDs will be used, as it skips checks for task existence and index validity.
+	/// #define HARMONIC_STABLE_TASK_ID - set flag to keep task IDs stable for the lifetime of each registration.
+	/// Task IDs become handles into a slot map, freed IDs are recycled through a free list.
+	/// Detach is then O(1): the last tracker is moved into the gap, and only the removed task is notified.
+	/// Costs one extra task ID per task for the slot map, and one per tracker for its ID.
+	/// #define HARMONIC_TASK_BUDGET - set flag to enable execution time budgets.
+	/// Each task can have a run budget, reported to an IBudgetListener when exceeded.
+	/// A pass budget bounds the time of each Loop() pass: once spent, the remaining due tasks are deferred to the next pass,
+	/// which resumes where the previous one stopped. Costs 4 bytes per tracker, and a timestamp read per run.
+	/// #define HARMONIC_ENABLED_MASK - set flag to keep a bitmap of enabled tasks, alongside the TaskList.
+	/// Linear dispatch and idle rescans then skip disabled tasks 32 at a time, without touching their trackers.
+	/// The bitmap is a superset: bits are set on every enable, and cleared once the tracker is seen disabled.
+	/// Costs 4 bytes per 32 tasks, and a bit update per enable or disable.
+	/// #define HARMONIC_TIMELINE - set flag to report every run to an ITimelineRecorder, set with SetTimelineRecorder().
+	/// Fed by the profiling schedulers (Base, Full, Latency), which already time each run; ignored by the others.
+	/// Costs one pointer, and a virtual call per run while a recorder is set.
+	/// #define HARMONIC_OVERLOAD - set flag to count missed periods per task, and to let elastic tasks stretch their period.
+	/// A run more than a period late drops the missed periods (no catch-up runs), each counted in the task's miss count.
+	/// Elastic tasks have a min/max period range, scaled by ScaleElasticPeriods(), e.g. from an OverloadTask.
+	/// Costs 10 bytes per tracker.
+	/// #define HARMONIC_TASK_GROUPS - set flag to let tasks join up to 8 groups, kept as a membership bitmask per tracker.
+	/// A whole group is enabled, disabled, re-phased or re-periodized with one call, under a single critical section.
+	/// With HARMONIC_ENABLED_MASK, a disabled group's bits are cleared at once, so dispatch skips it without touching its trackers.
+	/// Costs 1 byte per tracker.
+	/// #define HARMONIC_RTOS_NOTIFY - set flag to block idle sleep on the scheduler thread's direct-to-task notification, instead of a semaphore.
+	/// Wakes only make a kernel call while the scheduler is blocked, and set the woken task's ID bit (ID % 32) in the notification value.
+	/// With no task enabled, the scheduler blocks until notified, without timeout polling. FreeRTOS platforms only.
+	/// #define HARMONIC_INTERRUPT_TRACE - set flag to measure the wake-to-run latency of InterruptFlag, InterruptSignal and InterruptEvent tasks.
+	/// Each keeps min/max/average latency and a dropped interrupt count, read through the full profiler and its trace log.
+	/// Costs 24 bytes per interrupt task, and a profiler timestamp read per wake and per run.
 	/// </summary>
 	class TaskRegistry
 	{
@@ -33,11 +73,29 @@ namespace Harmonic
 		/// </summary>
 		Platform::TaskTracker* TaskList;
 
+#if defined(HARMONIC_STABLE_TASK_ID)
+		/// <summary>
+		/// Externally allocated slot map, one entry per task ID.
+		/// Holds the TaskList index of an attached task ID, or the next free task ID of a free one.
+		/// </summary>
+		task_id_t* SlotList;
+
+		/// <summary>
+		/// Head of the free task ID list, TASK_INVALID_ID when empty.
+		/// </summary>
+		task_id_t FreeId = TASK_INVALID_ID;
+
+		/// <summary>
+		/// Number of task IDs handed out so far. Slots from SlotCount onward have never been used.
+		/// </summary>
+		task_id_t SlotCount = 0;
+#endif
+
 	protected:
 		/// <summary>
 		/// Number of currently registered tasks.
 		/// </summary>
-		uint_fast8_t TaskCount = 0;
+		task_id_t TaskCount = 0;
 
 		/// <summary>
 		/// Indicates if the task registry state has changed (used for idle sleep logic).
@@ -49,35 +107,148 @@ namespace Harmonic
 		/// </summary>
 		const bool HotRegistry;
 
+		/// <summary>
+		/// Optional mask of TaskList indices whose schedule changed, set by deadline-ordered schedulers.
+		/// When set, every schedule change (including from an ISR) marks the task's bit for the scheduler to drain.
+		/// </summary>
+		volatile uint32_t* ScheduleChangedMask = nullptr;
+
+		/// <summary>
+		/// TaskList index of the task being run by the scheduler, TASK_INVALID_ID outside of a run.
+		/// Follows the tracker when an Attach() from its Run() moves it, so the post-run bookkeeping stays on the task.
+		/// </summary>
+		task_id_t RunningIndex = TASK_INVALID_ID;
+
+#if defined(HARMONIC_ENABLED_MASK)
+		/// <summary>
+		/// Mask of TaskList indices that may be enabled, allocated by the scheduler.
+		/// Bits of disabled tasks are cleared lazily by GetNextEnabledIndex().
+		/// </summary>
+		volatile uint32_t* EnabledMask = nullptr;
+#endif
+
+	private:
+		/// <summary>
+		/// State of the next deadline cache.
+		/// - Invalid: a full rescan is required.
+		/// - Scanning: a rescan is in progress; any concurrent change invalidates its result.
+		/// - Valid: NextRunId holds the TaskList index with the earliest deadline (TASK_INVALID_ID if none is enabled).
+		/// </summary>
+		enum class NextRunStateEnum : uint8_t
+		{
+			Invalid,
+			Scanning,
+			Valid
+		};
+
+		/// <summary>
+		/// Cached TaskList index of the task with the earliest deadline. Only maintained for hot registries.
+		/// Mutable: the cache is refreshed by the const GetTimeUntilNextRun().
+		/// </summary>
+		mutable volatile task_id_t NextRunId = TASK_INVALID_ID;
+
+		/// <summary>
+		/// Validity of the NextRunId cache.
+		/// </summary>
+		mutable volatile NextRunStateEnum NextRunState = NextRunStateEnum::Invalid;
+
+		/// <summary>
+		/// End index (exclusive) of each priority band in the TaskList, band 0 first.
+		/// </summary>
+		task_id_t BandEnd[TASK_PRIORITY_COUNT]{};
+
+#if defined(HARMONIC_TASK_BUDGET)
+		/// <summary>
+		/// Optional listener for task budget overruns.
+		/// </summary>
+		IBudgetListener* BudgetListener = nullptr;
+
+		/// <summary>
+		/// Time budget per Loop() pass in profiler ticks, 0 for no budget.
+		/// </summary>
+		uint32_t PassBudget = 0;
+
+		/// <summary>
+		/// Profiler timestamp of the current pass start.
+		/// </summary>
+		uint32_t PassStart = 0;
+
+		/// <summary>
+		/// TaskList index the next pass resumes its band from, after a pass ran out of budget.
+		/// </summary>
+		task_id_t ResumeIndex = 0;
+
+		/// <summary>
+		/// Index the current pass resumed from, and the bounds of its band.
+		/// </summary>
+		task_id_t PassResume = 0;
+		task_id_t PassBandStart = 0;
+		task_id_t PassBandEnd = 0;
+#endif
+
+#if defined(HARMONIC_TIMELINE)
+		/// <summary>
+		/// Optional recorder for every task run.
+		/// </summary>
+		ITimelineRecorder* RunRecorder = nullptr;
+#endif
+
 #ifdef HARMONIC_PLATFORM_OS
 	protected:
+#if defined(HARMONIC_RTOS_NOTIFY)
+		/// <summary>
+		/// RTOS thread running the scheduler, notified on wake.
+		/// </summary>
+		TaskHandle_t IdleSleepThread = nullptr;
+
+		/// <summary>
+		/// Set while the scheduler thread is about to block, or blocked: wakes only notify it then.
+		/// </summary>
+		volatile bool IdleSleeping = false;
+
+		/// <summary>
+		/// Notification bits that ended the last idle sleep (bit N for task ID N % 32), 0 on timeout.
+		/// </summary>
+		uint32_t WakeNotifications = 0;
+#else
 		SemaphoreHandle_t IdleSleepSemaphore;
+#endif
 #endif
 
 	public:
 		/// <summary>
 		/// Maximum number of tasks that can be registered.
 		/// </summary>
-		const uint_fast8_t TaskCapacity;
+		const task_id_t TaskCapacity;
 
 	public:
 		/// <summary>
 		/// Constructs the registry with a specified task capacity.
 		/// </summary>
 		/// <param name="taskCapacity">Maximum number of tasks supported.</param>
+#if defined(HARMONIC_STABLE_TASK_ID)
+		/// <param name="slotList">Slot map with taskCapacity entries.</param>
+		TaskRegistry(Platform::TaskTracker* taskList, task_id_t* slotList, const task_id_t taskCapacity, const bool hotRegistry)
+			: TaskList(taskList)
+			, SlotList(slotList)
+			, HotRegistry(hotRegistry)
+			, TaskCapacity(taskCapacity)
+		{
+#else
 		TaskRegistry(Platform::TaskTracker* taskList, const task_id_t taskCapacity, const bool hotRegistry)
 			: TaskList(taskList)
 			, HotRegistry(hotRegistry)
 			, TaskCapacity(taskCapacity)
 		{
-#ifdef HARMONIC_PLATFORM_OS
+#endif
+#if defined(HARMONIC_PLATFORM_OS) && !defined(HARMONIC_RTOS_NOTIFY)
 			IdleSleepSemaphore = xSemaphoreCreateBinary();
 #endif
 		}
 
 		~TaskRegistry()
 		{
-#ifdef HARMONIC_PLATFORM_OS
+#if defined(HARMONIC_PLATFORM_OS) && !defined(HARMONIC_RTOS_NOTIFY)
 			if (IdleSleepSemaphore) vSemaphoreDelete(IdleSleepSemaphore);
 #endif
 		}
@@ -89,36 +260,71 @@ namespace Harmonic
 
 		/// <summary>
 		/// Adds a new task to the registry. Not safe to call from an ISR.
-		/// Assigns it a unique task ID (its index in the array) and notifies the task via OnTaskIdUpdated.
-		/// Returns false if the task is null, already exists, or capacity is exceeded.
+		/// Assigns it a unique task ID (its index in the array, or a free slot with HARMONIC_STABLE_TASK_ID)
+		/// and notifies the task via OnTaskIdUpdated.
+		/// Returns false if the task is null, already attached, or capacity is exceeded.
+		/// Tasks that track their own ID are rejected while attached to any registry.
+		/// The task is placed at the end of its priority band; lower priority tasks may move (and change ID, unless stable).
+		/// Each move is atomic with its ID update, and a running task moved by an Attach() from its own Run() is followed by the scheduler.
 		/// </summary>
 		/// <param name="task">Pointer to ITask implementation.</param>
-		/// <param name="period">Initial delay before first run (ms).</param>
+		/// <param name="period">Initial delay before first run (time base ticks).</param>
 		/// <param name="enabled">Initial enabled state.</param>
+		/// <param name="priority">Priority class of the task.</param>
+		/// <param name="phase">Delay of the first run in time base ticks, clamped to the period.
+		/// Defaults to a full period. Tasks attached together with different phases don't run in the same pass.</param>
 		/// <returns>True on success, false otherwise.</returns>
-		bool Attach(ITask* task, const uint32_t period = 0, const bool enabled = true)
+		bool Attach(ITask* task, const uint32_t period = 0, const bool enabled = true, const TaskPriorityEnum priority = TaskPriorityEnum::Normal, const uint32_t phase = UINT32_MAX)
 		{
 			if (task == nullptr
 				|| TaskCount >= TaskCapacity
-				|| TaskExists(task))
+				|| priority > TaskPriorityEnum::High
+				|| IsAttached(task))
 			{
 				return false;
 			}
 
-			// The task ID is the next available index in the TaskList.
-			const task_id_t taskId = TaskCount;
+			// The task is bound at the end of its priority band in the TaskList.
+			const uint8_t band = GetPriorityBand(priority);
+			const task_id_t index = OpenBandGap(band);
+
+#if defined(HARMONIC_STABLE_TASK_ID)
+			// The task ID is recycled from the free list, or a never used slot.
+			task_id_t taskId;
+			if (FreeId != TASK_INVALID_ID)
+			{
+				taskId = FreeId;
+				FreeId = SlotList[taskId];
+			}
+			else
+			{
+				taskId = SlotCount++;
+			}
+
+			// Map the task ID to the index.
+			SlotList[taskId] = index;
+			TaskList[index].Id = taskId;
+#else
+			// The task ID is the index.
+			const task_id_t taskId = index;
+#endif
 
-			// Bind Task at the position on the list (task ID).
-			TaskList[taskId].BindTask(task, period, enabled);
+			// Bind Task at the position on the list.
+			TaskList[index].BindTask(task, period, enabled, phase);
+			TaskList[index].PriorityBand = band;
+			if (enabled)
+			{
+				MarkEnabled(index);
+			}
 
 			// Notify the task of its assigned ID.
-			TaskList[taskId].NotifyTaskIdUpdate(taskId);
+			TaskList[index].NotifyTaskIdUpdate(taskId);
 
-			if (HotRegistry)
-				Hot = true; // Flag hot state when collection changed.
+			// Flag hot state when collection changed.
+			OnTaskScheduleChanged(index);
 
 			TaskCount++;
-			WakeFromInterrupt();
+			WakeFromInterrupt(GetNotifyBit(taskId));
 
 			return true;
 		}
@@ -126,28 +332,64 @@ namespace Harmonic
 		/// <summary>
 		/// Removes a task from the registry by its task ID. Not safe to call from an ISR.
 		/// Shifts remaining tasks to fill the gap and updates their IDs via OnTaskIdUpdated.
+		/// With HARMONIC_STABLE_TASK_ID, moves the last task of each band from the task's band onward instead,
+		/// and no other task ID changes.
 		/// The removed task is notified with TASK_INVALID_ID.
 		/// </summary>
 		/// <param name="taskId">Task ID to remove.</param>
 		/// <returns>True if removed, false otherwise.</returns>
 		bool Detach(const task_id_t taskId)
 		{
-			if (taskId >= TaskCount)
+			const task_id_t index = GetTaskIndex(taskId);
+			if (index == TASK_INVALID_ID)
 				return false;
 
+			const uint8_t band = TaskList[index].PriorityBand;
+
 			// Notify the removed task.
-			TaskList[taskId].NotifyTaskIdUpdate(TASK_INVALID_ID);
+			TaskList[index].NotifyTaskIdUpdate(TASK_INVALID_ID);
+
+#if defined(HARMONIC_STABLE_TASK_ID)
+			// Fill the gap, leaving the last index unused.
+			const task_id_t last = CloseBandGap(index, band);
+			MarkScheduleChanged(last, 1);
+
+			{
+				Platform::AtomicGuard guard;
+
+				// Return the task ID to the free list.
+				SlotList[taskId] = FreeId;
+				FreeId = taskId;
+				TaskCount--;
+			}
+#else
+			// All tasks from the removed one onward change ID.
+			MarkScheduleChanged(index, TaskCount - index);
+#if defined(HARMONIC_ENABLED_MASK)
+			if (EnabledMask != nullptr)
+			{
+				TaskMask::SetRange(EnabledMask, index, TaskCount - index);
+			}
+#endif
 
-			// Shift all tasks after the removed one to fill the gap.
-			for (task_id_t i = taskId; i < TaskCount - 1; i++)
+			// Shift all tasks after the removed one to fill the gap, preserving priority order.
+			for (task_id_t i = index; i < TaskCount - 1; i++)
 			{
 				TaskList[i] = TaskList[i + 1];
 				TaskList[i].NotifyTaskIdUpdate(i); // Update task ID in the moved task.
 			}
+			for (uint8_t b = band; b < TASK_PRIORITY_COUNT; b++)
+			{
+				BandEnd[b]--;
+			}
 			TaskCount--;
+#endif
 
 			if (HotRegistry)
+			{
 				Hot = true; // Flag hot state when collection changed.
+				NextRunState = NextRunStateEnum::Invalid; // Task indices have moved.
+			}
 
 			return true;
 		}
@@ -175,19 +417,44 @@ namespace Harmonic
 		/// </summary>
 		void Clear()
 		{
+			MarkScheduleChanged(0, TaskCount);
+
 			for (task_id_t i = 0; i < TaskCount; i++)
 			{
 				TaskList[i].NotifyTaskIdUpdate(TASK_INVALID_ID); // Update task ID in the removed task.
 			}
 
 			if (HotRegistry)
+			{
 				Hot = true; // Flag hot state when collection changed.
+				NextRunState = NextRunStateEnum::Invalid;
+			}
 
 			TaskCount = 0;
+			for (uint8_t b = 0; b < TASK_PRIORITY_COUNT; b++)
+			{
+				BandEnd[b] = 0;
+			}
+#if defined(HARMONIC_ENABLED_MASK)
+			if (EnabledMask != nullptr)
+			{
+				for (size_t w = 0; w < TaskMask::GetWordCount(TaskCapacity); w++)
+				{
+					TaskMask::Take(EnabledMask, w);
+				}
+			}
+#endif
+
+#if defined(HARMONIC_STABLE_TASK_ID)
+			// Release all slots.
+			FreeId = TASK_INVALID_ID;
+			SlotCount = 0;
+#endif
 		}
 
 		/// <summary>
 		/// Retrieves the task ID for a given task pointer, if it exists.
+		/// O(1) for tasks that track their own ID (GetAssignedTaskId), a scan otherwise.
 		/// Safe to call from any context, including from an ISR.
 		/// </summary>
 		/// <param name="task">Pointer to ITask implementation.</param>
@@ -196,11 +463,31 @@ namespace Harmonic
 		bool GetTaskId(const ITask* task, task_id_t& taskId) const
 		{
 			taskId = TASK_INVALID_ID;
+			if (task == nullptr)
+			{
+				return false;
+			}
+
+			task_id_t assignedId;
+			if (task->GetAssignedTaskId(assignedId))
+			{
+				// Intrusive membership: only confirm this registry owns the assigned ID.
+				const task_id_t index = GetTaskIndex(assignedId);
+				if (index != TASK_INVALID_ID
+					&& TaskList[index].Task == task)
+				{
+					taskId = assignedId;
+					return true;
+				}
+
+				return false; // Unregistered, or owned by another registry.
+			}
+
 			for (task_id_t i = 0; i < TaskCount; i++)
 			{
 				if (TaskList[i].Task == task)
 				{
-					taskId = i;
+					taskId = GetTaskIdAt(i);
 					return true;
 				}
 			}
@@ -210,21 +497,16 @@ namespace Harmonic
 
 		/// <summary>
 		/// Checks if a given task pointer is already registered.
+		/// O(1) for tasks that track their own ID (GetAssignedTaskId), a scan otherwise.
 		/// Safe to call from any context, including from an ISR.
 		/// </summary>
 		/// <param name="task">Pointer to ITask implementation.</param>
 		/// <returns>True if the task exists, false otherwise.</returns>
 		bool TaskExists(const ITask* task) const
 		{
-			for (task_id_t i = 0; i < TaskCount; i++)
-			{
-				if (TaskList[i].Task == task)
-				{
-					return true;
-				}
-			}
+			task_id_t taskId;
 
-			return false;
+			return GetTaskId(task, taskId);
 		}
 
 		/// <summary>
@@ -235,152 +517,1331 @@ namespace Harmonic
 		/// <returns>True if the task is enabled, false otherwise.</returns>
 		bool IsEnabled(const task_id_t taskId) const
 		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
-			if (taskId >= TaskCount)
+			if (index == TASK_INVALID_ID)
 				return false;
 #endif
 
-			return TaskList[taskId].IsEnabled();
+			return TaskList[index].IsEnabled();
 		}
 
 		/// <summary>
-		/// Returns the current delay period (in milliseconds) for the specified task.
+		/// Returns the priority class of the specified task.
 		/// Safe to call from any context, including from an ISR.
 		/// </summary>
 		/// <param name="taskId">Valid task ID.</param>
-		/// <returns>The delay period in milliseconds.</returns>
-		uint32_t GetPeriod(const task_id_t taskId) const
+		/// <returns>The task's priority class.</returns>
+		TaskPriorityEnum GetPriority(const task_id_t taskId) const
 		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
-			if (taskId >= TaskCount)
-				return UINT32_MAX;
+			if (index == TASK_INVALID_ID)
+				return TaskPriorityEnum::Normal;
 #endif
 
-			return TaskList[taskId].GetPeriod();
+			return static_cast<TaskPriorityEnum>(GetPriorityBand(TaskPriorityEnum::Low) - TaskList[index].PriorityBand);
 		}
 
+#if defined(HARMONIC_TASK_BUDGET)
 		/// <summary>
-		/// Sets the run delay period for a task dynamically.
-		/// Safe to call from any context, including from an ISR.
+		/// Sets the execution time budget of a task. Overruns are reported to the budget listener.
+		/// Not safe to call from an ISR.
 		/// </summary>
 		/// <param name="taskId">Valid task ID.</param>
-		/// <param name="delay">New delay period in milliseconds.</param>
-		void SetPeriod(const task_id_t taskId, const uint32_t delay)
+		/// <param name="budget">Budget per run in microseconds, 0 for no budget.</param>
+		void SetBudget(const task_id_t taskId, const uint32_t budget)
 		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
-			if (!ValidateTaskId(taskId))
+			if (index == TASK_INVALID_ID)
 				return;
 #endif
 
-			TaskList[taskId].SetPeriod(delay);
-
-			if (HotRegistry)
-				Hot = true; // Flag hot state when task state changed.
+			// Stored in profiler ticks, compared to measured durations without conversion.
+			TaskList[index].Budget = Platform::MicrosToProfilerTicks(budget);
 		}
 
 		/// <summary>
-		/// Sets the enabled/disabled state for a task.
-		/// Safe to call from any context, including from an ISR.
+		/// Returns the execution time budget of a task, in microseconds.
+		/// Not safe to call from an ISR.
 		/// </summary>
 		/// <param name="taskId">Valid task ID.</param>
-		/// <param name="enabled">New enabled state.</param>
-		void SetEnabled(const task_id_t taskId, const bool enabled)
+		/// <returns>Budget per run in microseconds, 0 if none.</returns>
+		uint32_t GetBudget(const task_id_t taskId) const
 		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
-			if (!ValidateTaskId(taskId))
-				return;
+			if (index == TASK_INVALID_ID)
+				return 0;
 #endif
 
-			TaskList[taskId].SetEnabled(enabled);
+			return Platform::ProfilerTicksToMicros(TaskList[index].Budget);
+		}
 
-			if (HotRegistry)
-				Hot = true; // Flag hot state when task state changed.
+		/// <summary>
+		/// Sets the time budget of each Loop() pass.
+		/// Once spent, the remaining due tasks are deferred to the next pass. Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="budget">Budget per pass in microseconds, 0 for no budget.</param>
+		void SetPassBudget(const uint32_t budget)
+		{
+			PassBudget = Platform::MicrosToProfilerTicks(budget);
 		}
 
 		/// <summary>
-		/// Sets both the run delay period and enabled state for a task.
-		/// Safe to call from any context, including from an ISR.
+		/// Sets the listener for task budget overruns, nullptr to remove it.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="listener">Budget listener, or nullptr.</param>
+		void SetBudgetListener(IBudgetListener* listener)
+		{
+			BudgetListener = listener;
+		}
+#endif
+
+#if defined(HARMONIC_OVERLOAD)
+		/// <summary>
+		/// Tags a task as elastic: its period may be stretched up to maxPeriod under overload, and restored down to minPeriod.
+		/// The current period is clamped to the range. Not safe to call from an ISR.
 		/// </summary>
 		/// <param name="taskId">Valid task ID.</param>
-		/// <param name="delay">New delay period in milliseconds.</param>
-		/// <param name="enabled">New enabled state.</param>
-		void SetPeriodAndEnabled(const task_id_t taskId, const uint32_t delay, const bool enabled)
+		/// <param name="minPeriod">Nominal period in time base ticks, at least 1.</param>
+		/// <param name="maxPeriod">Largest stretched period in time base ticks, 0 to make the task fixed period again.</param>
+		/// <returns>True if the bounds were set.</returns>
+		bool SetElastic(const task_id_t taskId, const uint32_t minPeriod, const uint32_t maxPeriod)
 		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
-			if (!ValidateTaskId(taskId))
-				return;
+			if (index == TASK_INVALID_ID)
+				return false;
 #endif
+			if (maxPeriod != 0 && (minPeriod == 0 || minPeriod > maxPeriod))
+			{
+				return false;
+			}
 
-			TaskList[taskId].SetPeriodAndEnabled(delay, enabled);
+			Platform::TaskTracker& tracker = TaskList[index];
+			tracker.ElasticMin = minPeriod;
+			tracker.ElasticMax = maxPeriod;
+			if (maxPeriod != 0)
+			{
+				const uint32_t period = tracker.GetPeriod();
+				if (period < minPeriod || period > maxPeriod)
+				{
+					tracker.SetPeriod((period < minPeriod) ? minPeriod : maxPeriod);
+					OnTaskScheduleChanged(index);
+				}
+			}
 
-			if (HotRegistry)
-				Hot = true; // Flag hot state when task state changed.
+			return true;
 		}
 
 		/// <summary>
-		/// Wakes the scheduler and sets the task to run immediately.
-		/// Best way to quickly wake a task.
-		/// Safe to call from any context, including from an ISR.
+		/// Returns the number of periods a task dropped, because a run was more than one period late.
+		/// Saturates at UINT16_MAX. Not safe to call from an ISR.
 		/// </summary>
 		/// <param name="taskId">Valid task ID.</param>
-		void WakeFromISR(const task_id_t taskId)
+		/// <returns>Dropped periods since the task was attached or the count was cleared.</returns>
+		uint16_t GetMissCount(const task_id_t taskId) const
 		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
-			if (!ValidateTaskId(taskId))
-				return;
+			if (index == TASK_INVALID_ID)
+				return 0;
 #endif
 
-			TaskList[taskId].Wake();
+			return TaskList[index].MissCount;
+		}
 
-			if (HotRegistry)
-				Hot = true; // Flag hot state when task state changed.
+		/// <summary>
+		/// Clears the miss count of a task. Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		void ClearMissCount(const task_id_t taskId)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return;
+#endif
 
-			WakeFromInterrupt();
+			TaskList[index].MissCount = 0;
 		}
 
-	private:
-#ifdef HARMONIC_PLATFORM_OS
 		/// <summary>
-		/// Wakes the scheduler from idle sleep when a task is added or its state changes.
-		///
-		/// On RTOS platforms, this signals the scheduler's
-		/// semaphore from an interrupt context; on non-RTOS platforms, it does nothing.
+		/// Stretches or restores the period of every elastic task, one step.
+		/// Stretching adds a quarter of the period, up to the task's max.
+		/// Restoring removes half of the stretch, down to the task's min, so periods settle back quickly but smoothly.
+		/// Disabled tasks keep their period, and don't count as stretched. Not safe to call from an ISR.
 		/// </summary>
-		void WakeFromInterrupt()
+		/// <param name="stretch">True to stretch, false to restore.</param>
+		/// <returns>True if any elastic task is left stretched above its min.</returns>
+		bool ScaleElasticPeriods(const bool stretch)
 		{
-			BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-			xSemaphoreGiveFromISR(IdleSleepSemaphore, &xHigherPriorityTaskWoken);
-			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+			bool stretched = false;
+			for (task_id_t i = 0; i < TaskCount; i++)
+			{
+				Platform::TaskTracker& tracker = TaskList[i];
+				if (tracker.ElasticMax == 0 || !tracker.IsEnabled())
+				{
+					continue;
+				}
+
+				// SetPeriod() may have moved the period out of the bounds: clamp it first, so the steps can't wrap.
+				const uint32_t current = tracker.GetPeriod();
+				const uint32_t period = (current < tracker.ElasticMin) ? tracker.ElasticMin
+					: ((current > tracker.ElasticMax) ? tracker.ElasticMax : current);
+				uint32_t scaled = period;
+				if (stretch)
+				{
+					const uint32_t step = (period >> 2) != 0 ? (period >> 2) : 1;
+					scaled = ((tracker.ElasticMax - period) > step) ? (period + step) : tracker.ElasticMax;
+				}
+				else if (period > tracker.ElasticMin)
+				{
+					const uint32_t step = ((period - tracker.ElasticMin) >> 1) != 0 ? ((period - tracker.ElasticMin) >> 1) : 1;
+					scaled = period - step;
+				}
+
+				if (scaled != current)
+				{
+					tracker.SetPeriod(scaled);
+					OnTaskScheduleChanged(i);
+				}
+				stretched |= scaled > tracker.ElasticMin;
+			}
+
+			return stretched;
 		}
-#else
+#endif
+
+#if defined(HARMONIC_TASK_GROUPS)
 		/// <summary>
-		/// No-op function, compiled away.
+		/// Sets the groups a task belongs to, replacing its previous membership.
+		/// Safe to call from any context, including from an ISR.
 		/// </summary>
-		void WakeFromInterrupt() {}
+		/// <param name="taskId">Valid task ID.</param>
+		/// <param name="groupMask">Group membership, bit N for group N. 0 to leave all groups.</param>
+		/// <returns>True on success, false if the task ID is invalid.</returns>
+		bool SetTaskGroups(const task_id_t taskId, const uint8_t groupMask)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return false;
 #endif
 
+			TaskList[index].Groups = groupMask;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Returns the groups a task belongs to.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <returns>Group membership, bit N for group N. 0 if in no group, or the task ID is invalid.</returns>
+		uint8_t GetTaskGroups(const task_id_t taskId) const
+		{
+			const task_id_t index = ResolveTaskId(taskId);
 #if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return 0;
+#endif
+
+			return TaskList[index].Groups;
+		}
+
 		/// <summary>
-		/// Validates the given task ID and logs an error if invalid.
+		/// Sets the enabled state of every task in any of the given groups, as with SetEnabled().
+		/// All members switch in a single critical section, and the scheduler is signaled only once.
+		/// Safe to call from any context, including from an ISR.
 		/// </summary>
-		/// <param name="taskId">The task ID to validate.</param>
-		/// <returns>true if the task ID is valid; otherwise, false.</returns>
-		bool ValidateTaskId(const task_id_t taskId)
+		/// <param name="groupMask">Groups to update, bit N for group N.</param>
+		/// <param name="enabled">New enabled state.</param>
+		/// <returns>Number of tasks updated.</returns>
+		task_id_t SetGroupEnabled(const uint8_t groupMask, const bool enabled)
 		{
-			if (taskId == TASK_INVALID_ID)
+			task_id_t count = 0;
 			{
-				// Invalid Task Id: unregistered.
-				return false;
+				Platform::AtomicGuard guard;
+				for (task_id_t i = 0; i < TaskCount; i++)
+				{
+					if ((TaskList[i].Groups & groupMask) == 0)
+						continue;
+
+					TaskList[i].SetEnabledUnderGuard(enabled);
+#if defined(HARMONIC_ENABLED_MASK)
+					if (EnabledMask != nullptr)
+					{
+						if (enabled)
+						{
+							TaskMask::SetUnderGuard(EnabledMask, i);
+						}
+						else
+						{
+							EnabledMask[i / TaskMask::WordBits] &= ~(uint32_t(1) << (i % TaskMask::WordBits));
+						}
+					}
+#endif
+					OnGroupMemberChangedUnderGuard(i);
+					count++;
+				}
+				OnGroupChangedUnderGuard(count);
 			}
-			else if (taskId >= TaskCount)
+
+			if (enabled && count > 0)
 			{
-				// Invalid Task Id: unknown.
-				return false;
+				WakeFromInterrupt();
 			}
 
-			return true;
+			return count;
+		}
+
+		/// <summary>
+		/// Sets the run period of every task in any of the given groups, as with SetPeriod().
+		/// All members change in a single critical section.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="groupMask">Groups to update, bit N for group N.</param>
+		/// <param name="period">New period in time base ticks.</param>
+		/// <returns>Number of tasks updated.</returns>
+		task_id_t SetGroupPeriod(const uint8_t groupMask, const uint32_t period)
+		{
+			task_id_t count = 0;
+			{
+				Platform::AtomicGuard guard;
+				for (task_id_t i = 0; i < TaskCount; i++)
+				{
+					if ((TaskList[i].Groups & groupMask) == 0)
+						continue;
+
+					TaskList[i].SetPeriodUnderGuard(period);
+					OnGroupMemberChangedUnderGuard(i);
+					count++;
+				}
+				OnGroupChangedUnderGuard(count);
+			}
+
+			return count;
+		}
+
+		/// <summary>
+		/// Restarts the period of every task in any of the given groups from now,
+		/// so members with the same period run in phase, one period from now.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="groupMask">Groups to update, bit N for group N.</param>
+		/// <returns>Number of tasks updated.</returns>
+		task_id_t RephaseGroup(const uint8_t groupMask)
+		{
+			task_id_t count = 0;
+			{
+				Platform::AtomicGuard guard;
+				const uint32_t timestamp = Platform::GetTimestamp();
+				for (task_id_t i = 0; i < TaskCount; i++)
+				{
+					if ((TaskList[i].Groups & groupMask) == 0)
+						continue;
+
+					TaskList[i].LastRun = timestamp;
+					OnGroupMemberChangedUnderGuard(i);
+					count++;
+				}
+				OnGroupChangedUnderGuard(count);
+			}
+
+			return count;
+		}
+#endif
+
+#if defined(HARMONIC_TIMELINE)
+		/// <summary>
+		/// Sets the recorder for every task run, nullptr to remove it.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="recorder">Timeline recorder, or nullptr.</param>
+		void SetTimelineRecorder(ITimelineRecorder* recorder)
+		{
+			RunRecorder = recorder;
+		}
+#endif
+
+		/// <summary>
+		/// Returns the current delay period (in time base ticks) for the specified task.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <returns>The delay period in time base ticks.</returns>
+		uint32_t GetPeriod(const task_id_t taskId) const
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return UINT32_MAX;
+#endif
+
+			return TaskList[index].GetPeriod();
+		}
+
+		/// <summary>
+		/// Sets the run delay period for a task dynamically.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <param name="delay">New delay period in time base ticks.</param>
+		void SetPeriod(const task_id_t taskId, const uint32_t delay)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return;
+#endif
+
+			TaskList[index].SetPeriod(delay);
+
+			// Flag hot state when task state changed.
+			OnTaskScheduleChanged(index);
+		}
+
+		/// <summary>
+		/// Sets the enabled/disabled state for a task.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <param name="enabled">New enabled state.</param>
+		void SetEnabled(const task_id_t taskId, const bool enabled)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return;
+#endif
+
+			TaskList[index].SetEnabled(enabled);
+			OnTaskEnabledChanged(index, enabled);
+
+			// Flag hot state when task state changed.
+			OnTaskScheduleChanged(index);
+		}
+
+		/// <summary>
+		/// Sets both the run delay period and enabled state for a task.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <param name="delay">New delay period in time base ticks.</param>
+		/// <param name="enabled">New enabled state.</param>
+		void SetPeriodAndEnabled(const task_id_t taskId, const uint32_t delay, const bool enabled)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return;
+#endif
+
+			TaskList[index].SetPeriodAndEnabled(delay, enabled);
+			OnTaskEnabledChanged(index, enabled);
+
+			// Flag hot state when task state changed.
+			OnTaskScheduleChanged(index);
+		}
+
+		/// <summary>
+		/// Restarts the period of a task so its next run is due phase ticks from now, then every period.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		/// <param name="phase">Delay of the next run in time base ticks, clamped to the period.</param>
+		void SetPhase(const task_id_t taskId, const uint32_t phase)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return;
+#endif
+
+			{
+				Platform::AtomicGuard guard;
+				TaskList[index].SetPhase(phase);
+			}
+
+			// Flag hot state when task state changed.
+			OnTaskScheduleChanged(index);
+		}
+
+		/// <summary>
+		/// Staggers all enabled periodic tasks across the shortest period among them, in TaskList order:
+		/// their due times are spread evenly over that period instead of coinciding.
+		/// With harmonic periods (multiples of the shortest), tasks are due count slots apart, so a loop that keeps up
+		/// runs them in separate passes and idle windows get longer. A late pass or a resync can still bring two together.
+		/// Tasks with a period of 0 and disabled tasks are left as they are.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <returns>Number of tasks re-phased.</returns>
+		task_id_t SpreadPhases()
+		{
+			uint32_t basePeriod = UINT32_MAX;
+			task_id_t count = 0;
+			for (task_id_t i = 0; i < TaskCount; i++)
+			{
+				const uint32_t period = TaskList[i].GetPeriod();
+				if (period > 0 && TaskList[i].IsEnabled())
+				{
+					if (period < basePeriod)
+					{
+						basePeriod = period;
+					}
+					count++;
+				}
+			}
+
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			// Slot k of count starts k/count of the shortest period from now.
+			task_id_t slot = 0;
+			{
+				Platform::AtomicGuard guard;
+				for (task_id_t i = 0; i < TaskCount && slot < count; i++)
+				{
+					if (TaskList[i].GetPeriod() == 0 || !TaskList[i].IsEnabled())
+						continue;
+
+					TaskList[i].SetPhase(static_cast<uint32_t>((uint64_t(basePeriod) * slot) / count));
+					if (ScheduleChangedMask != nullptr)
+					{
+						TaskMask::SetUnderGuard(ScheduleChangedMask, i);
+					}
+					slot++;
+				}
+
+				if (HotRegistry)
+				{
+					Hot = true;
+					NextRunState = NextRunStateEnum::Invalid;
+				}
+			}
+
+			return slot;
+		}
+
+		/// <summary>
+		/// Wakes the scheduler and sets the task to run immediately.
+		/// Best way to quickly wake a task.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Valid task ID.</param>
+		void WakeFromISR(const task_id_t taskId)
+		{
+			const task_id_t index = ResolveTaskId(taskId);
+#if !defined(HARMONIC_SKIP_CHECKS)
+			if (index == TASK_INVALID_ID)
+				return;
+#endif
+
+			if (IsWakeTracked())
+			{
+				// Wake, enabled mask and schedule tracking in a single critical section.
+				Platform::AtomicGuard guard;
+				TaskList[index].WakeUnderGuard();
+				MarkEnabledUnderGuard(index);
+				OnTaskWokenUnderGuard(index);
+			}
+			else
+			{
+				TaskList[index].Wake();
+			}
+
+			WakeFromInterrupt(GetNotifyBit(taskId));
+		}
+
+		/// <summary>
+		/// Wakes a set of tasks at once and sets them to run immediately, as with WakeFromISR().
+		/// All tasks are woken in a single critical section, and the scheduler is signaled only once.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskMask">Bitmask of task IDs, bit N for task ID (wordIndex * 32) + N.</param>
+		/// <param name="wordIndex">Mask word, for task IDs 32 and up.</param>
+		void WakeMaskFromISR(uint32_t taskMask, const size_t wordIndex = 0)
+		{
+			const uint32_t notifyBits = taskMask; // Bit N % 32 for task ID N.
+			bool woken = false;
+			{
+				Platform::AtomicGuard guard;
+				while (taskMask != 0)
+				{
+					const uint8_t bit = TaskMask::FindFirstSet(taskMask);
+					taskMask &= taskMask - 1; // Clear lowest set bit.
+
+					const size_t taskId = (size_t(wordIndex) * TaskMask::WordBits) + bit;
+#if !defined(HARMONIC_SKIP_CHECKS)
+					if (taskId >= TASK_INVALID_ID)
+						break;
+#endif
+					const task_id_t index = ResolveTaskId(static_cast<task_id_t>(taskId));
+#if !defined(HARMONIC_SKIP_CHECKS)
+					if (index == TASK_INVALID_ID)
+						continue;
+#endif
+
+					TaskList[index].WakeUnderGuard();
+					MarkEnabledUnderGuard(index);
+					OnTaskWokenUnderGuard(index);
+					woken = true;
+				}
+			}
+
+			if (woken)
+			{
+				WakeFromInterrupt(notifyBits);
+			}
+		}
+
+		/// <summary>
+		/// Wakes the scheduler from idle sleep without changing any task, so the next Loop() pass starts promptly.
+		/// Used to signal work queued outside the registry, such as cross-core requests.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		void WakeScheduler()
+		{
+			if (HotRegistry)
+			{
+				Hot = true;
+			}
+
+			WakeFromInterrupt(0); // No task woken.
+		}
+
+#if defined(HARMONIC_RTOS_NOTIFY)
+		/// <summary>
+		/// Returns the notification bits that ended the last idle sleep, bit N for task ID N % 32.
+		/// 0 if the sleep timed out, or the scheduler was only woken by WakeScheduler().
+		/// </summary>
+		uint32_t GetWakeNotifications() const
+		{
+			return WakeNotifications;
+		}
+#endif
+
+		/// <summary>
+		/// Returns the TaskList index of an attached task ID, TASK_INVALID_ID if the ID is not attached.
+		/// Index and ID only differ with HARMONIC_STABLE_TASK_ID.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">Task ID to look up.</param>
+		/// <returns>TaskList index of the task, or TASK_INVALID_ID.</returns>
+		task_id_t GetTaskIndex(const task_id_t taskId) const
+		{
+#if defined(HARMONIC_STABLE_TASK_ID)
+			if (taskId < SlotCount)
+			{
+				const task_id_t index = SlotList[taskId];
+				if (index < TaskCount && TaskList[index].Id == taskId)
+				{
+					return index;
+				}
+			}
+
+			return TASK_INVALID_ID;
+#else
+			return (taskId < TaskCount) ? taskId : TASK_INVALID_ID;
+#endif
+		}
+
+		/// <summary>
+		/// Returns the task ID of the task at the given TaskList index.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="index">Valid TaskList index, lower than GetTaskCount().</param>
+		/// <returns>Task ID at the index.</returns>
+		task_id_t GetTaskIdAt(const task_id_t index) const
+		{
+#if defined(HARMONIC_STABLE_TASK_ID)
+			return TaskList[index].Id;
+#else
+			return index;
+#endif
+		}
+
+		/// <summary>
+		/// Returns the task attached with the given task ID.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="taskId">Task ID to look up.</param>
+		/// <returns>Pointer to the task, nullptr if the ID is not attached.</returns>
+		ITask* GetTask(const task_id_t taskId) const
+		{
+			const task_id_t index = GetTaskIndex(taskId);
+			if (index == TASK_INVALID_ID)
+				return nullptr;
+
+			return TaskList[index].Task;
+		}
+
+		/// <summary>
+		/// Returns the time in time base ticks until the next enabled task is due to run.
+		/// Hot registries answer from the next deadline cache in O(1), rescanning only when the cache was invalidated.
+		/// If a task is due within 'shortest' ticks, a rescan exits early for efficiency, without caching its result.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="timestamp">Current timestamp.</param>
+		/// <param name="shortest">Early exit threshold in ticks.</param>
+		/// <returns>Time in ticks until the next task is due, UINT32_MAX if no task is enabled.</returns>
+		uint32_t GetTimeUntilNextRun(const uint32_t timestamp, const uint32_t shortest = 0) const
+		{
+			if (HotRegistry)
+			{
+				task_id_t nextId;
+				{
+					Platform::AtomicGuard guard;
+					if (NextRunState == NextRunStateEnum::Valid)
+					{
+						nextId = NextRunId;
+					}
+					else
+					{
+						NextRunState = NextRunStateEnum::Scanning;
+						nextId = TASK_INVALID_ID;
+					}
+				}
+
+				if (nextId != TASK_INVALID_ID)
+				{
+					return TaskList[nextId].TimeUntilNextRun(timestamp);
+				}
+				else if (NextRunState == NextRunStateEnum::Valid)
+				{
+					return UINT32_MAX; // Cached: no task enabled.
+				}
+			}
+
+			// Full rescan, caching the result if no schedule change happened in the meantime.
+			uint32_t shortestTime = UINT32_MAX;
+			task_id_t shortestId = TASK_INVALID_ID;
+			for (task_id_t i = GetNextEnabledIndex(0); i < TaskCount; i = GetNextEnabledIndex(i + 1))
+			{
+				const uint32_t timeUntilNext = TaskList[i].TimeUntilNextRun(timestamp);
+				if (timeUntilNext < shortestTime)
+				{
+					shortestTime = timeUntilNext;
+					shortestId = i;
+					if (shortestTime <= shortest)
+					{
+						break; // Due soon enough, or nothing can be due sooner.
+					}
+				}
+			}
+
+			if (HotRegistry)
+			{
+				Platform::AtomicGuard guard;
+				if (NextRunState == NextRunStateEnum::Scanning)
+				{
+					if (shortestTime == 0 || shortestTime > shortest)
+					{
+						NextRunId = shortestId;
+						NextRunState = NextRunStateEnum::Valid;
+					}
+					else
+					{
+						NextRunState = NextRunStateEnum::Invalid; // Exited early, another task may be due sooner.
+					}
+				}
+			}
+
+			return shortestTime;
+		}
+
+	protected:
+		/// <summary>
+		/// Ends the run started by setting RunningIndex.
+		/// </summary>
+		/// <returns>The current TaskList index of the task that ran.</returns>
+		task_id_t EndTaskRun()
+		{
+			const task_id_t index = RunningIndex;
+			RunningIndex = TASK_INVALID_ID;
+
+			return index;
+		}
+
+#if defined(HARMONIC_TIMELINE)
+		/// <summary>
+		/// Returns true if runs are being recorded, so schedulers that skip timing can time them.
+		/// </summary>
+		bool IsTimelineRecording() const
+		{
+			return RunRecorder != nullptr;
+		}
+
+		/// <summary>
+		/// Reports a run to the timeline recorder, if set.
+		/// </summary>
+		/// <param name="index">TaskList index of the task that ran.</param>
+		/// <param name="start">Profiler timestamp right before Run().</param>
+		/// <param name="duration">Run() duration in profiler ticks.</param>
+		/// <param name="lateness">Start lateness in time base ticks.</param>
+		void RecordTimelineRun(const task_id_t index, const uint32_t start, const uint32_t duration, const uint32_t lateness)
+		{
+			if (RunRecorder != nullptr)
+			{
+				RunRecorder->OnTaskRun(GetTaskIdAt(index), start, duration, lateness);
+			}
+		}
+#endif
+
+#if defined(HARMONIC_TASK_BUDGET)
+		/// <summary>
+		/// Starts a budgeted Loop() pass.
+		/// Higher priority bands still go first: only the band the last pass was cut off in resumes where it stopped.
+		/// </summary>
+		/// <returns>TaskList index the pass starts from.</returns>
+		task_id_t StartBudgetPass()
+		{
+			PassStart = Platform::GetProfilerTimestamp();
+			PassResume = (ResumeIndex < TaskCount) ? ResumeIndex : 0;
+			ResumeIndex = 0;
+			if (TaskCount == 0)
+			{
+				PassBandStart = 0;
+				PassBandEnd = 0;
+
+				return 0;
+			}
+
+			const uint8_t band = GetTaskBand(PassResume);
+			PassBandStart = GetBandStart(band);
+			PassBandEnd = GetBandEnd(band);
+
+			return (PassBandStart > 0) ? 0 : PassResume;
+		}
+
+		/// <summary>
+		/// Returns the index after the given one in a budgeted pass:
+		/// the bands above the resumed one, the resumed band rotated to start at the resume index, then the bands below.
+		/// </summary>
+		/// <param name="index">TaskList index visited last.</param>
+		/// <returns>Next TaskList index to visit.</returns>
+		task_id_t GetNextBudgetIndex(const task_id_t index) const
+		{
+			task_id_t next = index + 1;
+			if (next == PassBandStart)
+			{
+				// Higher priority bands done.
+				next = PassResume;
+			}
+			else if (next == PassBandEnd)
+			{
+				// Wrap around inside the resumed band, if it was rotated.
+				next = (PassResume != PassBandStart) ? PassBandStart : PassBandEnd;
+			}
+			else if (next == PassResume)
+			{
+				// Rotated band done.
+				next = PassBandEnd;
+			}
+
+			return (next < TaskCount) ? next : 0;
+		}
+
+		/// <summary>
+		/// Returns the run budget of the task at the given TaskList index in profiler ticks, 0 if none.
+		/// </summary>
+		/// <param name="index">TaskList index.</param>
+		uint32_t GetTaskBudget(const task_id_t index) const
+		{
+			return TaskList[index].Budget;
+		}
+
+		/// <summary>
+		/// Reports a run that exceeded its task budget.
+		/// </summary>
+		/// <param name="index">TaskList index of the task that ran.</param>
+		/// <param name="duration">Measured run duration in profiler ticks.</param>
+		/// <param name="budget">Task budget in profiler ticks, non-zero.</param>
+		void CheckTaskBudget(const task_id_t index, const uint32_t duration, const uint32_t budget)
+		{
+			if (duration > budget
+				&& BudgetListener != nullptr
+				&& index < TaskCount)
+			{
+				BudgetListener->OnBudgetOverrun(GetTaskIdAt(index), Platform::ProfilerTicksToMicros(duration));
+			}
+		}
+
+		/// <summary>
+		/// Checks the pass budget after a run.
+		/// When spent, the next pass resumes at the given index.
+		/// </summary>
+		/// <param name="nextIndex">TaskList index the pass would continue at.</param>
+		/// <returns>True if the pass must stop.</returns>
+		bool IsPassBudgetSpent(const task_id_t nextIndex)
+		{
+			if (PassBudget != 0
+				&& (Platform::GetProfilerTimestamp() - PassStart) >= PassBudget)
+			{
+				ResumeIndex = nextIndex;
+				return true;
+			}
+
+			return false;
+		}
+#endif
+
+		/// <summary>
+		/// Returns the priority band of the task at the given TaskList index, 0 being the highest priority.
+		/// </summary>
+		/// <param name="index">TaskList index.</param>
+		uint8_t GetTaskBand(const task_id_t index) const
+		{
+			return TaskList[index].PriorityBand;
+		}
+
+		/// <summary>
+		/// Returns the first TaskList index of a priority band.
+		/// All tasks before it have a higher priority.
+		/// </summary>
+		/// <param name="band">Priority band.</param>
+		task_id_t GetBandStart(const uint8_t band) const
+		{
+			return (band > 0) ? BandEnd[band - 1] : 0;
+		}
+
+		/// <summary>
+		/// Returns the end TaskList index (exclusive) of a priority band.
+		/// </summary>
+		/// <param name="band">Priority band.</param>
+		task_id_t GetBandEnd(const uint8_t band) const
+		{
+			return BandEnd[band];
+		}
+
+		/// <summary>
+		/// Returns the first TaskList index from the given one whose task may be enabled.
+		/// With HARMONIC_ENABLED_MASK, disabled tasks are skipped a mask word at a time,
+		/// and stale bits found on the way are cleared. Otherwise returns the index itself.
+		/// </summary>
+		/// <param name="index">First TaskList index to check.</param>
+		/// <returns>TaskList index of a possibly enabled task, TaskCount or more if none is left.</returns>
+		task_id_t GetNextEnabledIndex(const task_id_t index) const
+		{
+#if defined(HARMONIC_ENABLED_MASK)
+			if (EnabledMask == nullptr)
+				return index;
+
+			size_t i = index;
+			while (i < TaskCount)
+			{
+				const size_t wordIndex = i / TaskMask::WordBits;
+				const uint32_t word = EnabledMask[wordIndex] & (UINT32_MAX << (i % TaskMask::WordBits));
+				if (word == 0)
+				{
+					i = (wordIndex + 1) * TaskMask::WordBits;
+					continue;
+				}
+
+				i = (wordIndex * TaskMask::WordBits) + TaskMask::FindFirstSet(word);
+				if (i >= TaskCount)
+					break;
+
+				if (TaskList[i].IsEnabled())
+					return static_cast<task_id_t>(i);
+
+				ClearEnabledIfDisabled(static_cast<task_id_t>(i));
+				i++;
+			}
+
+			return TaskCount;
+#else
+			return index;
+#endif
+		}
+
+		/// <summary>
+		/// Marks a range of task IDs as changed for deadline-ordered schedulers, if any.
+		/// </summary>
+		/// <param name="first">First changed task ID.</param>
+		/// <param name="count">Number of consecutive changed task IDs.</param>
+		void MarkScheduleChanged(const task_id_t first, const task_id_t count)
+		{
+			if (ScheduleChangedMask != nullptr)
+			{
+				TaskMask::SetRange(ScheduleChangedMask, first, count);
+			}
+		}
+
+		/// <summary>
+		/// Notifies the next deadline cache that a task has run and its deadline moved.
+		/// Called by the scheduler loop, only when idle sleep is enabled.
+		/// </summary>
+		/// <param name="taskId">TaskList index of the task that ran.</param>
+		void OnTaskRun(const task_id_t taskId)
+		{
+			if (taskId == NextRunId)
+			{
+				// The earliest deadline moved later, the next idle check must rescan.
+				NextRunState = NextRunStateEnum::Invalid;
+			}
+		}
+
+	private:
+		/// <summary>
+		/// Opens an unused index at the end of a priority band,
+		/// by moving the first task of each lower priority band to the end of its band.
+		/// </summary>
+		/// <param name="band">Priority band to grow.</param>
+		/// <returns>The unused index, now at the end of the band.</returns>
+		task_id_t OpenBandGap(const uint8_t band)
+		{
+			task_id_t gap = TaskCount;
+			for (uint8_t b = TASK_PRIORITY_COUNT - 1; b > band; b--)
+			{
+				const task_id_t first = BandEnd[b - 1];
+				if (first != gap)
+				{
+					MoveTask(first, gap);
+					gap = first;
+				}
+				BandEnd[b]++;
+			}
+			BandEnd[band]++;
+
+			return gap;
+		}
+
+#if defined(HARMONIC_STABLE_TASK_ID)
+		/// <summary>
+		/// Fills an unused index in a priority band with the band's last task,
+		/// then the gap left behind with the last task of each lower priority band.
+		/// </summary>
+		/// <param name="gap">Unused index in the band.</param>
+		/// <param name="band">Priority band to shrink.</param>
+		/// <returns>The index left unused, the last of the TaskList.</returns>
+		task_id_t CloseBandGap(task_id_t gap, const uint8_t band)
+		{
+			for (uint8_t b = band; b < TASK_PRIORITY_COUNT; b++)
+			{
+				const task_id_t last = BandEnd[b] - 1;
+				if (last != gap)
+				{
+					MoveTask(last, gap);
+				}
+				gap = last;
+				BandEnd[b]--;
+			}
+
+			return gap;
+		}
+#endif
+
+		/// <summary>
+		/// Moves a tracker to an unused index, keeping its task ID and the scheduler state coherent.
+		/// </summary>
+		/// <param name="from">Current index of the tracker.</param>
+		/// <param name="to">Unused destination index.</param>
+		void MoveTask(const task_id_t from, const task_id_t to)
+		{
+			{
+				// Move and remap atomically, so ISR calls never see a half-moved tracker, or a task ID pointing at another task.
+				Platform::AtomicGuard guard;
+				TaskList[to] = TaskList[from];
+#if defined(HARMONIC_STABLE_TASK_ID)
+				SlotList[TaskList[to].Id] = to;
+#else
+				TaskList[to].NotifyTaskIdUpdate(to); // Update task ID in the moved task.
+#endif
+			}
+			if (from == RunningIndex)
+			{
+				// Attached from the running task's Run(): the scheduler finishes the run at the new index.
+				RunningIndex = to;
+			}
+			MarkScheduleChanged(from, 1);
+			MarkScheduleChanged(to, 1);
+			MarkEnabled(to);
+
+			if (HotRegistry)
+			{
+				NextRunState = NextRunStateEnum::Invalid; // Task indices have moved.
+			}
+		}
+
+		/// <summary>
+		/// Sets the enabled mask bit of a task that may have been enabled. Compiled away without HARMONIC_ENABLED_MASK.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="index">TaskList index of the task.</param>
+		void MarkEnabled(const task_id_t index)
+		{
+#if defined(HARMONIC_ENABLED_MASK)
+			if (EnabledMask != nullptr)
+			{
+				TaskMask::Set(EnabledMask, index);
+			}
+#else
+			(void)index;
+#endif
+		}
+
+		/// <summary>
+		/// Same as MarkEnabled(), for callers already holding an AtomicGuard.
+		/// </summary>
+		/// <param name="index">TaskList index of the task.</param>
+		void MarkEnabledUnderGuard(const task_id_t index)
+		{
+#if defined(HARMONIC_ENABLED_MASK)
+			if (EnabledMask != nullptr)
+			{
+				TaskMask::SetUnderGuard(EnabledMask, index);
+			}
+#else
+			(void)index;
+#endif
+		}
+
+		/// <summary>
+		/// Updates the enabled mask bit after a task's enabled state was set.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="index">TaskList index of the task.</param>
+		/// <param name="enabled">Enabled state that was set.</param>
+		void OnTaskEnabledChanged(const task_id_t index, const bool enabled)
+		{
+#if defined(HARMONIC_ENABLED_MASK)
+			if (enabled)
+			{
+				MarkEnabled(index);
+			}
+			else
+			{
+				ClearEnabledIfDisabled(index);
+			}
+#else
+			(void)index;
+			(void)enabled;
+#endif
+		}
+
+#if defined(HARMONIC_ENABLED_MASK)
+		/// <summary>
+		/// Clears the enabled mask bit of a task, unless it was enabled again.
+		/// Enablers update the tracker before setting the bit, so a bit is never lost
+		/// when the check and clear are done under the same guard.
+		/// </summary>
+		/// <param name="index">TaskList index of the task.</param>
+		void ClearEnabledIfDisabled(const task_id_t index) const
+		{
+			if (EnabledMask == nullptr)
+				return;
+
+			Platform::AtomicGuard guard;
+			if (!TaskList[index].IsEnabled())
+			{
+				EnabledMask[index / TaskMask::WordBits] &= ~(uint32_t(1) << (index % TaskMask::WordBits));
+			}
+		}
+#endif
+
+		/// <summary>
+		/// Flags hot state and updates the next deadline cache after a task's schedule changed.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="taskId">TaskList index of the changed task.</param>
+		void OnTaskScheduleChanged(const task_id_t taskId)
+		{
+			if (ScheduleChangedMask != nullptr)
+			{
+				TaskMask::Set(ScheduleChangedMask, taskId);
+			}
+
+			if (HotRegistry)
+			{
+				Hot = true;
+
+				Platform::AtomicGuard guard;
+				switch (NextRunState)
+				{
+				case NextRunStateEnum::Valid:
+					if (taskId == NextRunId)
+					{
+						// The cached task may now be due later, or not at all.
+						NextRunState = NextRunStateEnum::Invalid;
+					}
+					else
+					{
+						const uint32_t timestamp = Platform::GetTimestamp();
+						if (NextRunId == TASK_INVALID_ID
+							|| TaskList[taskId].TimeUntilNextRun(timestamp) < TaskList[NextRunId].TimeUntilNextRun(timestamp))
+						{
+							NextRunId = taskId;
+						}
+					}
+					break;
+				case NextRunStateEnum::Scanning:
+					// Change happened mid-scan, discard its result.
+					NextRunState = NextRunStateEnum::Invalid;
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Returns true if a wake has registry state to update besides the tracker:
+		/// the enabled mask, the schedule change mask or the next deadline cache.
+		/// Without any, a wake needs no registry critical section.
+		/// </summary>
+		bool IsWakeTracked() const
+		{
+#if defined(HARMONIC_ENABLED_MASK)
+			if (EnabledMask != nullptr)
+				return true;
+#endif
+			return ScheduleChangedMask != nullptr || HotRegistry;
+		}
+
+		/// <summary>
+		/// Flags hot state and updates the next deadline cache after a task was woken.
+		/// A woken task is due immediately, so it becomes the cached next task without reading timestamps.
+		/// Call while holding an AtomicGuard.
+		/// </summary>
+		/// <param name="taskId">TaskList index of the woken task.</param>
+		void OnTaskWokenUnderGuard(const task_id_t taskId)
+		{
+			if (ScheduleChangedMask != nullptr)
+			{
+				TaskMask::SetUnderGuard(ScheduleChangedMask, taskId);
+			}
+
+			if (HotRegistry)
+			{
+				Hot = true;
+
+				if (NextRunState == NextRunStateEnum::Valid)
+				{
+					NextRunId = taskId;
+				}
+				else if (NextRunState == NextRunStateEnum::Scanning)
+				{
+					NextRunState = NextRunStateEnum::Invalid;
+				}
+			}
+		}
+
+#if defined(HARMONIC_TASK_GROUPS)
+		/// <summary>
+		/// Marks a group member's schedule as changed, for deadline-ordered schedulers.
+		/// </summary>
+		/// <param name="index">TaskList index of the member.</param>
+		void OnGroupMemberChangedUnderGuard(const task_id_t index)
+		{
+			if (ScheduleChangedMask != nullptr)
+			{
+				TaskMask::SetUnderGuard(ScheduleChangedMask, index);
+			}
+		}
+
+		/// <summary>
+		/// Flags hot state and invalidates the next deadline cache once, after a group update.
+		/// </summary>
+		/// <param name="count">Number of members updated.</param>
+		void OnGroupChangedUnderGuard(const task_id_t count)
+		{
+			if (HotRegistry && count > 0)
+			{
+				Hot = true;
+				NextRunState = NextRunStateEnum::Invalid;
+			}
+		}
+#endif
+
+#if defined(HARMONIC_RTOS_NOTIFY)
+		/// <summary>
+		/// Wakes the scheduler from idle sleep when a task is added or its state changes.
+		///
+		/// Sets the notification bits of the scheduler's thread, only if it is blocked or about to block:
+		/// wakes while the scheduler is running cost a load, instead of a kernel call.
+		/// </summary>
+		/// <param name="notifyBits">Task ID bits to notify, bit N for task ID N % 32.</param>
+		void WakeFromInterrupt(const uint32_t notifyBits = UINT32_MAX)
+		{
+			Platform::MemoryBarrier(); // Publish the task state before checking the sleep flag.
+			if (IdleSleeping)
+			{
+				BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+				xTaskNotifyFromISR(IdleSleepThread, notifyBits, eSetBits, &xHigherPriorityTaskWoken);
+				portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+			}
+		}
+#elif defined(HARMONIC_PLATFORM_OS)
+		/// <summary>
+		/// Wakes the scheduler from idle sleep when a task is added or its state changes.
+		///
+		/// On RTOS platforms, this signals the scheduler's
+		/// semaphore from an interrupt context; on non-RTOS platforms, it does nothing.
+		/// </summary>
+		void WakeFromInterrupt(const uint32_t /*notifyBits*/ = UINT32_MAX)
+		{
+			BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+			xSemaphoreGiveFromISR(IdleSleepSemaphore, &xHigherPriorityTaskWoken);
+			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		}
+#else
+		/// <summary>
+		/// No-op function, compiled away.
+		/// </summary>
+		void WakeFromInterrupt(const uint32_t /*notifyBits*/ = UINT32_MAX) {}
+#endif
+
+		/// <summary>
+		/// Returns the wake notification bit of a task ID, see HARMONIC_RTOS_NOTIFY.
+		/// </summary>
+		static constexpr uint32_t GetNotifyBit(const task_id_t taskId)
+		{
+			return uint32_t(1) << (taskId % 32);
+		}
+
+		/// <summary>
+		/// Checks if a task is attached, to this registry or, for tasks that track their own ID, to any registry.
+		/// A task has a single ID, so it can't be attached to more than one registry.
+		/// </summary>
+		/// <param name="task">Pointer to ITask implementation.</param>
+		/// <returns>True if the task is attached.</returns>
+		bool IsAttached(const ITask* task) const
+		{
+			task_id_t assignedId;
+			if (task->GetAssignedTaskId(assignedId))
+			{
+				return assignedId != TASK_INVALID_ID;
+			}
+
+			return TaskExists(task);
+		}
+
+		/// <summary>
+		/// Resolves a task ID to its TaskList index.
+		/// Validated unless HARMONIC_SKIP_CHECKS is set, in which case the ID is trusted.
+		/// </summary>
+		/// <param name="taskId">The task ID to resolve.</param>
+		/// <returns>TaskList index of the task, or TASK_INVALID_ID if validated and not attached.</returns>
+		task_id_t ResolveTaskId(const task_id_t taskId) const
+		{
+#if defined(HARMONIC_SKIP_CHECKS)
+#if defined(HARMONIC_STABLE_TASK_ID)
+			return SlotList[taskId];
+#else
+			return taskId;
+#endif
+#else
+			return GetTaskIndex(taskId);
+#endif
 		}
-#endif
 	};
 }
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _HARMONIC_TASK_TRACKER_h
 
 #include "ITask.h"
+#include "TaskPriority.h"
 #include "../Platform/Atomic.h"
 
 namespace Harmonic
@@ -11,6 +12,10 @@ namespace Harmonic
 		/// <summary>
 		/// Tracks and manages the execution of a single ITask.
 		/// Supports dynamic binding, removal, and notification of task ID changes.
+		/// 
+		/// With HARMONIC_PLATFORM_ATOMIC_STATE (32-bit OS platforms), the enabled state and period are packed in one word.
+		/// Reads take a single load, and updates a compare-and-swap, lock-free with HARMONIC_PLATFORM_ATOMIC_CAS.
+		/// Periods are then limited to 2^31 - 1 ticks, as already required for wraparound-safe ordering.
 		/// </summary>
 		struct TaskTracker
 		{
@@ -19,38 +24,130 @@ namespace Harmonic
 			/// </summary>
 			ITask* Task = nullptr;
 
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
 			/// <summary>
-			/// Minimum period (in milliseconds) between consecutive task runs.
+			/// Enabled flag bit of the packed State.
+			/// </summary>
+			static constexpr uint32_t StateEnabled = uint32_t(1) << 31;
+
+			/// <summary>
+			/// Period bits of the packed State.
+			/// </summary>
+			static constexpr uint32_t StatePeriodMask = StateEnabled - 1;
+
+			/// <summary>
+			/// Packed run state: enabled flag (StateEnabled) and minimum period between runs (StatePeriodMask), in time base ticks.
+			/// </summary>
+			volatile uint32_t State = 0;
+#else
+			/// <summary>
+			/// Minimum period (in time base ticks) between consecutive task runs.
 			/// </summary>
 			volatile uint32_t Period = 0;
+#endif
 
 			/// <summary>
-			/// Timestamp (in ms) of the last time the task was run.
+			/// Timestamp (in time base ticks) of the last time the task was run.
 			/// </summary>
 			uint32_t LastRun = 0;
 
+#if !defined(HARMONIC_PLATFORM_ATOMIC_STATE)
 			/// <summary>
 			/// Indicates whether the task is enabled and eligible to run.
 			/// </summary>
 			volatile bool Enabled = false;
+#endif
+
+			/// <summary>
+			/// Priority band of the bound task, 0 being the highest priority.
+			/// </summary>
+			uint8_t PriorityBand = GetPriorityBand(TaskPriorityEnum::Normal);
+
+#if defined(HARMONIC_STABLE_TASK_ID)
+			/// <summary>
+			/// Stable task ID of the bound task, moves with the tracker.
+			/// </summary>
+			task_id_t Id = TASK_INVALID_ID;
+#endif
+
+#if defined(HARMONIC_TASK_BUDGET)
+			/// <summary>
+			/// Execution time budget per run in profiler ticks, 0 for no budget.
+			/// </summary>
+			uint32_t Budget = 0;
+#endif
+
+#if defined(HARMONIC_OVERLOAD)
+			/// <summary>
+			/// Elastic period bounds in time base ticks, ElasticMax 0 for a fixed period.
+			/// </summary>
+			uint32_t ElasticMin = 0;
+			uint32_t ElasticMax = 0;
+
+			/// <summary>
+			/// Periods dropped by catch-up resyncs since the task was bound, saturating.
+			/// </summary>
+			uint16_t MissCount = 0;
+#endif
+
+#if defined(HARMONIC_TASK_GROUPS)
+			/// <summary>
+			/// Task group membership, bit N for group N. 0 if the task is in no group.
+			/// </summary>
+			uint8_t Groups = 0;
+#endif
 
 			/// <summary>
 			/// Binds a task with a specified execution period and enabled state, and initializes its last run timestamp.
 			/// </summary>
 			/// <param name="task">Pointer to the task to be bound.</param>
-			/// <param name="period">The execution period for the task, in milliseconds.</param>
+			/// <param name="period">The execution period for the task, in time base ticks.</param>
 			/// <param name="enabled">Indicates whether the task should be enabled.</param>
-			void BindTask(ITask* task, const uint32_t period, const bool enabled)
+			/// <param name="phase">Delay of the first run in time base ticks, clamped to the period.</param>
+			void BindTask(ITask* task, const uint32_t period, const bool enabled, const uint32_t phase = UINT32_MAX)
 			{
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				// Set the task and LastRun first, the state store publishes them.
+				Task = task;
+#if defined(HARMONIC_TASK_BUDGET)
+				Budget = 0;
+#endif
+#if defined(HARMONIC_OVERLOAD)
+				ElasticMin = 0;
+				ElasticMax = 0;
+				MissCount = 0;
+#endif
+#if defined(HARMONIC_TASK_GROUPS)
+				Groups = 0;
+#endif
+				if (enabled)
+				{
+					LastRun = Platform::GetTimestamp() - GetPhaseLead(period, phase);
+				}
+				Platform::MemoryBarrier();
+				State = PackState(period, enabled);
+#else
 				// Atomically set the task, period, enabled state and initialize LastRun.
 				Platform::AtomicGuard guard;
 				Task = task;
 				Period = period;
 				Enabled = enabled;
+#if defined(HARMONIC_TASK_BUDGET)
+				Budget = 0;
+#endif
+#if defined(HARMONIC_OVERLOAD)
+				ElasticMin = 0;
+				ElasticMax = 0;
+				MissCount = 0;
+#endif
+#if defined(HARMONIC_TASK_GROUPS)
+				Groups = 0;
+#endif
 				if (enabled)
 				{
-					LastRun = Platform::GetTimestamp();
+					LastRun = Platform::GetTimestamp() - GetPhaseLead(period, phase);
 				}
+#endif
 			}
 
 			/// <summary>
@@ -63,14 +160,14 @@ namespace Harmonic
 #if !defined(HARMONIC_SKIP_CHECKS)
 				if (Task == nullptr)
 				{
-					Enabled = false;
+					SetEnabled(false);
 					return;
 				}
 #endif
 				Task->OnTaskIdUpdated(taskId);
 				if (taskId == TASK_INVALID_ID)
 				{
-					Enabled = false; // Disable the task if it was removed from the registry.
+					SetEnabled(false); // Disable the task if it was removed from the registry.
 				}
 			}
 
@@ -82,78 +179,81 @@ namespace Harmonic
 			/// during the read. This prevents race conditions with ISRs that may modify these
 			/// variables, ensuring a consistent snapshot of their values.
 			/// </summary>
-			/// <param name="timestamp">Current timestamp in milliseconds.</param>
-			/// <returns>True if the task was run, false otherwise.</returns>			
+			/// <returns>True if the task was run, false otherwise.</returns>
 			bool RunIfTime()
 			{
-#if !defined(HARMONIC_SKIP_CHECKS)
-				if (Task == nullptr)
-				{
-					return false;
-				}
-#endif
-				// On all supported platforms, reading/writing a bool is atomic.
-				if (!Enabled)
-				{
-					return false;
-				}
+				uint32_t lateness, start, duration;
 
-#if defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
-				// Use atomic protection.
-				uint32_t period;
-				{
-					Platform::AtomicGuard guard;
-					period = Period;
-				}
-#else
-				// 32-bit+ platforms: 32-bit access is atomic
-				const uint32_t period = Period;
-#endif
+				return RunIfDue<false>(lateness, start, duration);
+			}
 
-				const uint32_t timestamp = Platform::GetTimestamp();
-				const uint32_t elapsed = timestamp - LastRun;
+			/// <summary>
+			/// Runs the task if it is due, as RunIfTime(), and reports how late the run started.
+			/// </summary>
+			/// <param name="lateness">Output: start time minus scheduled time (LastRun + Period) in time base ticks, 0 for period 0. Only set if the task ran.</param>
+			/// <returns>True if the task was run, false otherwise.</returns>
+			bool RunIfTime(uint32_t& lateness)
+			{
+				uint32_t start, duration;
 
-				// Run the task if the period has elapsed.
-				// Uses unsigned arithmetic for overflow safety.
-				// The > comparison enforces late bias:
-				// the task will only run after the scheduled period has fully elapsed, never early.
-				if (period == 0 || (elapsed > period))
-				{
-					Task->Run();
+				return RunIfDue<false>(lateness, start, duration);
+			}
 
-					// If the scheduler was delayed and we missed more than one period,
-					// resynchronize LastRun to the current timestamp to avoid multiple rapid catch-up runs.
-					if (period > 1 && ((elapsed >> 1) > period))
-					{
-						// If we missed more than one period (scheduler delayed), resync LastRun to now.
-						LastRun = timestamp;
-					}
-					else
-					{
-						LastRun += period;
-					}
+			/// <summary>
+			/// Runs the task if it is due, as RunIfTime(lateness), and measures its Run() duration.
+			/// The profiler timestamp is only read around an actual run, not for tasks that aren't due.
+			/// </summary>
+			/// <param name="lateness">Output: start lateness in time base ticks. Only set if the task ran.</param>
+			/// <param name="duration">Output: Run() duration in profiler ticks. Only set if the task ran.</param>
+			/// <returns>True if the task was run, false otherwise.</returns>
+			bool RunIfTime(uint32_t& lateness, uint32_t& duration)
+			{
+				uint32_t start;
 
-					return true;
-				}
-				else
-				{
-					return false;
-				}
+				return RunIfDue<true>(lateness, start, duration);
+			}
+
+			/// <summary>
+			/// Runs the task if it is due, as RunIfTime(lateness, duration), and reports when Run() started.
+			/// </summary>
+			/// <param name="lateness">Output: start lateness in time base ticks. Only set if the task ran.</param>
+			/// <param name="start">Output: profiler timestamp taken right before Run(). Only set if the task ran.</param>
+			/// <param name="duration">Output: Run() duration in profiler ticks. Only set if the task ran.</param>
+			/// <returns>True if the task was run, false otherwise.</returns>
+			bool RunIfTime(uint32_t& lateness, uint32_t& start, uint32_t& duration)
+			{
+				return RunIfDue<true>(lateness, start, duration);
 			}
 
 			/// <summary>
 			/// Sets the run period.
 			/// Can be called at any time to update the period dynamically.
 			/// </summary>
-			/// <param name="period">New period in milliseconds.</param>
+			/// <param name="period">New period in time base ticks.</param>
 			void SetPeriod(const uint32_t period)
 			{
 #if defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
 				// Use atomic protection.
 				Platform::AtomicGuard guard;
-				Period = period;
+#endif
+				SetPeriodUnderGuard(period);
+			}
+
+			/// <summary>
+			/// Same as SetPeriod(), for callers already holding an AtomicGuard.
+			/// </summary>
+			/// <param name="period">New period in time base ticks.</param>
+			void SetPeriodUnderGuard(const uint32_t period)
+			{
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				// Replace the period, keeping the enabled state.
+				uint32_t state;
+				do
+				{
+					state = State;
+				} while (!Platform::CompareExchange(State, state, (state & StateEnabled) | ClampPeriod(period)));
 #else
-				// 32-bit+ platforms: 32-bit access is atomic
+				// 32-bit+ platforms: 32-bit access is atomic, 8-bit platforms are guarded by the caller.
 				Period = period;
 #endif
 			}
@@ -165,13 +265,42 @@ namespace Harmonic
 			/// <param name="enabled">New enabled state.</param>
 			void SetEnabled(const bool enabled)
 			{
+#if !defined(HARMONIC_PLATFORM_ATOMIC_STATE)
 				// Atomically update the enabled state, updating LastRun if enabling the task.
 				Platform::AtomicGuard guard;
+#endif
+				SetEnabledUnderGuard(enabled);
+			}
+
+			/// <summary>
+			/// Same as SetEnabled(), for callers already holding an AtomicGuard.
+			/// </summary>
+			/// <param name="enabled">New enabled state.</param>
+			void SetEnabledUnderGuard(const bool enabled)
+			{
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				uint32_t state;
+				do
+				{
+					state = State;
+					if (((state & StateEnabled) != 0) == enabled)
+					{
+						return; // Already in the requested state.
+					}
+
+					if (enabled)
+					{
+						// Published by the swap, while the task is still disabled.
+						LastRun = Platform::GetTimestamp();
+					}
+				} while (!Platform::CompareExchange(State, state, state ^ StateEnabled));
+#else
 				if (enabled && !Enabled)
 				{
 					LastRun = Platform::GetTimestamp();
 				}
 				Enabled = enabled;
+#endif
 			}
 
 			/// <summary>
@@ -179,10 +308,23 @@ namespace Harmonic
 			/// For the purposes of immediately waking up the task, use WakeFromISR() instead.
 			/// Can be called at any time to update both properties dynamically.
 			/// </summary>
-			/// <param name="period">New period in milliseconds.</param>
+			/// <param name="period">New period in time base ticks.</param>
 			/// <param name="enabled">New enabled state.</param>
 			void SetPeriodAndEnabled(const uint32_t period, const bool enabled)
 			{
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				const uint32_t desired = PackState(period, enabled);
+				uint32_t state;
+				do
+				{
+					state = State;
+					if (enabled && (state & StateEnabled) == 0)
+					{
+						// Published by the swap, while the task is still disabled.
+						LastRun = Platform::GetTimestamp();
+					}
+				} while (!Platform::CompareExchange(State, state, desired));
+#else
 				// Atomically update the period and enabled state, updating LastRun if enabling the task.
 				Platform::AtomicGuard guard;
 				if (enabled && !Enabled)
@@ -191,6 +333,19 @@ namespace Harmonic
 				}
 				Period = period;
 				Enabled = enabled;
+#endif
+			}
+
+			/// <summary>
+			/// Restarts the period so the next run is due phase ticks from now, then every period.
+			/// Phases at or above the period restart a full period, as when enabling the task.
+			/// Called from the task's own Run(), the new phase stands: RunIfTime() doesn't advance LastRun past it.
+			/// Not atomic with concurrent enables: callers update LastRun under an AtomicGuard.
+			/// </summary>
+			/// <param name="phase">Delay of the next run in time base ticks, clamped to the period.</param>
+			void SetPhase(const uint32_t phase)
+			{
+				LastRun = Platform::GetTimestamp() - GetPhaseLead(GetPeriod(), phase);
 			}
 
 			/// <summary>
@@ -198,12 +353,24 @@ namespace Harmonic
 			/// </summary>
 			void Wake()
 			{
-#if !defined(ARDUINO_ARCH_AVR) // On AVR without nested interrupts, atomic access is not needed.
+#if !defined(ARDUINO_ARCH_AVR) && !defined(HARMONIC_PLATFORM_ATOMIC_STATE) // On AVR without nested interrupts, or with a packed state, atomic access is not needed.
 				Platform::AtomicGuard guard;
 #endif
+				WakeUnderGuard();
+			}
+
+			/// <summary>
+			/// Same as Wake(), for callers already holding an AtomicGuard.
+			/// </summary>
+			void WakeUnderGuard()
+			{
 				// Set the period to 0 and enabled to true.
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				State = StateEnabled;
+#else
 				Period = 0;
 				Enabled = true;
+#endif
 			}
 
 			/// <summary>
@@ -212,17 +379,23 @@ namespace Harmonic
 			/// <returns>True if the task is enabled, false otherwise.</returns>
 			bool IsEnabled() const
 			{
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				return (State & StateEnabled) != 0;
+#else
 				// On all supported platforms, reading/writing a bool is atomic.
 				return Enabled;
+#endif
 			}
 
 			/// <summary>
-			/// Returns the current period (in milliseconds) for the task.
+			/// Returns the current period (in time base ticks) for the task.
 			/// </summary>
-			/// <returns>The period in milliseconds.</returns>
+			/// <returns>The period in time base ticks.</returns>
 			uint32_t GetPeriod() const
 			{
-#if defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				return State & StatePeriodMask;
+#elif defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
 				// Use atomic protection.
 				uint32_t period;
 				{
@@ -237,22 +410,76 @@ namespace Harmonic
 #endif
 			}
 
+			/// <summary>
+			/// Calculates the earliest timestamp at which the task becomes due, honoring the late bias.
+			/// Tasks already due (including period 0 tasks) return the given timestamp.
+			/// The result is clamped to at most INT32_MAX ahead, so it can be safely ordered with wrapping arithmetic.
+			/// </summary>
+			/// <param name="timestamp">Current timestamp in time base ticks.</param>
+			/// <param name="due">Output: due timestamp in time base ticks.</param>
+			/// <returns>True if the task is enabled, false otherwise.</returns>
+			bool GetDueTimestamp(const uint32_t timestamp, uint32_t& due) const
+			{
+				// Atomically read the enabled state, period and last run.
+				uint32_t period;
+				uint32_t lastRun;
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				{
+					const uint32_t state = Platform::LoadAcquire(State);
+					if ((state & StateEnabled) == 0)
+						return false;
+					period = state & StatePeriodMask;
+					lastRun = LastRun;
+				}
+#else
+				{
+					Platform::AtomicGuard guard;
+					if (!Enabled)
+						return false;
+					period = Period;
+					lastRun = LastRun;
+				}
+#endif
+
+				const uint32_t elapsed = timestamp - lastRun;
+				if (period == 0 || elapsed > period)
+				{
+					due = timestamp;
+				}
+				else
+				{
+					const uint32_t remaining = period - elapsed;
+					due = timestamp + ((remaining < INT32_MAX) ? remaining + 1 : INT32_MAX);
+				}
+
+				return true;
+			}
+
 			/// <summary>
 			/// Calculates the time remaining until the next eligible run.
 			/// Returns UINT32_MAX if the task is disabled.
 			/// </summary>
-			/// <param name="timestamp">Current timestamp in milliseconds.</param>
-			/// <returns>Milliseconds until next run, or UINT32_MAX if disabled.</returns>
+			/// <param name="timestamp">Current timestamp in time base ticks.</param>
+			/// <returns>Ticks until next run, or UINT32_MAX if disabled.</returns>
 			uint32_t TimeUntilNextRun(const uint32_t timestamp) const
 			{
 				// Atomically read the enabled state and period.
 				uint32_t period;
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				{
+					const uint32_t state = Platform::LoadAcquire(State);
+					if ((state & StateEnabled) == 0)
+						return UINT32_MAX;
+					period = state & StatePeriodMask;
+				}
+#else
 				{
 					Platform::AtomicGuard guard;
 					if (!Enabled)
 						return UINT32_MAX;
 					period = Period;
 				}
+#endif
 
 				const uint32_t elapsedSinceLastRun = timestamp - LastRun;
 
@@ -265,6 +492,125 @@ namespace Harmonic
 					return period - elapsedSinceLastRun;
 				}
 			}
+
+		private:
+			/// <summary>
+			/// Shared RunIfTime() implementation, optionally measuring the Run() duration.
+			/// </summary>
+			template<bool MeasureDuration>
+			bool RunIfDue(uint32_t& lateness, uint32_t& start, uint32_t& duration)
+			{
+#if !defined(HARMONIC_SKIP_CHECKS)
+				if (Task == nullptr)
+				{
+					return false;
+				}
+#endif
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+				// Single load of the enabled state and period, ordered before reading LastRun.
+				const uint32_t state = Platform::LoadAcquire(State);
+				if ((state & StateEnabled) == 0)
+				{
+					return false;
+				}
+				const uint32_t period = state & StatePeriodMask;
+#else
+				// On all supported platforms, reading/writing a bool is atomic.
+				if (!Enabled)
+				{
+					return false;
+				}
+
+#if defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
+				// Use atomic protection.
+				uint32_t period;
+				{
+					Platform::AtomicGuard guard;
+					period = Period;
+				}
+#else
+				// 32-bit+ platforms: 32-bit access is atomic
+				const uint32_t period = Period;
+#endif
+#endif
+
+				const uint32_t timestamp = Platform::GetTimestamp();
+				const uint32_t elapsed = timestamp - LastRun;
+
+				// Run the task if the period has elapsed.
+				// Uses unsigned arithmetic for overflow safety.
+				// The > comparison enforces late bias:
+				// the task will only run after the scheduled period has fully elapsed, never early.
+				if (period == 0 || (elapsed > period))
+				{
+					lateness = (period == 0) ? 0 : elapsed - period;
+
+					// LastRun is advanced before Run(), so a period restarted by Run() itself (SetPhase, re-enable) stands.
+					// If the scheduler was delayed and we missed more than one period,
+					// resynchronize LastRun to the current timestamp to avoid multiple rapid catch-up runs.
+					if (period > 1 && ((elapsed >> 1) > period))
+					{
+						// If we missed more than one period (scheduler delayed), resync LastRun to now.
+						LastRun = timestamp;
+#if defined(HARMONIC_OVERLOAD)
+						// Count the dropped periods, only on this slow path.
+						const uint32_t missed = MissCount + (elapsed / period) - 1;
+						MissCount = (missed > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(missed);
+#endif
+					}
+					else
+					{
+						LastRun += period;
+					}
+
+					if (MeasureDuration)
+					{
+						start = Platform::GetProfilerTimestamp();
+						Task->Run();
+						duration = Platform::GetProfilerTimestamp() - start;
+					}
+					else
+					{
+						Task->Run();
+					}
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+					// Runs cost virtual time too, so tasks that are always due don't freeze the simulation.
+					Platform::Host::AdvanceVirtualMicros(HARMONIC_HOST_VIRTUAL_RUN_MICROS);
+#endif
+
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			/// <summary>
+			/// Returns how far back LastRun is set for the first run to be due phase ticks from now.
+			/// </summary>
+			static uint32_t GetPhaseLead(const uint32_t period, const uint32_t phase)
+			{
+				return (phase < period) ? (period - phase) : 0;
+			}
+
+#if defined(HARMONIC_PLATFORM_ATOMIC_STATE)
+			/// <summary>
+			/// Clamps a period to the packed State's period bits.
+			/// </summary>
+			static uint32_t ClampPeriod(const uint32_t period)
+			{
+				return (period < StatePeriodMask) ? period : StatePeriodMask;
+			}
+
+			/// <summary>
+			/// Packs a period and enabled state into a State word.
+			/// </summary>
+			static uint32_t PackState(const uint32_t period, const bool enabled)
+			{
+				return ClampPeriod(period) | (enabled ? StateEnabled : 0);
+			}
+#endif
 		};
 	}
 }
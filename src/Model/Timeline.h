@@ -0,0 +1,180 @@
+#ifndef _HARMONIC_TIMELINE_h
+#define _HARMONIC_TIMELINE_h
+
+#include "../Platform/Platform.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Listener for every task run, with its start time, duration and lateness.
+	/// Requires #define HARMONIC_TIMELINE to be fed by the profiling schedulers.
+	/// Called from the scheduler loop, right after each run.
+	/// </summary>
+	struct ITimelineRecorder
+	{
+		/// <summary>
+		/// Called after a task ran.
+		/// </summary>
+		/// <param name="taskId">ID of the task that ran.</param>
+		/// <param name="start">Profiler timestamp right before Run().</param>
+		/// <param name="duration">Run() duration in profiler ticks.</param>
+		/// <param name="lateness">Start lateness in time base ticks, 0 for period 0.</param>
+		virtual void OnTaskRun(const task_id_t taskId, const uint32_t start, const uint32_t duration, const uint32_t lateness) = 0;
+	};
+
+	namespace Timeline
+	{
+		/// <summary>
+		/// Compact record of one task run.
+		/// Start times are stored as the delta to the previous recorded run, so a window can span
+		/// any number of profiler timestamp wrap-arounds, as long as no gap between runs exceeds one.
+		/// </summary>
+		struct RunEvent
+		{
+			/// <summary>
+			/// Profiler ticks since the previous recorded run started.
+			/// </summary>
+			uint32_t StartDelta;
+
+			/// <summary>
+			/// Run() duration in profiler ticks.
+			/// </summary>
+			uint32_t Duration;
+
+			/// <summary>
+			/// Start lateness in time base ticks.
+			/// </summary>
+			uint32_t Lateness;
+
+			task_id_t TaskId;
+		};
+	}
+
+	/// <summary>
+	/// Ring buffer of the latest task runs, over an external event array.
+	///
+	/// - Records continuously, overwriting the oldest run when full, so the buffer always holds the latest window.
+	/// - Freeze() stops recording so a window can be read out without it moving, Resume() clears it and records again.
+	/// - Written and read from the scheduler loop only, no atomics needed.
+	///
+	/// Use TemplateTimelineRecorder for a recorder that owns its storage.
+	/// </summary>
+	class TimelineRecorder : public ITimelineRecorder
+	{
+	private:
+		Timeline::RunEvent* Events;
+
+	public:
+		/// <summary>
+		/// Maximum number of runs kept.
+		/// </summary>
+		const uint16_t Capacity;
+
+	private:
+		/// <summary>
+		/// Profiler timestamp of the last recorded run, to delta encode the next one.
+		/// </summary>
+		uint32_t LastStart = 0;
+
+		/// <summary>
+		/// Index of the next event to write.
+		/// </summary>
+		uint16_t Head = 0;
+		uint16_t Count = 0;
+
+		bool Frozen = false;
+
+	public:
+		TimelineRecorder(Timeline::RunEvent* events, const uint16_t capacity)
+			: ITimelineRecorder()
+			, Events(events)
+			, Capacity(capacity)
+		{
+		}
+
+		void OnTaskRun(const task_id_t taskId, const uint32_t start, const uint32_t duration, const uint32_t lateness) final
+		{
+			if (Frozen || Capacity == 0)
+			{
+				return;
+			}
+
+			Timeline::RunEvent& event = Events[Head];
+			event.StartDelta = start - LastStart;
+			event.Duration = duration;
+			event.Lateness = lateness;
+			event.TaskId = taskId;
+			LastStart = start;
+
+			Head = ((Head + 1) < Capacity) ? (Head + 1) : 0;
+			if (Count < Capacity)
+			{
+				Count++;
+			}
+		}
+
+		/// <summary>
+		/// Stops recording, keeping the current window.
+		/// </summary>
+		void Freeze()
+		{
+			Frozen = true;
+		}
+
+		/// <summary>
+		/// Discards the current window and resumes recording.
+		/// </summary>
+		void Resume()
+		{
+			Count = 0;
+			Frozen = false;
+		}
+
+		bool IsFrozen() const
+		{
+			return Frozen;
+		}
+
+		/// <summary>
+		/// Returns the number of runs in the current window.
+		/// </summary>
+		uint16_t GetCount() const
+		{
+			return Count;
+		}
+
+		/// <summary>
+		/// Returns a recorded run, oldest first.
+		/// The oldest run's StartDelta refers to a run no longer in the window.
+		/// </summary>
+		/// <param name="index">Run index in the window, below GetCount().</param>
+		const Timeline::RunEvent& GetEvent(const uint16_t index) const
+		{
+			const uint16_t first = (Head >= Count) ? (Head - Count) : (Head + Capacity - Count);
+			const uint16_t offset = first + index;
+
+			return Events[(offset < Capacity) ? offset : offset - Capacity];
+		}
+	};
+
+	/// <summary>
+	/// TimelineRecorder with its own storage.
+	/// RAM: EventCapacity x sizeof(Timeline::RunEvent), 16 bytes on 32-bit targets, 13 on AVR.
+	/// </summary>
+	/// <typeparam name="EventCapacity">Maximum number of runs kept.</typeparam>
+	template<uint16_t EventCapacity>
+	class TemplateTimelineRecorder : public TimelineRecorder
+	{
+	private:
+		static_assert(EventCapacity > 0, "EventCapacity must be at least 1.");
+
+		Timeline::RunEvent EventList[EventCapacity]{};
+
+	public:
+		TemplateTimelineRecorder()
+			: TimelineRecorder(EventList, EventCapacity)
+		{
+		}
+	};
+}
+#endif
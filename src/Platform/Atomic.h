@@ -3,6 +3,20 @@
 
 #include "Platform.h"
 
+#if defined(HARMONIC_PLATFORM_HOST)
+#include <atomic>
+#include <thread>
+#endif
+
+#if defined(HARMONIC_PLATFORM_OS) && !defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
+// 32-bit OS platforms: task state is packed in a single word, read without a critical section.
+#define HARMONIC_PLATFORM_ATOMIC_STATE
+#if defined(__GCC_ATOMIC_INT_LOCK_FREE) && (__GCC_ATOMIC_INT_LOCK_FREE == 2)
+// Native compare-and-swap (e.g. LDREX/STREX, S32C1I): read-modify-write without a critical section.
+#define HARMONIC_PLATFORM_ATOMIC_CAS
+#endif
+#endif
+
 namespace Harmonic
 {
 	namespace Platform
@@ -20,6 +34,9 @@ namespace Harmonic
 		///   - AVR: Saves SREG and disables interrupts with cli(); restores SREG on destruction.
 		///   - STM32/SAMD: Disables interrupts with noInterrupts(); restores with interrupts().
 		///   - FreeRTOS/RTOS: Uses taskENTER_CRITICAL()/taskEXIT_CRITICAL() for thread safety.
+		///   - FreeRTOS/RTOS with HARMONIC_MULTI_CORE: Masks interrupts on the current core only,
+		///     for per-core schedulers whose state is only accessed from their own core (see MultiCoreScheduler).
+		///   - Host (Linux/Windows/macOS): Takes a process-wide std::atomic_flag spinlock, nestable within a thread.
 		///
 		/// Example:
 		///   {
@@ -92,6 +109,24 @@ namespace Harmonic
 			AtomicGuard(const AtomicGuard&) = delete;
 			AtomicGuard& operator=(const AtomicGuard&) = delete;
 		};
+#elif (defined(HARMONIC_PLATFORM_OS) || defined(FreeRTOS_h)) && defined(HARMONIC_MULTI_CORE)
+		class AtomicGuard
+		{
+			UBaseType_t mask_;
+		public:
+			/// <summary>
+			/// Masks interrupts on the current core only, saving the previous mask.
+			/// The other core keeps running: its scheduler state is never touched from this core.
+			/// </summary>
+			AtomicGuard() { mask_ = portSET_INTERRUPT_MASK_FROM_ISR(); }
+
+			/// <summary>
+			/// Restores the previous interrupt mask of the current core.
+			/// </summary>
+			~AtomicGuard() { portCLEAR_INTERRUPT_MASK_FROM_ISR(mask_); }
+			AtomicGuard(const AtomicGuard&) = delete;
+			AtomicGuard& operator=(const AtomicGuard&) = delete;
+		};
 #elif defined(HARMONIC_PLATFORM_OS) || defined(FreeRTOS_h)
 		class AtomicGuard 
 		{
@@ -108,9 +143,140 @@ namespace Harmonic
 			AtomicGuard(const AtomicGuard&) = delete;
 			AtomicGuard& operator=(const AtomicGuard&) = delete;
 		};
+#elif defined(HARMONIC_PLATFORM_HOST)
+		class AtomicGuard
+		{
+		private:
+			/// <summary>
+			/// Process-wide lock, standing in for the interrupt mask. Threads simulating ISRs take it too.
+			/// </summary>
+			static std::atomic_flag& GetLock()
+			{
+				static std::atomic_flag lock = ATOMIC_FLAG_INIT;
+
+				return lock;
+			}
+
+			/// <summary>
+			/// Guard nesting depth of the calling thread, like nested interrupt masking restoring the saved state.
+			/// </summary>
+			static uint32_t& GetDepth()
+			{
+				static thread_local uint32_t depth = 0;
+
+				return depth;
+			}
+
+		public:
+			/// <summary>
+			/// Spins until the process-wide lock is taken, unless the calling thread already holds it.
+			/// </summary>
+			AtomicGuard()
+			{
+				if (GetDepth()++ == 0)
+				{
+					while (GetLock().test_and_set(std::memory_order_acquire))
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+
+			/// <summary>
+			/// Releases the lock when the outermost guard of the thread ends.
+			/// </summary>
+			~AtomicGuard()
+			{
+				if (--GetDepth() == 0)
+				{
+					GetLock().clear(std::memory_order_release);
+				}
+			}
+			AtomicGuard(const AtomicGuard&) = delete;
+			AtomicGuard& operator=(const AtomicGuard&) = delete;
+		};
 #else
 #error "No atomic guard defined for this platform"
 #endif
+
+		/// <summary>
+		/// Atomically replaces a value if it still holds the expected one.
+		/// Lock-free with HARMONIC_PLATFORM_ATOMIC_CAS, falls back to an AtomicGuard otherwise.
+		/// Full memory barrier on success.
+		/// </summary>
+		/// <param name="value">Shared value.</param>
+		/// <param name="expected">Value last read.</param>
+		/// <param name="desired">Value to store.</param>
+		/// <returns>True if the value was replaced, false if it changed since it was read.</returns>
+		template<typename T>
+		inline bool CompareExchange(volatile T& value, T expected, const T desired)
+		{
+#if defined(HARMONIC_PLATFORM_ATOMIC_CAS)
+			return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#else
+			AtomicGuard guard;
+			if (value != expected)
+			{
+				return false;
+			}
+			value = desired;
+
+			return true;
+#endif
+		}
+
+		/// <summary>
+		/// Atomically replaces a value, returning the previous one.
+		/// Lock-free with HARMONIC_PLATFORM_ATOMIC_CAS, falls back to an AtomicGuard otherwise.
+		/// </summary>
+		/// <param name="value">Shared value.</param>
+		/// <param name="desired">Value to store.</param>
+		/// <returns>The previous value.</returns>
+		template<typename T>
+		inline T Exchange(volatile T& value, const T desired)
+		{
+#if defined(HARMONIC_PLATFORM_ATOMIC_CAS)
+			return __atomic_exchange_n(&value, desired, __ATOMIC_SEQ_CST);
+#else
+			AtomicGuard guard;
+			const T previous = value;
+			value = desired;
+
+			return previous;
+#endif
+		}
+
+		/// <summary>
+		/// Reads a word written by other contexts, ordered before the reads that follow it.
+		/// For values that are atomic to read on the platform.
+		/// </summary>
+		/// <param name="value">Shared value.</param>
+		template<typename T>
+		inline T LoadAcquire(const volatile T& value)
+		{
+#if defined(HARMONIC_PLATFORM_ATOMIC_CAS)
+			return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+#else
+			const T loaded = value;
+			asm volatile("" ::: "memory");
+
+			return loaded;
+#endif
+		}
+
+		/// <summary>
+		/// Full memory barrier, for lock-free data shared with ISRs.
+		/// Memory accesses are not reordered across it, by the compiler or the CPU.
+		/// Single core AVR only needs a compiler barrier.
+		/// </summary>
+		inline void MemoryBarrier()
+		{
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_MEGAAVR)
+			asm volatile("" ::: "memory");
+#else
+			__sync_synchronize();
+#endif
+		}
 	}
 }
 #endif
\ No newline at end of file
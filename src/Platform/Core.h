@@ -0,0 +1,41 @@
+#ifndef _HARMONIC_PLATFORM_CORE_h
+#define _HARMONIC_PLATFORM_CORE_h
+
+#include "Platform.h"
+
+#if defined(ARDUINO_ARCH_RP2040) || defined(PICO_RP2350)
+#include <hardware/sync.h>
+#endif
+
+namespace Harmonic
+{
+	namespace Platform
+	{
+		/// <summary>
+		/// Number of cores available to schedulers on this platform.
+		/// </summary>
+#if defined(ARDUINO_ARCH_RP2040) || defined(PICO_RP2350)
+		static constexpr uint8_t CORE_COUNT = 2;
+#elif defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_FREERTOS_UNICORE)
+		static constexpr uint8_t CORE_COUNT = 2;
+#else
+		static constexpr uint8_t CORE_COUNT = 1;
+#endif
+
+		/// <summary>
+		/// Returns the index of the core running the caller, 0 on single core platforms.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		inline uint8_t GetCoreId()
+		{
+#if defined(ARDUINO_ARCH_RP2040) || defined(PICO_RP2350)
+			return static_cast<uint8_t>(get_core_num());
+#elif defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_FREERTOS_UNICORE)
+			return static_cast<uint8_t>(xPortGetCoreID());
+#else
+			return 0;
+#endif
+		}
+	}
+}
+#endif
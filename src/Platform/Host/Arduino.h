@@ -0,0 +1,224 @@
+#ifndef _HARMONIC_HOST_ARDUINO_h
+#define _HARMONIC_HOST_ARDUINO_h
+
+/// <summary>
+/// Minimal Arduino API for host builds (Linux/Windows/macOS), so sketches and the behavior tests run on a PC.
+/// Add src/Platform/Host to the include path, and the sketch's <Arduino.h> resolves here.
+///
+/// - millis(), micros(), delay() and delayMicroseconds() run on the host clock, virtual with HARMONIC_HOST_VIRTUAL_TIME.
+///   With virtual time, busy waits on micros() advance it by 1 us per read.
+/// - Serial writes to stdout. Pins are kept in memory, writing a pin calls its attached interrupt on change.
+/// - #define HARMONIC_HOST_MAIN in one translation unit for a main() that calls setup(), then loop() for
+///   the number of seconds given as first argument (forever if none).
+/// </summary>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Print.h"
+#include "../HostClock.h"
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define LED_BUILTIN 13
+
+#define HOST_PIN_COUNT 64
+#define digitalPinToInterrupt(pin) (pin)
+
+/// <summary>
+/// Reads the host clock for the Arduino API. With virtual time, each read costs 1 us, so busy waits on micros() end.
+/// </summary>
+inline uint64_t HostReadMicros()
+{
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+	return Harmonic::Platform::Host::GetVirtualClock().fetch_add(1);
+#else
+	return Harmonic::Platform::Host::GetMicros();
+#endif
+}
+
+inline uint32_t micros()
+{
+	return static_cast<uint32_t>(HostReadMicros());
+}
+
+inline uint32_t millis()
+{
+	return static_cast<uint32_t>(HostReadMicros() / 1000);
+}
+
+inline void delay(const uint32_t ms)
+{
+	Harmonic::Platform::Host::Wait(uint64_t(ms) * 1000);
+}
+
+/// <summary>
+/// Busy waits, like on a device, so it stands in for CPU work in profiling. Advances virtual time instead, if enabled.
+/// </summary>
+inline void delayMicroseconds(const uint32_t us)
+{
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+	Harmonic::Platform::Host::AdvanceVirtualMicros(us);
+#else
+	const uint64_t start = Harmonic::Platform::Host::GetWallMicros();
+	while ((Harmonic::Platform::Host::GetWallMicros() - start) < us)
+	{
+	}
+#endif
+}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+inline long random(const long max)
+{
+	return (max > 0) ? (rand() % max) : 0;
+}
+
+inline long random(const long min, const long max)
+{
+	return min + random(max - min);
+}
+
+namespace Harmonic
+{
+	namespace Platform
+	{
+		namespace Host
+		{
+			/// <summary>
+			/// In-memory pin levels and attached interrupts.
+			/// </summary>
+			struct PinState
+			{
+				void (*Interrupts[HOST_PIN_COUNT])() {};
+				uint8_t Modes[HOST_PIN_COUNT]{};
+				uint8_t Levels[HOST_PIN_COUNT]{};
+			};
+
+			inline PinState& GetPins()
+			{
+				static PinState pins{};
+
+				return pins;
+			}
+		}
+	}
+}
+
+inline void pinMode(const uint8_t pin, const uint8_t mode)
+{
+	if (pin < HOST_PIN_COUNT)
+	{
+		Harmonic::Platform::Host::GetPins().Modes[pin] = mode;
+		if (mode == INPUT_PULLUP)
+		{
+			Harmonic::Platform::Host::GetPins().Levels[pin] = HIGH;
+		}
+	}
+}
+
+inline int digitalRead(const uint8_t pin)
+{
+	return (pin < HOST_PIN_COUNT) ? Harmonic::Platform::Host::GetPins().Levels[pin] : LOW;
+}
+
+/// <summary>
+/// Sets a pin level, calling its attached interrupt on change. Drives input pins too, to simulate external signals.
+/// </summary>
+inline void digitalWrite(const uint8_t pin, const uint8_t level)
+{
+	if (pin < HOST_PIN_COUNT)
+	{
+		Harmonic::Platform::Host::PinState& pins = Harmonic::Platform::Host::GetPins();
+		const uint8_t value = (level != LOW) ? HIGH : LOW;
+		if (pins.Levels[pin] != value)
+		{
+			pins.Levels[pin] = value;
+			if (pins.Interrupts[pin] != nullptr)
+			{
+				pins.Interrupts[pin]();
+			}
+		}
+	}
+}
+
+inline void attachInterrupt(const uint8_t interrupt, void (*callback)(), const int /*mode*/)
+{
+	if (interrupt < HOST_PIN_COUNT)
+	{
+		Harmonic::Platform::Host::GetPins().Interrupts[interrupt] = callback;
+	}
+}
+
+inline void detachInterrupt(const uint8_t interrupt)
+{
+	if (interrupt < HOST_PIN_COUNT)
+	{
+		Harmonic::Platform::Host::GetPins().Interrupts[interrupt] = nullptr;
+	}
+}
+
+/// <summary>
+/// Serial port on stdout.
+/// </summary>
+class HostSerial : public Stream
+{
+public:
+	void begin(const unsigned long /*baudRate*/) {}
+
+	size_t write(const uint8_t value) final
+	{
+		return (putchar(value) == EOF) ? 0 : 1;
+	}
+
+	using Print::write;
+
+	int availableForWrite() final
+	{
+		return 64;
+	}
+
+	void flush() final
+	{
+		fflush(stdout);
+	}
+
+	operator bool() const
+	{
+		return true;
+	}
+};
+
+static HostSerial Serial;
+
+#if defined(HARMONIC_HOST_MAIN)
+void setup();
+void loop();
+
+int main(int argc, char** argv)
+{
+	setvbuf(stdout, nullptr, _IONBF, 0);
+	const uint64_t seconds = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 0;
+
+	setup();
+	const uint64_t start = Harmonic::Platform::Host::GetMicros();
+	while (seconds == 0 || (Harmonic::Platform::Host::GetMicros() - start) < (seconds * 1000000))
+	{
+		loop();
+	}
+
+	return 0;
+}
+#endif
+#endif
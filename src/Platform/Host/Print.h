@@ -0,0 +1,165 @@
+#ifndef _HARMONIC_HOST_PRINT_h
+#define _HARMONIC_HOST_PRINT_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// <summary>
+/// Host stand-in for the Arduino Print/Stream classes, as used by the Harmonic trace and export tasks and the examples.
+/// Only the formatting subset the library needs: strings, integers in any base, and fixed decimal floats.
+/// </summary>
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+#define PSTR(string_literal) (string_literal)
+#define PROGMEM
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print
+{
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t value) = 0;
+
+	virtual size_t write(const uint8_t* buffer, size_t size)
+	{
+		size_t count = 0;
+		while (size--)
+		{
+			count += write(*buffer++);
+		}
+
+		return count;
+	}
+
+	size_t write(const char* text)
+	{
+		return print(text);
+	}
+
+	virtual int availableForWrite()
+	{
+		return 0;
+	}
+
+	virtual void flush() {}
+
+	size_t print(const char* text)
+	{
+		size_t count = 0;
+		while (*text)
+		{
+			count += write(static_cast<uint8_t>(*text++));
+		}
+
+		return count;
+	}
+
+	size_t print(const __FlashStringHelper* text)
+	{
+		return print(reinterpret_cast<const char*>(text));
+	}
+
+	size_t print(const char value)
+	{
+		return write(static_cast<uint8_t>(value));
+	}
+
+	size_t print(const unsigned char value, const int base = DEC) { return PrintNumber(value, false, base); }
+	size_t print(const int value, const int base = DEC) { return PrintSigned(value, base); }
+	size_t print(const unsigned int value, const int base = DEC) { return PrintNumber(value, false, base); }
+	size_t print(const long value, const int base = DEC) { return PrintSigned(value, base); }
+	size_t print(const unsigned long value, const int base = DEC) { return PrintNumber(value, false, base); }
+	size_t print(const long long value, const int base = DEC) { return PrintSigned(value, base); }
+	size_t print(const unsigned long long value, const int base = DEC) { return PrintNumber(value, false, base); }
+
+	size_t print(const double value, const int digits = 2)
+	{
+		char buffer[48];
+		snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+
+		return print(buffer);
+	}
+
+	size_t println()
+	{
+		return print("\r\n");
+	}
+
+	template<typename T>
+	size_t println(const T value)
+	{
+		const size_t count = print(value);
+
+		return count + println();
+	}
+
+	template<typename T>
+	size_t println(const T value, const int format)
+	{
+		const size_t count = print(value, format);
+
+		return count + println();
+	}
+
+private:
+	size_t PrintSigned(const long long value, const int base)
+	{
+		if (base == DEC && value < 0)
+		{
+			return PrintNumber(0ULL - static_cast<unsigned long long>(value), true, base);
+		}
+
+		return PrintNumber(static_cast<unsigned long long>(value), false, base);
+	}
+
+	size_t PrintNumber(unsigned long long value, const bool negative, int base)
+	{
+		if (base < 2)
+		{
+			base = DEC;
+		}
+
+		char buffer[8 * sizeof(long long) + 2];
+		char* digit = &buffer[sizeof(buffer) - 1];
+		*digit = '\0';
+		do
+		{
+			const char remainder = static_cast<char>(value % base);
+			*--digit = (remainder < 10) ? (remainder + '0') : (remainder + 'A' - 10);
+			value /= base;
+		} while (value != 0);
+
+		if (negative)
+		{
+			*--digit = '-';
+		}
+
+		return print(digit);
+	}
+};
+
+class Stream : public Print
+{
+public:
+	virtual int available()
+	{
+		return 0;
+	}
+
+	virtual int read()
+	{
+		return -1;
+	}
+
+	virtual int peek()
+	{
+		return -1;
+	}
+};
+#endif
@@ -0,0 +1,93 @@
+#ifndef _HARMONIC_PLATFORM_HOST_CLOCK_h
+#define _HARMONIC_PLATFORM_HOST_CLOCK_h
+
+#include "Platform.h"
+
+#if defined(HARMONIC_PLATFORM_HOST)
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined(HARMONIC_HOST_VIRTUAL_TIME) && !defined(HARMONIC_HOST_VIRTUAL_RUN_MICROS)
+/// <summary>
+/// Virtual time charged per task run, in microseconds.
+/// </summary>
+#define HARMONIC_HOST_VIRTUAL_RUN_MICROS 10
+#endif
+
+namespace Harmonic
+{
+	namespace Platform
+	{
+		/// <summary>
+		/// Host (Linux/Windows/macOS) clock, backing the time base, the profiler and the host Arduino API.
+		///
+		/// - Default: std::chrono::steady_clock, in microseconds since the first read.
+		/// - #define HARMONIC_HOST_VIRTUAL_TIME: virtual clock, only moved by AdvanceVirtualMicros(),
+		///   AbstractScheduler::AdvanceTimestamp() and the host delay(). Idle sleep skips straight to the next due task,
+		///   so simulations run as fast as the CPU allows, and are repeatable. The profiler stays on the steady clock.
+		///   Each task run costs HARMONIC_HOST_VIRTUAL_RUN_MICROS of virtual time.
+		/// </summary>
+		namespace Host
+		{
+			/// <summary>
+			/// Returns the steady clock time in microseconds, since the first call.
+			/// </summary>
+			inline uint64_t GetWallMicros()
+			{
+				static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+			}
+
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+			/// <summary>
+			/// Virtual time in microseconds, shared by all threads.
+			/// </summary>
+			inline std::atomic<uint64_t>& GetVirtualClock()
+			{
+				static std::atomic<uint64_t> clock(0);
+
+				return clock;
+			}
+
+			/// <summary>
+			/// Moves virtual time forward.
+			/// Safe to call from any thread.
+			/// </summary>
+			/// <param name="micros">Duration in microseconds.</param>
+			inline void AdvanceVirtualMicros(const uint64_t micros)
+			{
+				GetVirtualClock().fetch_add(micros);
+			}
+#endif
+
+			/// <summary>
+			/// Returns the host time in microseconds: virtual with HARMONIC_HOST_VIRTUAL_TIME, steady clock otherwise.
+			/// </summary>
+			inline uint64_t GetMicros()
+			{
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+				return GetVirtualClock().load();
+#else
+				return GetWallMicros();
+#endif
+			}
+
+			/// <summary>
+			/// Waits for a duration: advances virtual time with HARMONIC_HOST_VIRTUAL_TIME, sleeps the thread otherwise.
+			/// </summary>
+			/// <param name="micros">Duration in microseconds.</param>
+			inline void Wait(const uint64_t micros)
+			{
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+				AdvanceVirtualMicros(micros);
+#else
+				std::this_thread::sleep_for(std::chrono::microseconds(micros));
+#endif
+			}
+		}
+	}
+}
+#endif
+#endif
@@ -2,6 +2,7 @@
 #define _HARMONIC_PLATFORM_IDLE_SLEEP_h
 
 #include "Platform.h"
+#include "Timestamp.h"
 
 #if defined(ARDUINO_ARCH_RP2040) || defined(PICO_RP2350)
 #include <FreeRTOS.h>
@@ -17,69 +18,42 @@
 #include <avr/power.h>
 #include <avr/sleep.h>
 #include <util/atomic.h>
-#elif defined(WINDOWS)
-#include <thread>
+#elif defined(HARMONIC_PLATFORM_HOST)
+#include "HostClock.h"
 #endif
 
-namespace Harmonic
-{
-#if defined(WINDOWS)
-	using SemaphoreHandle_t = struct
-	{
-		std::mutex mtx;
-		std::condition_variable cv;
-		bool signaled = false;
-	};
-
-	SemaphoreHandle_t* xSemaphoreCreateBinary()
-	{
-		return new SemaphoreHandle_t();
-	}
-
-	void vSemaphoreDelete(SemaphoreHandle_t* sem)
-	{
-		delete sem;
-	}
-
-	bool xSemaphoreTake(SemaphoreHandle_t* sem, uint32_t timeout_ms)
-	{
-		std::unique_lock<std::mutex> lock(sem->mtx);
-		if (!sem->signaled) {
-			if (timeout_ms == 0) {
-				sem->cv.wait(lock, [&] { return sem->signaled; });
-			}
-			else {
-				if (!sem->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] { return sem->signaled; }))
-					return false;
-			}
-		}
-		sem->signaled = false;
-		return true;
-	}
-
-	void xSemaphoreGiveFromISR(SemaphoreHandle_t* sem, int* /*xHigherPriorityTaskWoken*/)
-	{
-		{
-			std::lock_guard<std::mutex> lock(sem->mtx);
-			sem->signaled = true;
-		}
-		sem->cv.notify_one();
-	}
-
-	uint32_t pdMS_TO_TICKS(uint32_t ms) { return ms; }
-	static constexpr int pdFALSE = 0;
-	void portYIELD_FROM_ISR(int) {}
+#if defined(HARMONIC_RTOS_NOTIFY) && !defined(HARMONIC_PLATFORM_OS)
+#error HARMONIC_RTOS_NOTIFY requires a FreeRTOS platform.
 #endif
 
+namespace Harmonic
+{
 	/// <summary>
 	/// Platform specific implementations for timestamp source and idle sleep.
 	/// </summary>
 	namespace Platform
 	{
+#if !defined(HARMONIC_IDLE_WAKE_MICROS) && defined(HARMONIC_PLATFORM_HOST)
+		// Host idle sleep wakes on 1 ms boundaries.
+#define HARMONIC_IDLE_WAKE_MICROS 1000
+#elif !defined(HARMONIC_IDLE_WAKE_MICROS)
+		/// <summary>
+		/// Worst-case interval between system tick interrupts, which wake the device from idle sleep.
+		/// Defaults to the AVR timer0 overflow period, which is longer than a 1 ms ARM systick.
+		/// Only used with sub-millisecond time bases.
+		/// </summary>
+#define HARMONIC_IDLE_WAKE_MICROS 1024
+#endif
+
+		/// <summary>
+		/// Idle sleep can overshoot by up to one system tick, so it's only allowed when the next task is due later than this.
+		/// </summary>
+		static constexpr uint32_t IDLE_WAKE_TICKS = MicrosToTicks(HARMONIC_IDLE_WAKE_MICROS);
+
 		/// <summary>
 		/// Sleep device until the next millisecond tick.
 		/// </summary>
-		static void IdleSleep()
+		inline void IdleSleep()
 		{
 #if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_MEGAAVR)
 			// No RTOS, sleep until next interrupt. (most likely timer0/millis).
@@ -90,6 +64,9 @@ namespace Harmonic
 #elif defined(ARDUINO_ARCH_STM32F1) || defined(ARDUINO_ARCH_STM32F4) || defined(CORE_TEENSY)
 			// No RTOS, sleep until next interrupt. (most likely ARM systick).
 			asm("wfi");
+#elif defined(HARMONIC_PLATFORM_HOST)
+			// No interrupts to wake on, sleep until the next tick boundary of the host clock.
+			std::this_thread::sleep_for(std::chrono::microseconds(HARMONIC_IDLE_WAKE_MICROS - (Host::GetWallMicros() % HARMONIC_IDLE_WAKE_MICROS)));
 #endif
 		}
 
@@ -104,13 +81,18 @@ namespace Harmonic
 		/// Reference to a binary semaphore used for waking the thread from an ISR.
 		/// </param>
 		/// <param name="sleepDuration">
-		/// Desired sleep duration in milliseconds.
+		/// Desired sleep duration in milliseconds, UINT32_MAX to block until the semaphore is given.
 		/// </param>
 		void IdleSleep(SemaphoreHandle_t& semaphore, const uint32_t sleepDuration)
 		{
 			static constexpr uint32_t tickPeriod = (1000 / configTICK_RATE_HZ);
 
-			if (sleepDuration >= tickPeriod)
+			if (sleepDuration == UINT32_MAX)
+			{
+				// Nothing scheduled: block until the semaphore is given from an ISR.
+				xSemaphoreTake(semaphore, portMAX_DELAY);
+			}
+			else if (sleepDuration >= tickPeriod)
 			{
 				// Block the thread until either:
 				// 1. The semaphore is given from an ISR (interrupt), or
@@ -119,6 +101,35 @@ namespace Harmonic
 				xSemaphoreTake(semaphore, pdMS_TO_TICKS(sleepDuration - tickPeriod));
 			}
 		}
+
+#if defined(HARMONIC_RTOS_NOTIFY)
+		/// <summary>
+		/// Blocks the current RTOS thread on its direct-to-task notification, until either the specified duration elapses
+		/// or the registry notifies it, whichever comes first.
+		/// Like the semaphore IdleSleep(), the timeout is reduced by one tick to wake up on time or slightly early, never late.
+		/// </summary>
+		/// <param name="sleepDuration">
+		/// Desired sleep duration in milliseconds, UINT32_MAX to block until notified.
+		/// </param>
+		/// <returns>Notification bits received (bit N for task ID N % 32), 0 on timeout.</returns>
+		static uint32_t IdleWait(const uint32_t sleepDuration)
+		{
+			static constexpr uint32_t tickPeriod = (1000 / configTICK_RATE_HZ);
+
+			uint32_t notification = 0;
+			if (sleepDuration == UINT32_MAX)
+			{
+				// Nothing scheduled: block until a task is attached or woken.
+				xTaskNotifyWait(0, UINT32_MAX, &notification, portMAX_DELAY);
+			}
+			else if (sleepDuration >= tickPeriod)
+			{
+				xTaskNotifyWait(0, UINT32_MAX, &notification, pdMS_TO_TICKS(sleepDuration - tickPeriod));
+			}
+
+			return notification;
+		}
+#endif
 #endif
 	}
 }
@@ -2,6 +2,7 @@
 #define _HARMONIC_PLATFORM_h
 
 #include <stdint.h>
+#include <stddef.h>
 
 namespace Harmonic
 {
@@ -14,8 +15,11 @@ namespace Harmonic
 #define HARMONIC_PLATFORM_OS
 #elif defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
 #define HARMONIC_PLATFORM_OS
-#elif defined(WINDOWS)
-#define HARMONIC_PLATFORM_OS
+#elif defined(HARMONIC_PLATFORM_HOST) || defined(WINDOWS) || defined(_WIN32) || defined(__linux__) || defined(__APPLE__)
+// Host build (Linux/Windows/macOS), for simulation and profiling on a PC. GCC or Clang, C++11.
+#if !defined(HARMONIC_PLATFORM_HOST)
+#define HARMONIC_PLATFORM_HOST
+#endif
 #else
 #error Harmonic::Platform not supported
 #endif
@@ -28,10 +32,20 @@ namespace Harmonic
 
 	/// <summary>
 	/// TaskId type and count type.
+	/// #define HARMONIC_WIDE_TASK_ID - set flag for 16-bit task IDs, raising TASK_MAX_COUNT from 254 to 65534.
+	/// Costs one extra byte per task ID stored: slot map, deadline queue, trace snapshots.
+	/// Pair large registries with HARMONIC_ENABLED_MASK or DispatchPolicyEnum::Deadline, so idle tasks aren't scanned every pass.
 	/// </summary>
+#if defined(HARMONIC_WIDE_TASK_ID)
+	typedef uint16_t task_id_t;
+
+	static constexpr task_id_t TASK_INVALID_ID = UINT16_MAX;
+	static constexpr size_t TASK_MAX_COUNT = UINT16_MAX - 1;
+#else
 	typedef uint_fast8_t task_id_t;
 
 	static constexpr task_id_t TASK_INVALID_ID = UINT8_MAX;
 	static constexpr size_t TASK_MAX_COUNT = UINT8_MAX - 1;
+#endif
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef _HARMONIC_PLATFORM_TICKLESS_TIMER_h
+#define _HARMONIC_PLATFORM_TICKLESS_TIMER_h
+
+#include "Platform.h"
+#include "Timestamp.h"
+
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#endif
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Platform specific implementations for timestamp source and idle sleep.
+	/// </summary>
+	namespace Platform
+	{
+		/// <summary>
+		/// Interface for a tickless idle wakeup source on bare-metal platforms.
+		///
+		/// Instead of waking on every system tick, the scheduler hands the time until the next task to Sleep(),
+		/// which programs a wakeup alarm (compare/RTC/watchdog) and enters a deeper sleep mode, where the timestamp source stops.
+		/// The returned sleep time is then credited to the scheduler clock through AdvanceTimestamp().
+		///
+		/// Implementations must only sleep up to the requested duration, and must not fall asleep if wake is set,
+		/// checking it with interrupts disabled right before sleeping.
+		/// </summary>
+		struct ITicklessTimer
+		{
+			/// <summary>
+			/// Returns the shortest duration worth a deep sleep, in time base ticks.
+			/// Shorter waits fall back to the regular idle sleep.
+			/// </summary>
+			virtual uint32_t GetMinimumSleep() const = 0;
+
+			/// <summary>
+			/// Sleeps for up to the given duration, or until woken by an interrupt.
+			/// </summary>
+			/// <param name="duration">Maximum sleep duration in time base ticks.</param>
+			/// <param name="wake">Wake flag, set by ISRs that changed a task's schedule.</param>
+			/// <returns>Time slept that the timestamp source missed, in time base ticks.</returns>
+			virtual uint32_t Sleep(const uint32_t duration, const volatile bool& wake) = 0;
+		};
+
+#if defined(ARDUINO_ARCH_AVR)
+		/// <summary>
+		/// AVR tickless timer, using the watchdog interrupt to wake from power-down sleep.
+		///
+		/// Sleeps for the longest watchdog period (16 ms to 8 s) that fits the requested duration.
+		/// Timer0 stops in power-down, so millis() and micros() don't advance while asleep.
+		/// Accuracy follows the watchdog oscillator (typically within 10%), so long sleeps may drift.
+		/// If another interrupt wakes the device first, the partial sleep can't be measured and 0 is returned:
+		/// the clock then lags by up to one watchdog period, and tasks run late, never early.
+		///
+		/// The application must forward the watchdog interrupt:
+		///   ISR(WDT_vect) { TicklessTimer.OnInterrupt(); }
+		/// </summary>
+		class AvrWatchdogTicklessTimer final : public ITicklessTimer
+		{
+		private:
+			/// <summary>
+			/// Shortest watchdog period in milliseconds. Each prescaler step doubles it.
+			/// </summary>
+			static constexpr uint32_t WatchdogMinimumMillis = 16;
+
+			/// <summary>
+			/// Highest watchdog prescaler (8 s).
+			/// </summary>
+			static constexpr uint8_t WatchdogMaxPrescaler = 9;
+
+			/// <summary>
+			/// Set by the watchdog interrupt.
+			/// </summary>
+			volatile bool WatchdogFired = false;
+
+		public:
+			uint32_t GetMinimumSleep() const final
+			{
+				return MillisToTicks(WatchdogMinimumMillis);
+			}
+
+			uint32_t Sleep(const uint32_t duration, const volatile bool& wake) final
+			{
+				const uint32_t durationMillis = TicksToMillis(duration);
+				if (durationMillis < WatchdogMinimumMillis)
+				{
+					return 0;
+				}
+
+				// Find the longest watchdog period that doesn't exceed the duration.
+				uint8_t prescaler = 0;
+				while (prescaler < WatchdogMaxPrescaler
+					&& (WatchdogMinimumMillis << (prescaler + 1)) <= durationMillis)
+				{
+					prescaler++;
+				}
+				const uint8_t prescalerBits = ((prescaler & 0x08) ? _BV(WDP3) : 0) | (prescaler & 0x07);
+
+				cli();
+				if (wake)
+				{
+					// A task was changed from an ISR since the idle check.
+					sei();
+					return 0;
+				}
+
+				// Timed sequence: start the watchdog in interrupt mode.
+				WatchdogFired = false;
+				MCUSR &= ~_BV(WDRF);
+				WDTCSR = _BV(WDCE) | _BV(WDE);
+				WDTCSR = _BV(WDIE) | prescalerBits;
+
+				set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+				sleep_enable();
+				sei(); // The instruction after sei() is always executed, so no interrupt is missed before sleeping.
+				sleep_cpu();
+				sleep_disable();
+				wdt_disable();
+
+				return WatchdogFired ? MillisToTicks(WatchdogMinimumMillis << prescaler) : 0;
+			}
+
+			/// <summary>
+			/// Must be called from ISR(WDT_vect).
+			/// </summary>
+			void OnInterrupt()
+			{
+				WatchdogFired = true;
+			}
+		};
+#endif
+	}
+}
+#endif
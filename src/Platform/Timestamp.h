@@ -5,7 +5,54 @@
 
 #if defined(ARDUINO)
 #include <Arduino.h>
-#elif defined(WINDOWS)
+#elif defined(HARMONIC_PLATFORM_HOST)
+#include "HostClock.h"
+#endif
+
+/// <summary>
+/// Scheduler time base, selected at compile time. All task periods, delays and timestamps are in time base ticks.
+/// - Default: millis(), 1 tick = 1 ms.
+/// - #define HARMONIC_TIME_BASE_MICROS: micros(), 1 tick = 1 us, for sub-millisecond periods.
+/// - #define HARMONIC_TIME_BASE_CUSTOM: application provided HarmonicGetTimestamp(), e.g. a hardware timer counter.
+///   Requires #define HARMONIC_TIME_BASE_TICKS_PER_MS with the counter's tick rate.
+/// The source must be a free-running 32-bit counter that wraps at UINT32_MAX, and be safe to read with interrupts disabled.
+/// Periods must stay below 2^31 ticks (~35 minutes with micros) for wraparound-safe ordering.
+/// </summary>
+#if defined(HARMONIC_TIME_BASE_MICROS) && defined(HARMONIC_TIME_BASE_CUSTOM)
+#error Only one of HARMONIC_TIME_BASE_MICROS and HARMONIC_TIME_BASE_CUSTOM can be defined.
+#elif defined(HARMONIC_TIME_BASE_CUSTOM)
+#if !defined(HARMONIC_TIME_BASE_TICKS_PER_MS)
+#error HARMONIC_TIME_BASE_CUSTOM requires HARMONIC_TIME_BASE_TICKS_PER_MS.
+#endif
+
+/// <summary>
+/// Custom scheduler timestamp source, implemented by the application.
+/// </summary>
+/// <returns>Free-running timestamp in time base ticks.</returns>
+extern uint32_t HarmonicGetTimestamp();
+#elif defined(HARMONIC_TIME_BASE_MICROS)
+#define HARMONIC_TIME_BASE_TICKS_PER_MS 1000
+#else
+#define HARMONIC_TIME_BASE_MILLIS
+#define HARMONIC_TIME_BASE_TICKS_PER_MS 1
+#endif
+
+/// <summary>
+/// Profiler time source, used for profiling traces and execution budgets.
+/// - Default: micros(), 1 profiler tick = 1 us.
+/// - #define HARMONIC_PROFILER_CYCLE_COUNTER: CPU cycle counter, 1 profiler tick = 1 cycle.
+///   DWT CYCCNT on Cortex-M3/M4/M7/M33, ccount on ESP32. A single register read, instead of a micros() call.
+///   Traces and budgets stay in microseconds: durations are converted with F_CPU at trace retrieval and budget setup.
+///   The counter wraps every 2^32 cycles (~17 s at 240 MHz), so keep trace windows shorter than that.
+/// </summary>
+#if defined(HARMONIC_PROFILER_CYCLE_COUNTER)
+#if defined(ARDUINO_ARCH_ESP32)
+#define HARMONIC_PROFILER_CYCLE_COUNTER_ESP32
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define HARMONIC_PROFILER_CYCLE_COUNTER_DWT
+#else
+#error HARMONIC_PROFILER_CYCLE_COUNTER is only available on ESP32 and Cortex-M3 and up.
+#endif
 #endif
 
 namespace Harmonic
@@ -15,29 +62,156 @@ namespace Harmonic
 	/// </summary>
 	namespace Platform
 	{
+		/// <summary>
+		/// Number of time base ticks per millisecond.
+		/// </summary>
+		static constexpr uint32_t TIMESTAMP_TICKS_PER_MS = HARMONIC_TIME_BASE_TICKS_PER_MS;
+
+		static_assert(TIMESTAMP_TICKS_PER_MS > 0, "HARMONIC_TIME_BASE_TICKS_PER_MS must be at least 1.");
+
+		/// <summary>
+		/// Converts milliseconds to time base ticks.
+		/// </summary>
+		/// <param name="millis">Duration in milliseconds.</param>
+		/// <returns>Duration in time base ticks.</returns>
+		static constexpr uint32_t MillisToTicks(const uint32_t millis)
+		{
+			return millis * TIMESTAMP_TICKS_PER_MS;
+		}
+
+		/// <summary>
+		/// Converts microseconds to time base ticks, rounded down.
+		/// Intended for compile-time constants, as it uses 64-bit arithmetic.
+		/// </summary>
+		/// <param name="micros">Duration in microseconds.</param>
+		/// <returns>Duration in time base ticks.</returns>
+		static constexpr uint32_t MicrosToTicks(const uint32_t micros)
+		{
+			return static_cast<uint32_t>((static_cast<uint64_t>(micros) * TIMESTAMP_TICKS_PER_MS) / 1000);
+		}
+
+		/// <summary>
+		/// Converts time base ticks to milliseconds, rounded down.
+		/// </summary>
+		/// <param name="ticks">Duration in time base ticks.</param>
+		/// <returns>Duration in milliseconds.</returns>
+		static constexpr uint32_t TicksToMillis(const uint32_t ticks)
+		{
+			return ticks / TIMESTAMP_TICKS_PER_MS;
+		}
+
+		/// <summary>
+		/// Converts time base ticks to microseconds, rounded down.
+		/// </summary>
+		/// <param name="ticks">Duration in time base ticks.</param>
+		/// <returns>Duration in microseconds.</returns>
+		static constexpr uint32_t TicksToMicros(const uint32_t ticks)
+		{
+			return static_cast<uint32_t>((static_cast<uint64_t>(ticks) * 1000) / TIMESTAMP_TICKS_PER_MS);
+		}
+
 		/// <summary>
 		/// Get the current time.
 		/// </summary>
-		/// <returns>Timestamp in milliseconds.</returns>
+		/// <returns>Timestamp in time base ticks.</returns>
 		inline uint32_t GetTimestamp()
 		{
-#if defined(ARDUINO)
+#if defined(HARMONIC_TIME_BASE_CUSTOM)
+			return HarmonicGetTimestamp();
+#elif defined(ARDUINO) && defined(HARMONIC_TIME_BASE_MICROS)
+			return micros();
+#elif defined(ARDUINO)
 			return millis();
+#elif defined(HARMONIC_PLATFORM_HOST) && defined(HARMONIC_TIME_BASE_MICROS)
+			return static_cast<uint32_t>(Host::GetMicros());
+#elif defined(HARMONIC_PLATFORM_HOST)
+			return static_cast<uint32_t>(Host::GetMicros() / 1000);
 #else
 #error No timestamp source for scheduler.
 #endif
 		}
 
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
 		/// <summary>
-		/// Gets the current profiler timestamp in microseconds.
+		/// Moves the virtual time base forward, see HostClock.h.
 		/// </summary>
-		/// <returns>Timestamp timestamp in microseconds.</returns>
+		/// <param name="ticks">Duration in time base ticks.</param>
+		inline void AdvanceVirtualTime(const uint32_t ticks)
+		{
+			Host::AdvanceVirtualMicros((static_cast<uint64_t>(ticks) * 1000) / TIMESTAMP_TICKS_PER_MS);
+		}
+
+#endif
+		/// <summary>
+		/// Starts the profiler time source, if it needs it. Called on scheduler construction.
+		/// Safe to call again, e.g. from setup() to check the result.
+		/// </summary>
+		/// <returns>True if the profiler time source is running.
+		/// False if the DWT cycle counter is missing or stays locked, in which case profiler timestamps don't advance.</returns>
+		inline bool StartProfilerTimestamp()
+		{
+#if defined(HARMONIC_PROFILER_CYCLE_COUNTER_DWT)
+			volatile uint32_t* const cycleCount = reinterpret_cast<volatile uint32_t*>(0xE0001004);
+
+			// Enable trace (DEMCR.TRCENA), unlock the DWT (DWT_LAR, required on Cortex-M7),
+			// then enable the cycle counter (DWT_CTRL.CYCCNTENA).
+			*reinterpret_cast<volatile uint32_t*>(0xE000EDFC) |= (uint32_t(1) << 24);
+			*reinterpret_cast<volatile uint32_t*>(0xE0001FB0) = 0xC5ACCE55;
+			*reinterpret_cast<volatile uint32_t*>(0xE0001000) |= 1;
+
+			// The counter is running if it advances over a few instructions.
+			const uint32_t start = *cycleCount;
+			for (volatile uint8_t i = 0; i < 4; i++)
+			{
+			}
+
+			return *cycleCount != start;
+#else
+			return true;
+#endif
+		}
+
+		/// <summary>
+		/// Gets the current profiler timestamp in profiler ticks.
+		/// </summary>
+		/// <returns>Timestamp in profiler ticks, microseconds unless HARMONIC_PROFILER_CYCLE_COUNTER.</returns>
 		inline uint32_t GetProfilerTimestamp()
 		{
-#if defined(ARDUINO)
+#if defined(HARMONIC_PROFILER_CYCLE_COUNTER_DWT)
+			return *reinterpret_cast<volatile const uint32_t*>(0xE0001004);
+#elif defined(HARMONIC_PROFILER_CYCLE_COUNTER_ESP32)
+			return ESP.getCycleCount();
+#elif defined(ARDUINO)
 			return micros();
+#elif defined(HARMONIC_PLATFORM_HOST)
+			// Steady clock even with virtual time: profiles measure real run time.
+			return static_cast<uint32_t>(Host::GetWallMicros());
 #else
 #error No timestamp source for profiler.
+#endif
+		}
+
+		/// <summary>
+		/// Converts a profiler tick duration to microseconds, rounded down.
+		/// </summary>
+		inline uint32_t ProfilerTicksToMicros(const uint32_t ticks)
+		{
+#if defined(HARMONIC_PROFILER_CYCLE_COUNTER)
+			return ticks / static_cast<uint32_t>(F_CPU / 1000000UL);
+#else
+			return ticks;
+#endif
+		}
+
+		/// <summary>
+		/// Converts a duration in microseconds to profiler ticks.
+		/// </summary>
+		inline uint32_t MicrosToProfilerTicks(const uint32_t micros)
+		{
+#if defined(HARMONIC_PROFILER_CYCLE_COUNTER)
+			return micros * static_cast<uint32_t>(F_CPU / 1000000UL);
+#else
+			return micros;
 #endif
 		}
 	}
@@ -4,6 +4,7 @@
 #include "../Model/TaskRegistry.h"
 #include "../Model/Profiling.h"
 #include "../Platform/Atomic.h"
+#include "../Platform/TicklessTimer.h"
 
 namespace Harmonic
 {
@@ -26,80 +27,238 @@ namespace Harmonic
 		/// </summary>
 		Platform::TaskTracker Tasks[MaxTaskCount]{};
 
+		/// <summary>
+		/// Statically allocated mask of Tasks indices whose schedule changed, set by the registry.
+		/// Linear schedulers re-check the higher priority ones after each run, the deadline scheduler re-keys them.
+		/// </summary>
+		volatile uint32_t ChangedMask[TaskMask::GetWordCount(MaxTaskCount)]{};
+
+#if defined(HARMONIC_STABLE_TASK_ID)
+	private:
+		/// <summary>
+		/// Statically allocated slot map, from stable task ID to Tasks index.
+		/// </summary>
+		task_id_t TaskSlots[MaxTaskCount];
+#endif
+
+#if defined(HARMONIC_ENABLED_MASK)
+	private:
+		/// <summary>
+		/// Statically allocated mask of possibly enabled Tasks indices.
+		/// </summary>
+		volatile uint32_t EnabledWords[TaskMask::GetWordCount(MaxTaskCount)]{};
+#endif
+
+#if !defined(HARMONIC_PLATFORM_OS)
+	private:
+		/// <summary>
+		/// Optional tickless wakeup source for deep idle sleep.
+		/// </summary>
+		Platform::ITicklessTimer* TicklessTimer = nullptr;
+#endif
+
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+	private:
+		/// <summary>
+		/// Virtual time in microseconds at the end of the last Loop() pass.
+		/// </summary>
+		uint64_t LastPassMicros = 0;
+#endif
+
+#if defined(HARMONIC_STABLE_TASK_ID)
 	public:
-		AbstractScheduler(const bool hotRegistry = false) : TaskRegistry(Tasks, MaxTaskCount, hotRegistry) {}
+		AbstractScheduler(const bool hotRegistry = false) : TaskRegistry(Tasks, TaskSlots, MaxTaskCount, hotRegistry)
+#else
+	public:
+		AbstractScheduler(const bool hotRegistry = false) : TaskRegistry(Tasks, MaxTaskCount, hotRegistry)
+#endif
+		{
+			// Profiling and budgets may need their time source started, no-op by default.
+			// A constructor can't report a locked cycle counter: call Platform::StartProfilerTimestamp() again to check.
+			Platform::StartProfilerTimestamp();
+
+			// Start tracking schedule changes.
+			ScheduleChangedMask = ChangedMask;
 
+#if defined(HARMONIC_ENABLED_MASK)
+			// Start tracking enabled tasks, including any attached before construction.
+			EnabledMask = EnabledWords;
+			TaskMask::SetRange(EnabledWords, 0, MaxTaskCount);
+#endif
+		}
+
+		using TaskRegistry::GetTimeUntilNextRun;
+
+#if !defined(HARMONIC_PLATFORM_OS)
 		/// <summary>
-		/// Returns the time in milliseconds until the next scheduled task is due to run.
+		/// Sets the tickless wakeup source for deep idle sleep, nullptr to restore sleep until the next system tick.
+		/// Only used when idle sleep is enabled. The time slept is credited back through AdvanceTimestamp().
 		/// </summary>
-		/// <returns>Time in milliseconds until the next task is due.</returns>
+		/// <param name="ticklessTimer">Tickless timer implementation, or nullptr.</param>
+		void SetTicklessTimer(Platform::ITicklessTimer* ticklessTimer)
+		{
+			TicklessTimer = ticklessTimer;
+		}
+#endif
+
+		/// <summary>
+		/// Returns the time in time base ticks until the next scheduled task is due to run.
+		/// </summary>
+		/// <returns>Time in ticks until the next task is due.</returns>
 		uint32_t GetTimeUntilNextRun() const
 		{
-			return GetTimeUntilNextRun<0>(Platform::GetTimestamp());
+			return TaskRegistry::GetTimeUntilNextRun(Platform::GetTimestamp());
 		}
 
 		/// <summary>
 		/// Advances the scheduler's notion of time, compensating for time spent in deep sleep.
 		/// Rolls back the last execution time of all tasks by the specified offset.
+		/// With HARMONIC_HOST_VIRTUAL_TIME, moves the virtual clock forward instead: this is what drives simulated time.
 		/// </summary>
-		/// <param name="offset">Forward offset in milliseconds.</param>
+		/// <param name="offset">Forward offset in time base ticks.</param>
 		void AdvanceTimestamp(const uint32_t offset)
 		{
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+			// Deadlines are relative to the clock, moving it moves them all.
+			Platform::AdvanceVirtualTime(offset);
+#else
 			// Instead of adding a constant offset to the timestamp source (adding runtime overhead), 
 			// the last execution time of all tasks is rolled back.
-			for (uint_fast8_t i = 0; i < TaskCount; i++)
+			for (task_id_t i = 0; i < TaskCount; i++)
 			{
 				Tasks[i].LastRun -= offset;
 			}
+
+			// All deadlines moved.
+			MarkScheduleChanged(0, TaskCount);
+#endif
 		}
 
 	protected:
 		/// <summary>
-		/// Returns the shortest time in milliseconds until any task is due to run.
-		/// If a task is due within 'shortest' ms, exits early for efficiency.
+		/// Drops the schedule changes made before a linear pass, which checks every task anyway.
 		/// </summary>
-		/// <typeparam name="shortest">Early exit threshold in milliseconds.</typeparam>
-		/// <param name="timestamp">Current timestamp.</param>
-		/// <returns>Shortest time in milliseconds until the next task is due.</returns>
-		template<uint32_t shortest = 0>
-		uint32_t GetTimeUntilNextRun(const uint32_t timestamp) const
+		void ClearChanged()
 		{
-			uint32_t shortestTime = UINT32_MAX;
-			for (uint_fast8_t i = 0; i < TaskCount; i++)
+			for (size_t w = 0; w < TaskMask::GetWordCount(MaxTaskCount); w++)
 			{
-				const uint32_t timeUntilNext = Tasks[i].TimeUntilNextRun(timestamp);
-				if (timeUntilNext < shortestTime)
-				{
-					shortestTime = timeUntilNext;
-					if (shortestTime <= shortest)
-					{
-						break;
-					}
-				}
+				TaskMask::Take(ChangedMask, w);
 			}
+		}
 
-			return shortestTime;
+		/// <summary>
+		/// Takes the next higher priority task woken or rescheduled since it was last taken, for linear dispatch.
+		/// Each index comes up once per sweep, so a task re-waking itself doesn't keep the sweep going.
+		/// </summary>
+		/// <param name="from">First Tasks index to look at.</param>
+		/// <param name="higherEnd">First Tasks index of the band that just ran.</param>
+		/// <returns>Tasks index of a changed task, higherEnd if none.</returns>
+		task_id_t TakeChangedHigher(const task_id_t from, const task_id_t higherEnd)
+		{
+			return TaskMask::TakeFirst(ChangedMask, from, higherEnd);
+		}
+
+		/// <summary>
+		/// Called at the end of every Loop() pass, after the optional idle sleep.
+		/// With HARMONIC_HOST_VIRTUAL_TIME, moves the virtual clock 1 us forward if the pass didn't move it,
+		/// so simulated time also passes without idle sleep, or while the scheduler stays hot. No-op otherwise.
+		/// </summary>
+		void EndPass()
+		{
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+			if (Platform::Host::GetMicros() == LastPassMicros)
+			{
+				Platform::Host::AdvanceVirtualMicros(1);
+			}
+			LastPassMicros = Platform::Host::GetMicros();
+#endif
 		}
 
 		void IdleSleep()
 		{
 			// Only sleep when nothing was ran in this timestamp 
 			// and is not set to run until the next millisecond or later.
-#ifdef HARMONIC_PLATFORM_OS
-			const uint32_t sleepDuration = GetTimeUntilNextRun<1>(Platform::GetTimestamp());
+#if defined(HARMONIC_RTOS_NOTIFY)
+			// Flag the sleep before checking the deadlines: a wake after the check notifies, one before shows in the check.
+			IdleSleepThread = xTaskGetCurrentTaskHandle();
+			IdleSleeping = true;
+			Platform::MemoryBarrier();
+
+			// RTOS sleep is in milliseconds, shorter waits keep polling: the scan can stop at a task due within 1 ms.
+			const uint32_t timeUntilNext = TaskRegistry::GetTimeUntilNextRun(Platform::GetTimestamp(), Platform::MillisToTicks(1));
+			const uint32_t sleepDuration = (timeUntilNext == UINT32_MAX) ? UINT32_MAX : Platform::TicksToMillis(timeUntilNext);
+			if (sleepDuration > 1 && !Hot)
+			{
+				WakeNotifications = Platform::IdleWait(sleepDuration);
+			}
+			IdleSleeping = false;
+#elif defined(HARMONIC_PLATFORM_OS)
+			// RTOS sleep is in milliseconds, shorter waits keep polling: the scan can stop at a task due within 1 ms.
+			const uint32_t timeUntilNext = TaskRegistry::GetTimeUntilNextRun(Platform::GetTimestamp(), Platform::MillisToTicks(1));
+			if (timeUntilNext == UINT32_MAX)
+			{
+				// Nothing scheduled: block until a task interrupt gives the semaphore.
+				Platform::IdleSleep(IdleSleepSemaphore, UINT32_MAX);
+				return;
+			}
+
+			const uint32_t sleepDuration = Platform::TicksToMillis(timeUntilNext);
 			if (sleepDuration > 1)
 			{
 				Platform::IdleSleep(IdleSleepSemaphore, sleepDuration);
 			}
+#elif defined(HARMONIC_HOST_VIRTUAL_TIME)
+			// Virtual time: idle time passes instantly, straight to the next due task.
+			const uint32_t timeUntilNext = TaskRegistry::GetTimeUntilNextRun(Platform::GetTimestamp());
+			if (!Hot)
+			{
+				if (timeUntilNext == UINT32_MAX)
+				{
+					// Nothing scheduled: idle a system tick at a time, letting threads that simulate interrupts run.
+					AdvanceTimestamp((Platform::IDLE_WAKE_TICKS > 0) ? Platform::IDLE_WAKE_TICKS : 1);
+					std::this_thread::yield();
+				}
+				else
+				{
+					// Due now but not run yet: tasks run once their period is exceeded, one tick on.
+					AdvanceTimestamp((timeUntilNext > 0) ? timeUntilNext : 1);
+				}
+			}
 #else
-				// Only sleep if no tasks are due immediately.
+			if (TicklessTimer != nullptr)
+			{
+				// Deep sleep until the next task is due, if it's far enough away.
+				const uint32_t sleepDuration = TaskRegistry::GetTimeUntilNextRun(Platform::GetTimestamp());
+				if (sleepDuration >= TicklessTimer->GetMinimumSleep()
+					&& !Hot)
+				{
+					const uint32_t slept = TicklessTimer->Sleep(sleepDuration, Hot);
+					if (slept > 0)
+					{
+						// The timestamp source was stopped, catch up with the time slept.
+						AdvanceTimestamp(slept);
+					}
+					return;
+				}
+			}
+
+#if defined(HARMONIC_TIME_BASE_MILLIS)
+			// Only sleep if no tasks are due immediately.
 			const uint32_t timestamp = Platform::GetTimestamp();
-			if (GetTimeUntilNextRun<0>(timestamp) != 0 // No tasks due immediately.
+			if (TaskRegistry::GetTimeUntilNextRun(timestamp) != 0 // No tasks due immediately.
 				&& !Hot // Not flagged hot by task interrupts.
 				&& timestamp == Platform::GetTimestamp()) // No time advanced since last check.
 			{
 				Platform::IdleSleep(); // Safely micro-sleep until the next ms tick or interrupt.
 			}
+#else
+			// Sub-millisecond time base: the next wake is the system tick, so only sleep if no task is due before it.
+			if (TaskRegistry::GetTimeUntilNextRun(Platform::GetTimestamp()) > Platform::IDLE_WAKE_TICKS
+				&& !Hot) // Not flagged hot by task interrupts.
+			{
+				Platform::IdleSleep(); // Safely micro-sleep until the next system tick or interrupt.
+			}
+#endif
 #endif
 		}
 	};
@@ -39,6 +39,26 @@ namespace Harmonic
 		using Base::TaskCount;
 		using Base::Hot;
 		using Base::IdleSleep;
+		using Base::EndPass;
+		using Base::OnTaskRun;
+		using Base::RunningIndex;
+		using Base::EndTaskRun;
+		using Base::GetTaskBand;
+		using Base::GetBandStart;
+		using Base::ClearChanged;
+		using Base::TakeChangedHigher;
+		using Base::GetNextEnabledIndex;
+#if defined(HARMONIC_TASK_BUDGET)
+		using Base::StartBudgetPass;
+		using Base::GetNextBudgetIndex;
+		using Base::GetTaskBudget;
+		using Base::CheckTaskBudget;
+		using Base::IsPassBudgetSpent;
+#endif
+#if defined(HARMONIC_TIMELINE)
+		using Base::IsTimelineRecording;
+		using Base::RecordTimelineRun;
+#endif
 
 	private:
 		/// <summary>
@@ -77,8 +97,11 @@ namespace Harmonic
 				return false; // No trace data available.
 			}
 
-			// Copy overall trace.
-			trace = Trace;
+			// Copy overall trace, from profiler ticks to microseconds.
+			trace.Iterations = Trace.Iterations;
+			trace.Scheduling = Platform::ProfilerTicksToMicros(Trace.Scheduling);
+			trace.Busy = Platform::ProfilerTicksToMicros(Trace.Busy);
+			trace.IdleSleep = Platform::ProfilerTicksToMicros(Trace.IdleSleep);
 
 			// Clear trace data after retrieval.
 			ClearTraceData();
@@ -91,7 +114,8 @@ namespace Harmonic
 		/// 
 		/// Executes one scheduler iteration:
 		/// 1. Records loop start time
-		/// 2. Checks each task and runs those that are due, measuring task execution time
+		/// 2. Checks each task in priority order and runs those that are due, measuring task execution time
+		///    After each run, re-checks the higher priority tasks it woke or rescheduled
 		/// 3. Optionally enters idle sleep if (when IdleSleepEnabled is true)
 		/// 4. Records total idle + scheduling overhead (includes task dispatch time but excludes sleep)
 		/// 5. Increments iteration counter
@@ -101,6 +125,9 @@ namespace Harmonic
 		/// - Trace.Scheduling: Cumulative time for idle + scheduler overhead + task execution (microseconds)
 		/// - Trace.IdleSleep: Cumulative time spent in idle sleep (microseconds)
 		/// - Trace.Iterations: Number of Loop() calls (scheduler tick count)
+		/// Times are kept in profiler ticks, and converted by GetTrace().
+		/// 
+		/// The profiler timestamp is read at the pass start and end, and around each task that runs.
 		/// 
 		/// Should be called as frequently as possible (typically in main loop).
 		/// </summary>
@@ -117,21 +144,41 @@ namespace Harmonic
 				Hot = false;
 			}
 
+			// Only changes made during this pass count for the higher priority re-checks.
+			ClearChanged();
+
 			// Run all tasks that are due, measuring busy time (actual task execution).
-			measure = Platform::GetProfilerTimestamp();
-			for (uint_fast8_t i = 0; i < TaskCount; i++)
+#if defined(HARMONIC_TASK_BUDGET)
+			// Higher priority bands first, then the band the last pass ran out of budget in, resumed where it stopped.
+			const task_id_t first = StartBudgetPass();
+			for (task_id_t n = 0, i = first; n < TaskCount; n++, i = GetNextBudgetIndex(i))
+#else
+			// Disabled tasks are skipped, a mask word at a time with HARMONIC_ENABLED_MASK.
+			for (task_id_t i = GetNextEnabledIndex(0); i < TaskCount; i = GetNextEnabledIndex(i + 1))
+#endif
 			{
-				if (Tasks[i].RunIfTime())
+				if (RunTask(i))
 				{
-					// Task executed: accumulate its duration.
-					Trace.Busy += Platform::GetProfilerTimestamp() - measure;
-
-					// Optimization: under heavy load, skip idle sleep checks.
-					Hot = true;
+					// Higher priority tasks woken or rescheduled during this run, without rescanning their bands.
+					const task_id_t higherEnd = GetBandStart(GetTaskBand(i));
+					for (task_id_t j = TakeChangedHigher(0, higherEnd); j < higherEnd; j = TakeChangedHigher(j + 1, higherEnd))
+					{
+						RunTask(j);
+					}
+
+#if defined(HARMONIC_TASK_BUDGET)
+					// Defer the remaining tasks to the next pass.
+					if (IsPassBudgetSpent(GetNextBudgetIndex(i)))
+					{
+						break;
+					}
+#endif
 				}
-				measure = Platform::GetProfilerTimestamp();
 			}
 
+			// Timestamp after all tasks have run (before potential sleep).
+			measure = Platform::GetProfilerTimestamp();
+
 			// Optional idle sleep with timing, optimized out if disabled.
 			if (IdleSleepEnabled && !Hot)
 			{
@@ -139,6 +186,7 @@ namespace Harmonic
 				IdleSleep();
 				Trace.IdleSleep += Platform::GetProfilerTimestamp() - measure;
 			}
+			EndPass();
 
 			// Record total scheduling time (from loop start to now, excluding sleep).
 			// This includes task dispatch overhead, task execution time, and any other
@@ -148,6 +196,45 @@ namespace Harmonic
 		}
 
 	private:
+		/// <summary>
+		/// Runs a task if it is due, accumulating its duration.
+		/// </summary>
+		/// <param name="index">Task index.</param>
+		/// <returns>True if the task ran.</returns>
+		bool RunTask(task_id_t index)
+		{
+			uint32_t lateness, start, duration;
+			RunningIndex = index;
+			const bool ran = Tasks[index].RunIfTime(lateness, start, duration);
+			index = EndTaskRun(); // Moved if Run() attached a higher priority task.
+			if (ran)
+			{
+				// Task executed: accumulate its duration.
+				Trace.Busy += duration;
+
+#if defined(HARMONIC_TIMELINE)
+				RecordTimelineRun(index, start, duration, lateness);
+#endif
+
+#if defined(HARMONIC_TASK_BUDGET)
+				const uint32_t budget = GetTaskBudget(index);
+				if (budget != 0)
+				{
+					CheckTaskBudget(index, duration, budget);
+				}
+#endif
+
+				// Optimization: under heavy load, skip idle sleep checks.
+				Hot = true;
+
+				// Keep the next deadline cache coherent, optimized out if idle sleep is disabled.
+				if (IdleSleepEnabled)
+					OnTaskRun(index);
+			}
+
+			return ran;
+		}
+
 		void ClearTraceData()
 		{
 			Trace.Iterations = 0;
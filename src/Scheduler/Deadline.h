@@ -0,0 +1,470 @@
+#ifndef _HARMONIC_SCHEDULER_DEADLINE_h
+#define _HARMONIC_SCHEDULER_DEADLINE_h
+
+#include "Abstract.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// SchedulerDeadline provides a deadline-ordered cooperative task scheduler with no profiling overhead.
+	///
+	/// Enabled tasks are kept in a binary min-heap keyed on their due timestamp (LastRun + Period, with late bias).
+	/// Each Loop() pass only touches the tasks that are actually due, instead of checking every registered task.
+	///
+	/// Schedule changes (Attach, Detach, SetPeriod, SetEnabled, WakeFromISR, ...) are flagged by the registry
+	/// in a change mask, which is safe to set from an ISR. The loop drains that mask first and re-keys only the changed tasks.
+	///
+	/// Trade-offs vs SchedulerNoProfiling:
+	/// - O(k log N) per pass for k due tasks, vs O(N) for every pass
+	/// - Higher memory cost: heap, heap index, and due timestamp per task
+	/// - Higher cost per run, so a few always-due tasks (period 0) are faster with linear dispatch
+	///
+	/// When to use:
+	/// - Many tasks with long periods, where most passes have few or no due tasks
+	///
+	/// Usage:
+	/// Call Loop() as frequently as possible (typically in main loop).
+	/// </summary>
+	/// <typeparam name="MaxTaskCount">Maximum number of tasks supported (must not exceed TASK_MAX_COUNT).</typeparam>
+	/// <typeparam name="IdleSleepEnabled">Enable low-power idle sleep when no tasks are running.</typeparam>
+	template<task_id_t MaxTaskCount, bool IdleSleepEnabled = false>
+	class SchedulerDeadline : public AbstractScheduler<MaxTaskCount>
+	{
+	private:
+		using Base = AbstractScheduler<MaxTaskCount>;
+		static_assert(MaxTaskCount <= TASK_MAX_COUNT, "MaxTaskCount exceeds platform maximum task count (TASK_MAX_COUNT)");
+
+		static constexpr size_t MaskWordCount = TaskMask::GetWordCount(MaxTaskCount);
+
+	protected:
+		using Base::Tasks;
+		using Base::TaskCount;
+		using Base::Hot;
+		using Base::IdleSleep;
+		using Base::EndPass;
+		using Base::OnTaskRun;
+		using Base::RunningIndex;
+		using Base::EndTaskRun;
+		using Base::ChangedMask;
+		using Base::GetBandStart;
+		using Base::GetBandEnd;
+#if defined(HARMONIC_TASK_BUDGET)
+		using Base::StartBudgetPass;
+		using Base::GetTaskBudget;
+		using Base::CheckTaskBudget;
+		using Base::IsPassBudgetSpent;
+#endif
+
+	private:
+		/// <summary>
+		/// Due timestamp per task ID, valid only while the task is queued.
+		/// </summary>
+		uint32_t DueTimestamps[MaxTaskCount]{};
+
+		/// <summary>
+		/// Binary min-heap of queued task IDs, ordered on DueTimestamps.
+		/// </summary>
+		task_id_t Queue[MaxTaskCount]{};
+
+		/// <summary>
+		/// Heap position per task ID, TASK_INVALID_ID if the task is not queued.
+		/// </summary>
+		task_id_t QueueIndex[MaxTaskCount];
+
+		/// <summary>
+		/// Number of queued tasks.
+		/// </summary>
+		task_id_t QueueSize = 0;
+
+		/// <summary>
+		/// Task IDs popped as due in the current pass.
+		/// </summary>
+		task_id_t DueTasks[MaxTaskCount]{};
+
+	public:
+		SchedulerDeadline() : Base(IdleSleepEnabled)
+		{
+			for (task_id_t i = 0; i < MaxTaskCount; i++)
+			{
+				QueueIndex[i] = TASK_INVALID_ID;
+			}
+
+			// Queue any task attached before construction.
+			TaskMask::SetRange(ChangedMask, 0, MaxTaskCount);
+		}
+
+		/// <summary>
+		/// Main scheduler loop with deadline-ordered dispatch.
+		///
+		/// Executes one scheduler iteration:
+		/// 1. Drains the change mask, re-keying only the tasks that changed
+		/// 2. Pops all queued tasks that are due and runs them in priority order, then deadline order
+		/// 3. Re-checks the queue for higher priority tasks due after each lower priority run, at a fresh timestamp
+		/// 4. Re-queues each popped task with its new due timestamp (or drops it if disabled)
+		/// 5. Optionally enters idle sleep if no tasks ran (when IdleSleepEnabled is true)
+		///
+		/// Should be called as frequently as possible (typically in main loop).
+		/// </summary>
+		void Loop()
+		{
+			// Compile-time switch for idle sleep feature.
+			if (IdleSleepEnabled)
+			{
+				// Reset hot flag before checking tasks.
+				Hot = false;
+			}
+
+			const uint32_t timestamp = Platform::GetTimestamp();
+
+			DrainChanges(timestamp);
+
+			// Pop all due tasks first, so re-queued period 0 tasks only run once per pass.
+			task_id_t dueCount = 0;
+			while (QueueSize > 0 && IsDue(Queue[0], timestamp))
+			{
+				DueTasks[dueCount++] = Pop();
+			}
+
+#if defined(HARMONIC_TASK_BUDGET)
+			// Due tasks left over when the pass budget is spent stay due, and run first on the next pass.
+			StartBudgetPass();
+			bool budgetSpent = false;
+#endif
+
+			// Run due tasks one priority band at a time, highest first.
+			for (uint8_t band = 0; band < TASK_PRIORITY_COUNT; band++)
+			{
+				const task_id_t bandStart = GetBandStart(band);
+				const task_id_t bandEnd = GetBandEnd(band);
+				if (bandStart == bandEnd)
+				{
+					continue;
+				}
+
+				for (task_id_t i = 0; i < dueCount; i++)
+				{
+					const task_id_t taskId = DueTasks[i];
+					if (taskId >= bandStart && taskId < bandEnd)
+					{
+						DueTasks[i] = TASK_INVALID_ID;
+						RunTask(taskId, timestamp);
+
+						// Higher priority tasks may have become due during this run.
+						RunHigherDue(bandStart);
+
+#if defined(HARMONIC_TASK_BUDGET)
+						if (IsPassBudgetSpent(0))
+						{
+							budgetSpent = true;
+							break;
+						}
+#endif
+					}
+				}
+
+#if defined(HARMONIC_TASK_BUDGET)
+				if (budgetSpent)
+				{
+					break;
+				}
+#endif
+			}
+
+			// Re-queue due tasks left out by a band change or the pass budget.
+			for (task_id_t i = 0; i < dueCount; i++)
+			{
+				if (DueTasks[i] != TASK_INVALID_ID)
+				{
+					Defer(DueTasks[i], timestamp);
+				}
+			}
+
+			// Enter idle sleep only if no tasks ran and registry is stable.
+			if (IdleSleepEnabled && !Hot)
+			{
+				IdleSleep();
+			}
+
+			EndPass();
+		}
+
+	private:
+		/// <summary>
+		/// Runs a task if it is due, then re-queues it.
+		/// </summary>
+		/// <param name="taskId">Task ID to run.</param>
+		/// <param name="timestamp">Current pass timestamp.</param>
+		void RunTask(const task_id_t taskId, const uint32_t timestamp)
+		{
+			RunIfDue(taskId);
+			Reschedule(taskId, timestamp);
+		}
+
+		/// <summary>
+		/// Runs the queued higher priority tasks that became due during a lower priority run.
+		/// Checked against a fresh timestamp, as the run took time. Only the due entries are popped:
+		/// lower priority ones that came due since the pass timestamp are left for the next pass.
+		/// Each task runs at most once per call, it is re-keyed through the change mask on the next drain.
+		/// </summary>
+		/// <param name="bandStart">First task ID of the band that just ran.</param>
+		void RunHigherDue(const task_id_t bandStart)
+		{
+			const uint32_t timestamp = Platform::GetTimestamp();
+
+			// Re-key the tasks woken or changed during the run.
+			DrainChanges(timestamp);
+
+			while (QueueSize > 0 && IsDue(Queue[0], timestamp))
+			{
+				const task_id_t taskId = Pop();
+				if (taskId < bandStart)
+				{
+					RunIfDue(taskId);
+				}
+				TaskMask::Set(ChangedMask, taskId);
+			}
+		}
+
+		/// <summary>
+		/// Runs a task if it is due, without re-queuing it.
+		/// </summary>
+		/// <param name="taskId">Task ID to run.</param>
+		void RunIfDue(task_id_t taskId)
+		{
+			if (taskId >= TaskCount)
+			{
+				return;
+			}
+#if defined(HARMONIC_TASK_BUDGET)
+			// Only budgeted tasks are timed.
+			const uint32_t budget = GetTaskBudget(taskId);
+			const uint32_t runStart = (budget != 0) ? Platform::GetProfilerTimestamp() : 0;
+#endif
+			RunningIndex = taskId;
+			const bool ran = Tasks[taskId].RunIfTime();
+			taskId = EndTaskRun(); // Moved if Run() attached a higher priority task, re-keyed through the change mask.
+			if (ran)
+			{
+#if defined(HARMONIC_TASK_BUDGET)
+				if (budget != 0)
+				{
+					CheckTaskBudget(taskId, Platform::GetProfilerTimestamp() - runStart, budget);
+				}
+#endif
+
+				if (IdleSleepEnabled)
+				{
+					// Optimization: under heavy load, skip idle sleep checks.
+					Hot = true;
+
+					// Keep the next deadline cache coherent.
+					OnTaskRun(taskId);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Re-keys every task flagged in the change mask.
+		/// </summary>
+		/// <param name="timestamp">Current timestamp.</param>
+		void DrainChanges(const uint32_t timestamp)
+		{
+			for (size_t w = 0; w < MaskWordCount; w++)
+			{
+				uint32_t changed = TaskMask::Take(ChangedMask, w);
+				while (changed != 0)
+				{
+					const uint8_t bit = TaskMask::FindFirstSet(changed);
+					changed &= changed - 1; // Clear lowest set bit.
+
+					const size_t taskId = (w * TaskMask::WordBits) + bit;
+					if (taskId < MaxTaskCount)
+					{
+						Reschedule(static_cast<task_id_t>(taskId), timestamp);
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Queues, re-keys or removes a task according to its current tracker state.
+		/// </summary>
+		/// <param name="taskId">Task ID to reschedule.</param>
+		/// <param name="timestamp">Current timestamp.</param>
+		void Reschedule(const task_id_t taskId, const uint32_t timestamp)
+		{
+			uint32_t due;
+			if (taskId < TaskCount && Tasks[taskId].GetDueTimestamp(timestamp, due))
+			{
+				Enqueue(taskId, due);
+			}
+			else if (QueueIndex[taskId] != TASK_INVALID_ID)
+			{
+				// Disabled or removed: drop from the queue.
+				RemoveAt(QueueIndex[taskId]);
+			}
+		}
+
+		/// <summary>
+		/// Re-queues a popped task that didn't get to run in this pass.
+		/// If still due, it keeps its popped key (at the latest just before the pass timestamp),
+		/// so it runs ahead of the tasks that ran in this pass.
+		/// </summary>
+		/// <param name="taskId">Task ID to defer.</param>
+		/// <param name="timestamp">Current pass timestamp.</param>
+		void Defer(const task_id_t taskId, const uint32_t timestamp)
+		{
+			uint32_t due;
+			if (taskId < TaskCount && Tasks[taskId].GetDueTimestamp(timestamp, due))
+			{
+				if (IsReached(due, timestamp))
+				{
+					const uint32_t popped = DueTimestamps[taskId];
+					due = (popped != timestamp) ? popped : (timestamp - 1);
+				}
+				Enqueue(taskId, due);
+			}
+			else if (QueueIndex[taskId] != TASK_INVALID_ID)
+			{
+				RemoveAt(QueueIndex[taskId]);
+			}
+		}
+
+		/// <summary>
+		/// Queues or re-keys a task with the given due timestamp.
+		/// </summary>
+		/// <param name="taskId">Task ID to queue.</param>
+		/// <param name="due">Due timestamp.</param>
+		void Enqueue(const task_id_t taskId, const uint32_t due)
+		{
+			DueTimestamps[taskId] = due;
+			if (QueueIndex[taskId] == TASK_INVALID_ID)
+			{
+				// Insert at the bottom and bubble up.
+				Queue[QueueSize] = taskId;
+				QueueIndex[taskId] = QueueSize;
+				QueueSize++;
+				SiftUp(QueueIndex[taskId]);
+			}
+			else
+			{
+				// Key may have moved either way.
+				SiftDown(SiftUp(QueueIndex[taskId]));
+			}
+		}
+
+		/// <summary>
+		/// Returns true if the queued task is due at the given timestamp.
+		/// </summary>
+		bool IsDue(const task_id_t taskId, const uint32_t timestamp) const
+		{
+			return IsReached(DueTimestamps[taskId], timestamp);
+		}
+
+		/// <summary>
+		/// Returns true if a due timestamp has been reached.
+		/// </summary>
+		static bool IsReached(const uint32_t due, const uint32_t timestamp)
+		{
+			return static_cast<int32_t>(timestamp - due) >= 0;
+		}
+
+		/// <summary>
+		/// Heap order: earlier due timestamp first, lower task ID on ties.
+		/// </summary>
+		bool IsEarlier(const task_id_t a, const task_id_t b) const
+		{
+			const int32_t delta = static_cast<int32_t>(DueTimestamps[a] - DueTimestamps[b]);
+
+			return delta < 0 || (delta == 0 && a < b);
+		}
+
+		/// <summary>
+		/// Removes and returns the earliest queued task.
+		/// </summary>
+		task_id_t Pop()
+		{
+			const task_id_t taskId = Queue[0];
+			RemoveAt(0);
+
+			return taskId;
+		}
+
+		/// <summary>
+		/// Removes the task at the given heap position.
+		/// </summary>
+		void RemoveAt(const task_id_t index)
+		{
+			QueueIndex[Queue[index]] = TASK_INVALID_ID;
+			QueueSize--;
+			if (index < QueueSize)
+			{
+				// Move the last entry into the hole and restore heap order.
+				Queue[index] = Queue[QueueSize];
+				QueueIndex[Queue[index]] = index;
+				SiftDown(SiftUp(index));
+			}
+		}
+
+		/// <summary>
+		/// Moves the entry at index up until heap order is restored.
+		/// </summary>
+		/// <returns>Final heap position.</returns>
+		task_id_t SiftUp(task_id_t index)
+		{
+			while (index > 0)
+			{
+				const task_id_t parent = (index - 1) >> 1;
+				if (!IsEarlier(Queue[index], Queue[parent]))
+				{
+					break;
+				}
+				Swap(index, parent);
+				index = parent;
+			}
+
+			return index;
+		}
+
+		/// <summary>
+		/// Moves the entry at index down until heap order is restored.
+		/// </summary>
+		void SiftDown(task_id_t index)
+		{
+			while (true)
+			{
+				const size_t left = (size_t(index) << 1) + 1;
+				if (left >= QueueSize)
+				{
+					break;
+				}
+
+				task_id_t child = static_cast<task_id_t>(left);
+				if (left + 1 < QueueSize && IsEarlier(Queue[left + 1], Queue[left]))
+				{
+					child = static_cast<task_id_t>(left + 1);
+				}
+
+				if (!IsEarlier(Queue[child], Queue[index]))
+				{
+					break;
+				}
+				Swap(index, child);
+				index = child;
+			}
+		}
+
+		/// <summary>
+		/// Swaps two heap entries, keeping the heap index in sync.
+		/// </summary>
+		void Swap(const task_id_t a, const task_id_t b)
+		{
+			const task_id_t swap = Queue[a];
+			Queue[a] = Queue[b];
+			Queue[b] = swap;
+			QueueIndex[Queue[a]] = a;
+			QueueIndex[Queue[b]] = b;
+		}
+	};
+}
+#endif
@@ -50,6 +50,26 @@ namespace Harmonic
 		using Base::TaskCount;
 		using Base::Hot;
 		using Base::IdleSleep;
+		using Base::EndPass;
+		using Base::OnTaskRun;
+		using Base::RunningIndex;
+		using Base::EndTaskRun;
+		using Base::GetTaskBand;
+		using Base::GetBandStart;
+		using Base::ClearChanged;
+		using Base::TakeChangedHigher;
+		using Base::GetNextEnabledIndex;
+#if defined(HARMONIC_TASK_BUDGET)
+		using Base::StartBudgetPass;
+		using Base::GetNextBudgetIndex;
+		using Base::GetTaskBudget;
+		using Base::CheckTaskBudget;
+		using Base::IsPassBudgetSpent;
+#endif
+#if defined(HARMONIC_TIMELINE)
+		using Base::IsTimelineRecording;
+		using Base::RecordTimelineRun;
+#endif
 
 	private:
 		/// <summary>
@@ -59,6 +79,15 @@ namespace Harmonic
 		/// </summary>
 		Profiling::TaskTrace TaskTraces[MaxTaskCount]{};
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+		/// <summary>
+		/// Interrupt traces snapshot by GetTrace(), with the task traces, so rows stay matched if tasks move before they are read.
+		/// </summary>
+		Profiling::InterruptTrace InterruptTraces[MaxTaskCount]{};
+		bool InterruptTraceValid[MaxTaskCount]{};
+		task_id_t InterruptTraceCount = 0;
+#endif
+
 		/// <summary>
 		/// Global profiling trace for the current measurement window.
 		/// Includes total scheduling overhead, idle sleep time, iteration count, and task count.
@@ -66,6 +95,16 @@ namespace Harmonic
 		/// </summary>
 		Profiling::FullTrace Trace{};
 
+		/// <summary>
+		/// Only one in SampleInterval passes is profiled, 1 to profile every pass.
+		/// </summary>
+		uint8_t SampleInterval = 1;
+
+		/// <summary>
+		/// Passes left until the next profiled pass.
+		/// </summary>
+		uint8_t SampleCountdown = 0;
+
 	public:
 		SchedulerFullProfiling()
 			: Profiling::IFullProfiler()
@@ -96,28 +135,63 @@ namespace Harmonic
 		/// <param name="tracesBuffer">Output buffer to receive per-task profiling data (must be at least maxTraces elements).</param>
 		/// <param name="maxTraces">Size of the tracesBuffer array (maximum number of task traces to copy).</param>
 		/// <returns>True if trace contains valid data (at least one iteration); false otherwise.</returns>
-		bool GetTrace(Profiling::FullTrace& trace, Profiling::TaskTrace* tracesBuffer, const uint8_t maxTraces) override
+		bool GetTrace(Profiling::FullTrace& trace, Profiling::TaskTrace* tracesBuffer, const task_id_t maxTraces) override
 		{
 			if (Trace.Iterations == 0)
 			{
 				return false; // No trace data available.
 			}
 
-			// Copy overall trace.
+			// Copy overall trace, from profiler ticks to microseconds.
 			trace = Trace;
+			trace.Scheduling = Platform::ProfilerTicksToMicros(Trace.Scheduling);
+			trace.IdleSleep = Platform::ProfilerTicksToMicros(Trace.IdleSleep);
 
 			// Copy per-task traces up to the provided buffer size.
-			const uint8_t traceCount = (Trace.TaskCount < maxTraces) ? Trace.TaskCount : maxTraces;
-			for (uint_fast8_t i = 0; i < traceCount; i++)
+			const task_id_t traceCount = (Trace.TaskCount < maxTraces) ? Trace.TaskCount : maxTraces;
+			for (task_id_t i = 0; i < traceCount; i++)
 			{
-				tracesBuffer[i] = this->TaskTraces[i];
+				tracesBuffer[i].Duration = Platform::ProfilerTicksToMicros(TaskTraces[i].Duration);
+				tracesBuffer[i].MaxDuration = Platform::ProfilerTicksToMicros(TaskTraces[i].MaxDuration);
+				tracesBuffer[i].Iterations = TaskTraces[i].Iterations;
 			}
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			// Interrupt traces are taken in the same pass, from the same task positions.
+			for (task_id_t i = 0; i < traceCount; i++)
+			{
+				InterruptTraceValid[i] = (i < TaskCount) && (Tasks[i].Task != nullptr) && Tasks[i].Task->GetInterruptTrace(InterruptTraces[i]);
+			}
+			InterruptTraceCount = traceCount;
+#endif
+
 			ClearTraceData();
 
 			return true;
 		}
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+		/// <summary>
+		/// Retrieves the interrupt trace snapshot by the last GetTrace(), for the task at the same position in its traces buffer.
+		/// Only interrupt tasks (InterruptFlag, InterruptSignal, InterruptEvent) report one. Each snapshot is returned once.
+		/// </summary>
+		/// <param name="index">Task position, lower than the trace task count.</param>
+		/// <param name="trace">Output interrupt trace, latencies in microseconds.</param>
+		/// <returns>True if the task is an interrupt task, with a wake or a dropped interrupt in the last trace.</returns>
+		bool GetInterruptTrace(const task_id_t index, Profiling::InterruptTrace& trace) override
+		{
+			if (index >= InterruptTraceCount || index >= MaxTaskCount || !InterruptTraceValid[index])
+			{
+				return false;
+			}
+
+			InterruptTraceValid[index] = false;
+			trace = InterruptTraces[index];
+
+			return true;
+		}
+#endif
+
 		/// <summary>
 		/// Resets all profiling counters (global and per-task) to zero.
 		/// Called automatically by GetTrace() after copying data.
@@ -132,7 +206,7 @@ namespace Harmonic
 			Trace.Scheduling = 0;
 
 			// Clear per-task traces.
-			for (uint_fast8_t i = 0; i < MaxTaskCount; i++)
+			for (task_id_t i = 0; i < MaxTaskCount; i++)
 			{
 				TaskTraces[i].Duration = 0;
 				TaskTraces[i].MaxDuration = 0;
@@ -140,13 +214,27 @@ namespace Harmonic
 			}
 		}
 
+		/// <summary>
+		/// Profiles only one in every given number of passes, so full profiling can stay on in production.
+		/// The other passes dispatch as SchedulerNoProfiling, without profiler timestamp reads
+		/// (except around tasks with a budget, with HARMONIC_TASK_BUDGET).
+		/// Traces then describe the sampled passes only: ratios hold, counts and totals scale down by the interval.
+		/// </summary>
+		/// <param name="passes">Sampling interval in passes, 1 (default) to profile every pass.</param>
+		void SetSampleInterval(const uint8_t passes)
+		{
+			SampleInterval = (passes > 0) ? passes : 1;
+			SampleCountdown = 0;
+		}
+
 		/// <summary>
 		/// Main scheduler loop with full per-task profiling.
 		/// 
 		/// Executes one scheduler iteration:
 		/// 1. Records loop start time
 		/// 2. Detects task count changes and resets trace if necessary (prevents stale data)
-		/// 3. Checks each task and runs those that are due, measuring individual execution time
+		/// 3. Checks each task in priority order and runs those that are due, measuring individual execution time
+		///    After each run, re-checks the higher priority tasks it woke or rescheduled
 		/// 4. Tracks per-task statistics: cumulative duration, max duration, iteration count
 		/// 5. Optionally enters idle sleep if no tasks ran (when IdleSleepEnabled is true)
 		/// 6. Records total scheduling overhead (task dispatch + execution time)
@@ -163,6 +251,10 @@ namespace Harmonic
 		/// - TaskTraces[i].MaxDuration: Worst-case execution time for task i (microseconds)
 		/// - TaskTraces[i].Iterations: Number of times task i executed
 		/// 
+		/// Times are kept in profiler ticks, and converted to microseconds by GetTrace().
+		/// The profiler timestamp is read at the pass start and end, and around each task that runs.
+		/// With SetSampleInterval(), unsampled passes only dispatch.
+		/// 
 		/// Note: Sum of TaskTraces[].Duration equals total busy time (task execution).
 		///       Trace.Scheduling includes all task execution plus scheduler dispatch overhead.
 		/// 
@@ -174,6 +266,24 @@ namespace Harmonic
 		/// </summary>
 		void Loop()
 		{
+			// Unsampled pass: dispatch only.
+			if (SampleCountdown > 1)
+			{
+				SampleCountdown--;
+				if (IdleSleepEnabled)
+				{
+					Hot = false;
+				}
+				DispatchTasks<false>();
+				if (IdleSleepEnabled && !Hot)
+				{
+					IdleSleep();
+				}
+				EndPass();
+				return;
+			}
+			SampleCountdown = SampleInterval;
+
 			const uint32_t loopStart = Platform::GetProfilerTimestamp();
 			uint32_t measure = 0; // Reusable timestamp for measuring individual task segments.
 
@@ -199,27 +309,7 @@ namespace Harmonic
 			}
 
 			// Run all tasks that are due, measuring each task's execution time individually.
-			for (uint_fast8_t i = 0; i < Trace.TaskCount; i++)
-			{
-				measure = Platform::GetProfilerTimestamp();
-				if (Tasks[i].RunIfTime())
-				{
-					// Task executed: measure its duration and update statistics.
-					measure = Platform::GetProfilerTimestamp() - measure;
-
-					// Optimization: under heavy load, skip idle sleep checks.
-					Hot = true;
-
-					TaskTraces[i].Iterations++;
-					TaskTraces[i].Duration += measure;
-
-					// Track worst-case execution time for this task.
-					if (TaskTraces[i].MaxDuration < measure)
-					{
-						TaskTraces[i].MaxDuration = measure;
-					}
-				}
-			}
+			DispatchTasks<true>();
 
 			// Timestamp after all tasks have run (before potential sleep).
 			measure = Platform::GetProfilerTimestamp();
@@ -231,6 +321,7 @@ namespace Harmonic
 				IdleSleep();
 				Trace.IdleSleep += Platform::GetProfilerTimestamp() - measure;
 			}
+			EndPass();
 
 			// Record total scheduling time (from loop start to end of task dispatch).
 			// This includes task dispatch overhead and all task execution time.
@@ -241,6 +332,112 @@ namespace Harmonic
 			Trace.Iterations++;
 			Trace.Scheduling += measure - loopStart;
 		}
+
+	private:
+		/// <summary>
+		/// Runs all due tasks in priority order, re-checking the higher priority tasks woken or rescheduled by each run.
+		/// </summary>
+		/// <typeparam name="Sampled">True to profile the runs.</typeparam>
+		template<bool Sampled>
+		void DispatchTasks()
+		{
+			// Only changes made during this pass count for the higher priority re-checks.
+			ClearChanged();
+
+#if defined(HARMONIC_TASK_BUDGET)
+			// Higher priority bands first, then the band the last pass ran out of budget in, resumed where it stopped.
+			const task_id_t first = StartBudgetPass();
+			for (task_id_t n = 0, i = first; n < TaskCount; n++, i = GetNextBudgetIndex(i))
+#else
+			// Disabled tasks are skipped, a mask word at a time with HARMONIC_ENABLED_MASK.
+			for (task_id_t i = GetNextEnabledIndex(0); i < TaskCount; i = GetNextEnabledIndex(i + 1))
+#endif
+			{
+				if (RunTask<Sampled>(i))
+				{
+					// Higher priority tasks woken or rescheduled during this run, without rescanning their bands.
+					const task_id_t higherEnd = GetBandStart(GetTaskBand(i));
+					for (task_id_t j = TakeChangedHigher(0, higherEnd); j < higherEnd; j = TakeChangedHigher(j + 1, higherEnd))
+					{
+						RunTask<Sampled>(j);
+					}
+
+#if defined(HARMONIC_TASK_BUDGET)
+					// Defer the remaining tasks to the next pass.
+					if (IsPassBudgetSpent(GetNextBudgetIndex(i)))
+					{
+						break;
+					}
+#endif
+				}
+			}
+		}
+
+		/// <summary>
+		/// Runs a task if it is due, measuring its duration and updating its statistics when sampled.
+		/// The profiler timestamp is only read around an actual run.
+		/// </summary>
+		/// <typeparam name="Sampled">True to profile the run.</typeparam>
+		/// <param name="index">Task index.</param>
+		/// <returns>True if the task ran.</returns>
+		template<bool Sampled>
+		bool RunTask(task_id_t index)
+		{
+			uint32_t lateness, start;
+			uint32_t duration = 0;
+#if defined(HARMONIC_TASK_BUDGET)
+			const uint32_t budget = GetTaskBudget(index);
+			bool measured = Sampled || budget != 0;
+#else
+			bool measured = Sampled;
+#endif
+#if defined(HARMONIC_TIMELINE)
+			// The timeline needs every run, sampled or not.
+			measured = measured || IsTimelineRecording();
+#endif
+			RunningIndex = index;
+			const bool ran = measured ? Tasks[index].RunIfTime(lateness, start, duration) : Tasks[index].RunIfTime();
+			index = EndTaskRun(); // Moved if Run() attached a higher priority task.
+			if (!ran)
+			{
+				return false;
+			}
+
+#if defined(HARMONIC_TIMELINE)
+			if (measured)
+			{
+				RecordTimelineRun(index, start, duration, lateness);
+			}
+#endif
+
+			// Optimization: under heavy load, skip idle sleep checks.
+			Hot = true;
+
+			// Keep the next deadline cache coherent, optimized out if idle sleep is disabled.
+			if (IdleSleepEnabled)
+				OnTaskRun(index);
+
+			if (Sampled)
+			{
+				TaskTraces[index].Iterations++;
+				TaskTraces[index].Duration += duration;
+
+				// Track worst-case execution time for this task.
+				if (TaskTraces[index].MaxDuration < duration)
+				{
+					TaskTraces[index].MaxDuration = duration;
+				}
+			}
+
+#if defined(HARMONIC_TASK_BUDGET)
+			if (budget != 0)
+			{
+				CheckTaskBudget(index, duration, budget);
+			}
+#endif
+
+			return true;
+		}
 	};
 }
 #endif
\ No newline at end of file
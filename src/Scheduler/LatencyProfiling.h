@@ -0,0 +1,305 @@
+#ifndef _HARMONIC_SCHEDULER_LATENCY_PROFILER_h
+#define _HARMONIC_SCHEDULER_LATENCY_PROFILER_h
+
+#include "Abstract.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// SchedulerLatencyProfiling: Scheduler loop with per-task latency and jitter distributions.
+	/// Implements Profiling::ILatencyProfiler for trace retrieval.
+	/// 
+	/// Collects, for each individual task:
+	/// - Log2 histogram of execution time (microseconds)
+	/// - Log2 histogram of start jitter: how late each run started vs LastRun + Period (time base ticks)
+	/// - Maximum execution time and jitter, iteration count
+	/// Plus the same global metrics as SchedulerFullProfiling.
+	/// Percentiles (p50, p99) are extracted from the histograms with Profiling::GetHistogramPercentile().
+	/// 
+	/// Use cases:
+	/// - Tuning task periods from real lateness distributions, instead of the max alone
+	/// - Spotting tasks whose tail execution time delays the others
+	/// 
+	/// Trade-offs vs SchedulerFullProfiling:
+	/// - Higher memory cost: 2 histograms per task (LATENCY_BUCKET_COUNT x 2 bytes each)
+	/// - Slightly higher per-run overhead: two bucket lookups per task execution
+	/// - Jitter resolution is one time base tick, use HARMONIC_TIME_BASE_MICROS for sub-millisecond jitter
+	/// 
+	/// Traces are cleared on task count changes, as with SchedulerFullProfiling.
+	/// 
+	/// Usage:
+	/// Call Loop() as frequently as possible (typically in main loop).
+	/// For traces, periodically call GetTrace() to retrieve and reset profiling data.
+	/// </summary>
+	/// <typeparam name="MaxTaskCount">Maximum number of tasks supported (must not exceed TASK_MAX_COUNT).</typeparam>
+	/// <typeparam name="IdleSleepEnabled">Enable low-power idle sleep when no tasks are running.</typeparam>
+	template<task_id_t MaxTaskCount, bool IdleSleepEnabled = false>
+	class SchedulerLatencyProfiling : public Profiling::ILatencyProfiler, public AbstractScheduler<MaxTaskCount>
+	{
+	private:
+		using Base = AbstractScheduler<MaxTaskCount>;
+		static_assert(MaxTaskCount <= TASK_MAX_COUNT, "MaxTaskCount exceeds platform maximum task count (TASK_MAX_COUNT)");
+
+	protected:
+		using Base::Tasks;
+		using Base::TaskCount;
+		using Base::Hot;
+		using Base::IdleSleep;
+		using Base::EndPass;
+		using Base::OnTaskRun;
+		using Base::RunningIndex;
+		using Base::EndTaskRun;
+		using Base::GetTaskBand;
+		using Base::GetBandStart;
+		using Base::ClearChanged;
+		using Base::TakeChangedHigher;
+		using Base::GetNextEnabledIndex;
+#if defined(HARMONIC_TASK_BUDGET)
+		using Base::StartBudgetPass;
+		using Base::GetNextBudgetIndex;
+		using Base::GetTaskBudget;
+		using Base::CheckTaskBudget;
+		using Base::IsPassBudgetSpent;
+#endif
+#if defined(HARMONIC_TIMELINE)
+		using Base::IsTimelineRecording;
+		using Base::RecordTimelineRun;
+#endif
+
+	private:
+		/// <summary>
+		/// Per-task latency data array, indexed by task ID.
+		/// Stores duration and jitter histograms, cumulative and max duration, max jitter and iteration count for each task.
+		/// Reset to zero after each GetTrace() call.
+		/// </summary>
+		Profiling::LatencyTaskTrace TaskTraces[MaxTaskCount]{};
+
+		/// <summary>
+		/// Global profiling trace for the current measurement window.
+		/// Includes total scheduling overhead, idle sleep time, iteration count, and task count.
+		/// Reset to zero after each GetTrace() call.
+		/// </summary>
+		Profiling::FullTrace Trace{};
+
+	public:
+		SchedulerLatencyProfiling()
+			: Profiling::ILatencyProfiler()
+			, Base(IdleSleepEnabled)
+		{
+		}
+
+		/// <summary>
+		/// Retrieves and clears accumulated profiling data for all tasks and global metrics.
+		/// 
+		/// This method atomically copies the current trace data (both global and per-task)
+		/// and resets all counters. Each trace represents the time period since the last
+		/// GetTrace() call (or since scheduler start if this is the first call).
+		/// 
+		/// The caller must provide a buffer large enough to hold per-task traces. If the
+		/// buffer is smaller than the actual task count, only the first maxTraces tasks
+		/// will be copied (safe truncation).
+		/// 
+		/// Typical usage:
+		///   - Call this periodically (e.g., every 1 second via a logging task)
+		///   - Analyze global trace (CPU usage, idle time, etc.)
+		///   - Iterate through per-task traces to identify hotspots
+		/// 
+		/// Returns false if no iterations have occurred since the last call, indicating
+		/// no useful data is available.
+		/// </summary>
+		/// <param name="trace">Output structure that receives global profiling data (scheduling, idle, iterations).</param>
+		/// <param name="tracesBuffer">Output buffer to receive per-task profiling data (must be at least maxTraces elements).</param>
+		/// <param name="maxTraces">Size of the tracesBuffer array (maximum number of task traces to copy).</param>
+		/// <returns>True if trace contains valid data (at least one iteration); false otherwise.</returns>
+		bool GetTrace(Profiling::FullTrace& trace, Profiling::LatencyTaskTrace* tracesBuffer, const task_id_t maxTraces) override
+		{
+			if (Trace.Iterations == 0)
+			{
+				return false; // No trace data available.
+			}
+
+			// Copy overall trace, from profiler ticks to microseconds.
+			trace = Trace;
+			trace.Scheduling = Platform::ProfilerTicksToMicros(Trace.Scheduling);
+			trace.IdleSleep = Platform::ProfilerTicksToMicros(Trace.IdleSleep);
+
+			// Copy per-task traces up to the provided buffer size.
+			const task_id_t traceCount = (Trace.TaskCount < maxTraces) ? Trace.TaskCount : maxTraces;
+			for (task_id_t i = 0; i < traceCount; i++)
+			{
+				tracesBuffer[i] = this->TaskTraces[i];
+			}
+
+			ClearTraceData();
+
+			return true;
+		}
+
+		/// <summary>
+		/// Resets all profiling counters (global and per-task) to zero.
+		/// Called automatically by GetTrace() after copying data.
+		/// Also called automatically when task count changes to prevent stale data.
+		/// Can be called manually to discard accumulated data and start a fresh measurement window.
+		/// </summary>
+		void ClearTraceData()
+		{
+			// Clear global trace.
+			Trace.Iterations = 0;
+			Trace.IdleSleep = 0;
+			Trace.Scheduling = 0;
+
+			// Clear per-task traces.
+			for (task_id_t i = 0; i < MaxTaskCount; i++)
+			{
+				TaskTraces[i] = Profiling::LatencyTaskTrace{};
+			}
+		}
+
+		/// <summary>
+		/// Main scheduler loop with per-task latency profiling.
+		/// 
+		/// Same dispatch as SchedulerFullProfiling::Loop(). Each task execution adds its duration
+		/// and start jitter to the task's histograms.
+		/// 
+		/// Should be called as frequently as possible (typically in main loop).
+		/// </summary>
+		void Loop()
+		{
+			const uint32_t loopStart = Platform::GetProfilerTimestamp();
+			uint32_t measure = 0; // Reusable timestamp for measuring individual task segments.
+
+			// Initialize TaskCount on first iteration, or detect changes mid-trace.
+			if (Trace.Iterations == 0)
+			{
+				// First iteration: snapshot the current task count.
+				Trace.TaskCount = TaskCount;
+			}
+			else if (Trace.TaskCount != TaskCount)
+			{
+				// Task count changed (attach/detach): clear stale data and resync.
+				ClearTraceData();
+				Trace.TaskCount = TaskCount;
+			}
+
+			// Compile-time check for idle sleep feature, optimized out if disabled.
+			if (IdleSleepEnabled)
+			{
+				// Reset hot flag before looping all tasks.
+				// If any task runs or registry changes, Hot will be set to true.
+				Hot = false;
+			}
+
+			// Only changes made during this pass count for the higher priority re-checks.
+			ClearChanged();
+
+			// Run all tasks that are due, measuring each task's execution time individually.
+#if defined(HARMONIC_TASK_BUDGET)
+			// Higher priority bands first, then the band the last pass ran out of budget in, resumed where it stopped.
+			const task_id_t first = StartBudgetPass();
+			for (task_id_t n = 0, i = first; n < TaskCount; n++, i = GetNextBudgetIndex(i))
+#else
+			// Disabled tasks are skipped, a mask word at a time with HARMONIC_ENABLED_MASK.
+			for (task_id_t i = GetNextEnabledIndex(0); i < TaskCount; i = GetNextEnabledIndex(i + 1))
+#endif
+			{
+				if (RunTask(i))
+				{
+					// Higher priority tasks woken or rescheduled during this run, without rescanning their bands.
+					const task_id_t higherEnd = GetBandStart(GetTaskBand(i));
+					for (task_id_t j = TakeChangedHigher(0, higherEnd); j < higherEnd; j = TakeChangedHigher(j + 1, higherEnd))
+					{
+						RunTask(j);
+					}
+
+#if defined(HARMONIC_TASK_BUDGET)
+					// Defer the remaining tasks to the next pass.
+					if (IsPassBudgetSpent(GetNextBudgetIndex(i)))
+					{
+						break;
+					}
+#endif
+				}
+			}
+
+			// Timestamp after all tasks have run (before potential sleep).
+			measure = Platform::GetProfilerTimestamp();
+
+			// Optional idle sleep with timing, optimized out if disabled.
+			if (IdleSleepEnabled && !Hot)
+			{
+				// No tasks ran and registry is stable: enter low-power sleep.
+				IdleSleep();
+				Trace.IdleSleep += Platform::GetProfilerTimestamp() - measure;
+			}
+			EndPass();
+
+			// Record total scheduling time (from loop start to end of task dispatch).
+			// This includes task dispatch overhead and all task execution time.
+			// Sleep time is tracked separately in Trace.IdleSleep.
+			// 
+			// To calculate pure scheduler overhead (dispatch only, not task execution):
+			//   overhead = Trace.Scheduling - sum(TaskTraces[].Duration)
+			Trace.Iterations++;
+			Trace.Scheduling += measure - loopStart;
+		}
+
+	private:
+		/// <summary>
+		/// Runs a task if it is due, measuring its duration and updating its statistics.
+		/// </summary>
+		/// <param name="index">Task index.</param>
+		/// <returns>True if the task ran.</returns>
+		bool RunTask(task_id_t index)
+		{
+			uint32_t jitter, start, duration;
+			RunningIndex = index;
+			const bool ran = Tasks[index].RunIfTime(jitter, start, duration);
+			index = EndTaskRun(); // Moved if Run() attached a higher priority task.
+			if (!ran)
+			{
+				return false;
+			}
+
+#if defined(HARMONIC_TIMELINE)
+			RecordTimelineRun(index, start, duration, jitter);
+#endif
+
+			// Task executed: histograms are in microseconds, converted per run.
+			const uint32_t measure = Platform::ProfilerTicksToMicros(duration);
+
+			// Optimization: under heavy load, skip idle sleep checks.
+			Hot = true;
+
+			// Keep the next deadline cache coherent, optimized out if idle sleep is disabled.
+			if (IdleSleepEnabled)
+				OnTaskRun(index);
+
+			Profiling::LatencyTaskTrace& taskTrace = TaskTraces[index];
+			taskTrace.Iterations++;
+			taskTrace.Duration += measure;
+			Profiling::AddHistogramSample(taskTrace.DurationHistogram, measure);
+			Profiling::AddHistogramSample(taskTrace.JitterHistogram, jitter);
+
+			// Track worst-case execution time and jitter for this task.
+			if (taskTrace.MaxDuration < measure)
+			{
+				taskTrace.MaxDuration = measure;
+			}
+			if (taskTrace.MaxJitter < jitter)
+			{
+				taskTrace.MaxJitter = jitter;
+			}
+
+#if defined(HARMONIC_TASK_BUDGET)
+			const uint32_t budget = GetTaskBudget(index);
+			if (budget != 0)
+			{
+				CheckTaskBudget(index, duration, budget);
+			}
+#endif
+
+			return true;
+		}
+	};
+}
+#endif
\ No newline at end of file
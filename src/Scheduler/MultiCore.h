@@ -0,0 +1,503 @@
+#ifndef _HARMONIC_SCHEDULER_MULTI_CORE_h
+#define _HARMONIC_SCHEDULER_MULTI_CORE_h
+
+#include "Template.h"
+#include "../Model/Profiling.h"
+#include "../Platform/Atomic.h"
+#include "../Platform/Core.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// MultiCoreScheduler runs one scheduler per core, each with its own registry, on dual-core RP2040 and ESP32.
+	///
+	/// - Call Loop() from each core's loop (e.g. loop() and loop1() on RP2040). Each core only ever runs, and touches, its own registry.
+	/// - Task affinity is set on Attach(), by picking the core's registry.
+	/// - Cross-core SetEnabled, SetPeriod, SetPeriodAndEnabled and WakeFromISR are queued in a lock-free mailbox per core pair,
+	///   and applied by the target core at the start of its next Loop() pass. The target's scheduler is woken from idle sleep.
+	///   Calls targeting the calling core are applied directly.
+	/// - Tasks can migrate between cores with Migrate(), or automatically with Balance() when a core's busy ratio exceeds a threshold.
+	///
+	/// #define HARMONIC_MULTI_CORE - set flag to make AtomicGuard mask interrupts on the current core only,
+	/// instead of entering the global taskENTER_CRITICAL() section, which stalls both cores.
+	/// Only valid if every registry is accessed from its own core only: use this scheduler's cross-core calls,
+	/// and attach interrupts that touch a core's tasks on that same core.
+	///
+	/// Callability:
+	/// - Loop, Attach, Migrate, Balance: Not safe to call from an ISR.
+	/// - SetEnabled, SetPeriod, SetPeriodAndEnabled, WakeFromISR: Safe to call from any context on any core, including from an ISR.
+	/// Cross-core calls return false if the mailbox is full, and address tasks by their ID on the target core:
+	/// HARMONIC_STABLE_TASK_ID is recommended if the target core attaches or detaches tasks.
+	/// </summary>
+	/// <typeparam name="MaxTaskCount">Maximum number of tasks per core.</typeparam>
+	/// <typeparam name="IdleSleepEnabled">Enable low power idle sleep when no tasks are ready.</typeparam>
+	/// <typeparam name="Level">Profiling level of each core's scheduler.</typeparam>
+	/// <typeparam name="Dispatch">Dispatch policy of each core's scheduler.</typeparam>
+	/// <typeparam name="CoreCount">Number of cores, defaults to the platform's.</typeparam>
+	template<task_id_t MaxTaskCount, bool IdleSleepEnabled = false, ProfileLevelEnum Level = ProfileLevelEnum::None, DispatchPolicyEnum Dispatch = DispatchPolicyEnum::Linear, uint8_t CoreCount = Platform::CORE_COUNT>
+	class MultiCoreScheduler
+	{
+		static_assert(CoreCount > 0, "CoreCount must be at least 1.");
+
+	public:
+		using CoreScheduler = TemplateScheduler<MaxTaskCount, IdleSleepEnabled, Level, Dispatch>;
+
+	private:
+		enum class RequestEnum : uint8_t
+		{
+			SetEnabled,
+			SetPeriod,
+			SetPeriodAndEnabled,
+			Wake,
+			Migrate,
+			Adopt
+		};
+
+		/// <summary>
+		/// Cross-core request, applied by the target core.
+		/// </summary>
+		struct Request
+		{
+			ITask* Task;
+			uint32_t Period;
+			task_id_t TaskId;
+			RequestEnum Type;
+
+			/// <summary>
+			/// Enabled state, target core for Migrate, or enabled state (bit 0) and priority (bits 1+) for Adopt.
+			/// </summary>
+			uint8_t Arg;
+		};
+
+		/// <summary>
+		/// Number of pending requests per core pair. Must be a power of 2.
+		/// </summary>
+		static constexpr uint8_t MailboxCapacity = 8;
+		static constexpr uint8_t MailboxMask = MailboxCapacity - 1;
+
+		/// <summary>
+		/// Single producer, single consumer request ring, from a source core to a target core.
+		/// Producers on the source core are serialized by AtomicGuard, the target core is the only consumer.
+		/// Head and Tail are free-running, so Head - Tail is the pending count.
+		/// </summary>
+		struct Mailbox
+		{
+			Request Items[MailboxCapacity];
+			volatile uint8_t Head = 0;
+			volatile uint8_t Tail = 0;
+
+			bool Push(const Request& request)
+			{
+				Platform::AtomicGuard guard;
+				const uint8_t head = Head;
+				if (uint8_t(head - Tail) >= MailboxCapacity)
+				{
+					return false;
+				}
+
+				Items[head & MailboxMask] = request;
+				Platform::MemoryBarrier(); // Publish the request before the head.
+				Head = head + 1;
+
+				return true;
+			}
+
+			bool Pop(Request& request)
+			{
+				const uint8_t tail = Tail;
+				if (tail == Head)
+				{
+					return false;
+				}
+
+				Platform::MemoryBarrier(); // Read the request after the head.
+				request = Items[tail & MailboxMask];
+				Platform::MemoryBarrier(); // Release the slot after reading it.
+				Tail = tail + 1;
+
+				return true;
+			}
+		};
+
+	private:
+		CoreScheduler Cores[CoreCount];
+
+		/// <summary>
+		/// Mailboxes indexed by [target core][source core].
+		/// </summary>
+		Mailbox Mailboxes[CoreCount][CoreCount];
+
+		/// <summary>
+		/// Last busy ratio of each core in percent, reported through Balance().
+		/// </summary>
+		volatile uint8_t CoreBusy[CoreCount]{};
+
+		/// <summary>
+		/// Busy ratio in percent above which Balance() migrates a task, 0 to disable.
+		/// </summary>
+		uint8_t BalanceThreshold = 0;
+
+	public:
+		MultiCoreScheduler() {}
+
+		/// <summary>
+		/// Returns the scheduler of a core, to attach tasks with affinity to it, or to get its traces.
+		/// Its registry must only be used from that core, or before that core starts running Loop().
+		/// </summary>
+		/// <param name="core">Core index, lower than CoreCount.</param>
+		CoreScheduler& GetCore(const uint8_t core)
+		{
+			return Cores[core];
+		}
+
+		/// <summary>
+		/// Runs the current core's scheduler, applying the requests queued by other cores first.
+		/// </summary>
+		void Loop()
+		{
+			Loop(Platform::GetCoreId());
+		}
+
+		/// <summary>
+		/// Runs a core's scheduler, applying the requests queued by other cores first.
+		/// Must be called from that core.
+		/// </summary>
+		/// <param name="core">Core index, lower than CoreCount.</param>
+		void Loop(const uint8_t core)
+		{
+			Request request;
+			for (uint8_t source = 0; source < CoreCount; source++)
+			{
+				while (Mailboxes[core][source].Pop(request))
+				{
+					Apply(core, source, request);
+				}
+			}
+
+			Cores[core].Loop();
+		}
+
+		/// <summary>
+		/// Attaches a task to a core's scheduler, with affinity to that core.
+		/// Must be called from that core, or before that core starts running Loop().
+		/// Tasks that track their own ID (e.g. DynamicTask) are bound to a core by being constructed with GetCore(core) instead.
+		/// </summary>
+		/// <param name="core">Core index, lower than CoreCount.</param>
+		/// <param name="task">Pointer to ITask implementation.</param>
+		/// <param name="period">Initial delay before first run (time base ticks).</param>
+		/// <param name="enabled">Initial enabled state.</param>
+		/// <param name="priority">Priority class of the task.</param>
+		/// <returns>True on success, false otherwise.</returns>
+		bool Attach(const uint8_t core, ITask* task, const uint32_t period = 0, const bool enabled = true, const TaskPriorityEnum priority = TaskPriorityEnum::Normal)
+		{
+			if (core >= CoreCount)
+				return false;
+
+			return Cores[core].Attach(task, period, enabled, priority);
+		}
+
+		/// <summary>
+		/// Sets the enabled state of a task on any core.
+		/// Safe to call from any context on any core, including from an ISR.
+		/// </summary>
+		/// <param name="core">Core the task is attached to.</param>
+		/// <param name="taskId">Valid task ID on that core.</param>
+		/// <param name="enabled">New enabled state.</param>
+		/// <returns>True if applied or queued, false if the mailbox is full.</returns>
+		bool SetEnabled(const uint8_t core, const task_id_t taskId, const bool enabled)
+		{
+			return Post(core, RequestEnum::SetEnabled, taskId, 0, enabled);
+		}
+
+		/// <summary>
+		/// Sets the run period of a task on any core.
+		/// Safe to call from any context on any core, including from an ISR.
+		/// </summary>
+		/// <param name="core">Core the task is attached to.</param>
+		/// <param name="taskId">Valid task ID on that core.</param>
+		/// <param name="period">New period in time base ticks.</param>
+		/// <returns>True if applied or queued, false if the mailbox is full.</returns>
+		bool SetPeriod(const uint8_t core, const task_id_t taskId, const uint32_t period)
+		{
+			return Post(core, RequestEnum::SetPeriod, taskId, period, 0);
+		}
+
+		/// <summary>
+		/// Sets both the run period and enabled state of a task on any core.
+		/// Safe to call from any context on any core, including from an ISR.
+		/// </summary>
+		/// <param name="core">Core the task is attached to.</param>
+		/// <param name="taskId">Valid task ID on that core.</param>
+		/// <param name="period">New period in time base ticks.</param>
+		/// <param name="enabled">New enabled state.</param>
+		/// <returns>True if applied or queued, false if the mailbox is full.</returns>
+		bool SetPeriodAndEnabled(const uint8_t core, const task_id_t taskId, const uint32_t period, const bool enabled)
+		{
+			return Post(core, RequestEnum::SetPeriodAndEnabled, taskId, period, enabled);
+		}
+
+		/// <summary>
+		/// Wakes a task on any core, to run immediately.
+		/// Safe to call from any context on any core, including from an ISR.
+		/// </summary>
+		/// <param name="core">Core the task is attached to.</param>
+		/// <param name="taskId">Valid task ID on that core.</param>
+		/// <returns>True if applied or queued, false if the mailbox is full.</returns>
+		bool WakeFromISR(const uint8_t core, const task_id_t taskId)
+		{
+			return Post(core, RequestEnum::Wake, taskId, 0, 0);
+		}
+
+		/// <summary>
+		/// Moves a task to another core, keeping its period, enabled state and priority.
+		/// The source core detaches the task and the target core attaches it, on their next Loop() passes.
+		/// If the target core is full, the task returns to the source core.
+		/// Only tasks that don't track their own ID can migrate, as those are bound to a registry.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="fromCore">Core the task is attached to.</param>
+		/// <param name="task">Pointer to ITask implementation.</param>
+		/// <param name="toCore">Destination core.</param>
+		/// <returns>True if the migration was started, false otherwise.</returns>
+		bool Migrate(const uint8_t fromCore, ITask* task, const uint8_t toCore)
+		{
+			if (fromCore >= CoreCount
+				|| toCore >= CoreCount
+				|| fromCore == toCore
+				|| task == nullptr)
+			{
+				return false;
+			}
+
+			const uint8_t source = Platform::GetCoreId();
+			if (fromCore == source)
+			{
+				return MigrateTask(fromCore, task, toCore);
+			}
+
+			const Request request{ task, 0, TASK_INVALID_ID, RequestEnum::Migrate, toCore };
+			return Send(fromCore, source, request);
+		}
+
+		/// <summary>
+		/// Sets the busy ratio above which Balance() migrates a task off a core.
+		/// </summary>
+		/// <param name="busyPercent">Busy ratio threshold in percent, 0 to disable balancing.</param>
+		void SetBalanceThreshold(const uint8_t busyPercent)
+		{
+			BalanceThreshold = busyPercent;
+		}
+
+		/// <summary>
+		/// Returns the last busy ratio reported for a core through Balance(), in percent.
+		/// </summary>
+		/// <param name="core">Core index, lower than CoreCount.</param>
+		uint8_t GetBusyPercent(const uint8_t core) const
+		{
+			return CoreBusy[core];
+		}
+
+		/// <summary>
+		/// Reports a core's full trace, and migrates one of its periodic tasks if its busy ratio is over the threshold.
+		/// The busy ratio is the sum of task durations, over the trace window (Scheduling + IdleSleep).
+		/// The heaviest enabled periodic task that keeps the least busy core below this core's busy ratio is migrated there.
+		/// Must be called from that core, with the trace retrieved from GetCore(core).GetTrace(),
+		/// for example from the core's trace logging task. Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="core">Core the trace belongs to.</param>
+		/// <param name="trace">Full trace of the core.</param>
+		/// <param name="taskTraces">Per-task traces of the core, indexed by TaskList position.</param>
+		/// <param name="traceCount">Number of task traces.</param>
+		/// <returns>True if a task migration was started.</returns>
+		bool Balance(const uint8_t core, const Profiling::FullTrace& trace, const Profiling::TaskTrace* taskTraces, const task_id_t traceCount)
+		{
+			if (core >= CoreCount)
+				return false;
+
+			const uint32_t window = trace.Scheduling + trace.IdleSleep;
+			if (window == 0)
+				return false;
+
+			const task_id_t count = (trace.TaskCount < traceCount) ? trace.TaskCount : traceCount;
+			uint32_t busy = 0;
+			for (task_id_t i = 0; i < count; i++)
+			{
+				busy += taskTraces[i].Duration;
+			}
+			const uint8_t busyPercent = GetPercent(busy, window);
+			CoreBusy[core] = busyPercent;
+
+			if (BalanceThreshold == 0
+				|| busyPercent <= BalanceThreshold)
+			{
+				return false;
+			}
+
+			// Find the least busy other core.
+			uint8_t target = core;
+			for (uint8_t c = 0; c < CoreCount; c++)
+			{
+				if (c != core
+					&& CoreBusy[c] < busyPercent
+					&& (target == core || CoreBusy[c] < CoreBusy[target]))
+				{
+					target = c;
+				}
+			}
+			if (target == core)
+				return false;
+
+			// Find the heaviest periodic task that doesn't overload the target, so tasks don't bounce back.
+			CoreScheduler& registry = Cores[core];
+			ITask* heaviest = nullptr;
+			uint8_t heaviestPercent = 0;
+			for (task_id_t i = 0; i < count && i < registry.GetTaskCount(); i++)
+			{
+				const uint8_t taskPercent = GetPercent(taskTraces[i].Duration, window);
+				const task_id_t taskId = registry.GetTaskIdAt(i);
+				ITask* task = registry.GetTask(taskId);
+				task_id_t assignedId;
+				if (taskPercent > heaviestPercent
+					&& (uint16_t(CoreBusy[target]) + taskPercent) < busyPercent
+					&& task != nullptr
+					&& !task->GetAssignedTaskId(assignedId)
+					&& registry.IsEnabled(taskId)
+					&& registry.GetPeriod(taskId) > 0)
+				{
+					heaviest = task;
+					heaviestPercent = taskPercent;
+				}
+			}
+			if (heaviest == nullptr)
+				return false;
+
+			if (!MigrateTask(core, heaviest, target))
+				return false;
+
+			// Account for the move until the next reports.
+			CoreBusy[target] = CoreBusy[target] + heaviestPercent;
+			CoreBusy[core] = busyPercent - heaviestPercent;
+
+			return true;
+		}
+
+	private:
+		/// <summary>
+		/// Applies a request directly if the target is the current core, queues it to the target core otherwise.
+		/// </summary>
+		bool Post(const uint8_t core, const RequestEnum type, const task_id_t taskId, const uint32_t period, const uint8_t arg)
+		{
+			if (core >= CoreCount)
+				return false;
+
+			const uint8_t source = Platform::GetCoreId();
+			const Request request{ nullptr, period, taskId, type, arg };
+			if (core == source)
+			{
+				Apply(core, source, request);
+				return true;
+			}
+
+			return Send(core, source, request);
+		}
+
+		/// <summary>
+		/// Queues a request to the target core and wakes its scheduler.
+		/// </summary>
+		bool Send(const uint8_t core, const uint8_t source, const Request& request)
+		{
+			if (!Mailboxes[core][source].Push(request))
+			{
+				return false;
+			}
+
+			Cores[core].WakeScheduler();
+
+			return true;
+		}
+
+		/// <summary>
+		/// Applies a request on its target core.
+		/// </summary>
+		/// <param name="core">Target core, the current one.</param>
+		/// <param name="source">Core the request came from.</param>
+		/// <param name="request">Request to apply.</param>
+		void Apply(const uint8_t core, const uint8_t source, const Request& request)
+		{
+			CoreScheduler& registry = Cores[core];
+			switch (request.Type)
+			{
+			case RequestEnum::SetEnabled:
+				registry.SetEnabled(request.TaskId, request.Arg != 0);
+				break;
+			case RequestEnum::SetPeriod:
+				registry.SetPeriod(request.TaskId, request.Period);
+				break;
+			case RequestEnum::SetPeriodAndEnabled:
+				registry.SetPeriodAndEnabled(request.TaskId, request.Period, request.Arg != 0);
+				break;
+			case RequestEnum::Wake:
+				registry.WakeFromISR(request.TaskId);
+				break;
+			case RequestEnum::Migrate:
+				MigrateTask(core, request.Task, request.Arg);
+				break;
+			case RequestEnum::Adopt:
+				if (!registry.Attach(request.Task, request.Period, (request.Arg & 0x01) != 0, static_cast<TaskPriorityEnum>(request.Arg >> 1))
+					&& source != core)
+				{
+					// No room on this core, return the task to its source.
+					Send(source, core, request);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		/// <summary>
+		/// Detaches a task from the current core and queues it for attaching on the destination core.
+		/// The task is detached first, so it's never attached to both cores at once.
+		/// </summary>
+		/// <param name="fromCore">Current core, the task's.</param>
+		/// <param name="task">Task to migrate.</param>
+		/// <param name="toCore">Destination core.</param>
+		/// <returns>True if the task was handed over.</returns>
+		bool MigrateTask(const uint8_t fromCore, ITask* task, const uint8_t toCore)
+		{
+			CoreScheduler& registry = Cores[fromCore];
+			task_id_t taskId;
+			task_id_t assignedId;
+			if (toCore >= CoreCount
+				|| toCore == fromCore
+				|| !registry.GetTaskId(task, taskId)
+				|| task->GetAssignedTaskId(assignedId))
+			{
+				return false;
+			}
+
+			const bool enabled = registry.IsEnabled(taskId);
+			const TaskPriorityEnum priority = registry.GetPriority(taskId);
+			const Request request{ task, registry.GetPeriod(taskId), TASK_INVALID_ID, RequestEnum::Adopt,
+				uint8_t((uint8_t(priority) << 1) | (enabled ? 0x01 : 0x00)) };
+
+			registry.Detach(taskId);
+			if (!Send(toCore, fromCore, request))
+			{
+				// Mailbox full, keep the task here.
+				registry.Attach(task, request.Period, enabled, priority);
+				return false;
+			}
+
+			return true;
+		}
+
+		static uint8_t GetPercent(const uint32_t part, const uint32_t whole)
+		{
+			const uint64_t percent = (uint64_t(part) * 100) / whole;
+
+			return (percent < 100) ? uint8_t(percent) : 100;
+		}
+	};
+}
+#endif
@@ -50,6 +50,22 @@ namespace Harmonic
 		using Base::TaskCount;
 		using Base::Hot;
 		using Base::IdleSleep;
+		using Base::EndPass;
+		using Base::OnTaskRun;
+		using Base::RunningIndex;
+		using Base::EndTaskRun;
+		using Base::GetTaskBand;
+		using Base::GetBandStart;
+		using Base::ClearChanged;
+		using Base::TakeChangedHigher;
+		using Base::GetNextEnabledIndex;
+#if defined(HARMONIC_TASK_BUDGET)
+		using Base::StartBudgetPass;
+		using Base::GetNextBudgetIndex;
+		using Base::GetTaskBudget;
+		using Base::CheckTaskBudget;
+		using Base::IsPassBudgetSpent;
+#endif
 
 	public:
 		SchedulerNoProfiling() : Base(IdleSleepEnabled) {}
@@ -58,11 +74,12 @@ namespace Harmonic
 		/// Main scheduler loop without profiling.
 		/// 
 		/// Executes one scheduler iteration with minimal overhead:
-		/// 1. Checks each task and runs those that are due
-		/// 2. Optionally enters idle sleep if no tasks ran (when IdleSleepEnabled is true)
+		/// 1. Checks each task in priority order and runs those that are due
+		/// 2. After each run, re-checks the higher priority tasks it woke or rescheduled
+		/// 3. Optionally enters idle sleep if no tasks ran (when IdleSleepEnabled is true)
 		/// 
 		/// Performance characteristics:
-		/// - No timestamp reads (zero micros() overhead)
+		/// - No timestamp reads (zero micros() overhead), unless HARMONIC_TASK_BUDGET is defined
 		/// - No trace data accumulation (zero memory writes)
 		/// - Direct task dispatch (minimal branching)
 		/// 
@@ -82,38 +99,93 @@ namespace Harmonic
 		void Loop()
 		{
 			// Compile-time switch for idle sleep feature.
-			// Optimizer will eliminate the unused branch entirely.
+			// Optimizer will eliminate the unused branches entirely.
 			if (IdleSleepEnabled)
 			{
 				// Reset hot flag before checking tasks.
 				Hot = false;
+			}
+
+			// Only changes made during this pass count for the higher priority re-checks.
+			ClearChanged();
 
-				// Run all tasks that are due.
-				for (uint_fast8_t i = 0; i < TaskCount; i++)
+			// Run all tasks that are due.
+#if defined(HARMONIC_TASK_BUDGET)
+			// Higher priority bands first, then the band the last pass ran out of budget in, resumed where it stopped.
+			const task_id_t first = StartBudgetPass();
+			for (task_id_t n = 0, i = first; n < TaskCount; n++, i = GetNextBudgetIndex(i))
+#else
+			// Disabled tasks are skipped, a mask word at a time with HARMONIC_ENABLED_MASK.
+			for (task_id_t i = GetNextEnabledIndex(0); i < TaskCount; i = GetNextEnabledIndex(i + 1))
+#endif
+			{
+				if (RunTask(i))
 				{
-					if (Tasks[i].RunIfTime())
+					// Higher priority tasks woken or rescheduled during this run, without rescanning their bands.
+					const task_id_t higherEnd = GetBandStart(GetTaskBand(i));
+					for (task_id_t j = TakeChangedHigher(0, higherEnd); j < higherEnd; j = TakeChangedHigher(j + 1, higherEnd))
 					{
-						// Optimization: under heavy load, skip idle sleep checks.
-						Hot = true;
+						RunTask(j);
 					}
-				}
 
-				// Enter idle sleep only if no tasks ran and registry is stable.
-				// This reduces power consumption during idle periods.
-				if (!Hot)
-				{
-					IdleSleep();
+#if defined(HARMONIC_TASK_BUDGET)
+					// Defer the remaining tasks to the next pass.
+					if (IsPassBudgetSpent(GetNextBudgetIndex(i)))
+					{
+						break;
+					}
+#endif
 				}
 			}
-			else
+
+			// Enter idle sleep only if no tasks ran and registry is stable.
+			// This reduces power consumption during idle periods.
+			if (IdleSleepEnabled && !Hot)
 			{
-				// Idle sleep disabled: run tasks without hot flag tracking.
-				// This is the tightest possible scheduling loop.
-				for (uint_fast8_t i = 0; i < TaskCount; i++)
-				{
-					Tasks[i].RunIfTime();
-				}
+				IdleSleep();
+			}
+
+			EndPass();
+		}
+
+	private:
+		/// <summary>
+		/// Runs a task if it is due, tracking the hot state when idle sleep is enabled.
+		/// </summary>
+		/// <param name="index">Task index.</param>
+		/// <returns>True if the task ran.</returns>
+		bool RunTask(task_id_t index)
+		{
+#if defined(HARMONIC_TASK_BUDGET)
+			// Only budgeted tasks are timed.
+			const uint32_t budget = GetTaskBudget(index);
+			const uint32_t runStart = (budget != 0) ? Platform::GetProfilerTimestamp() : 0;
+#endif
+			RunningIndex = index;
+			const bool ran = Tasks[index].RunIfTime();
+			index = EndTaskRun(); // Moved if Run() attached a higher priority task.
+			if (!ran)
+			{
+				return false;
+			}
+
+#if defined(HARMONIC_TASK_BUDGET)
+			if (budget != 0)
+			{
+				CheckTaskBudget(index, Platform::GetProfilerTimestamp() - runStart, budget);
 			}
+#endif
+
+			if (IdleSleepEnabled)
+			{
+				// Optimization: under heavy load, skip idle sleep checks.
+				Hot = true;
+
+				// Keep the next deadline cache coherent.
+				OnTaskRun(index);
+			}
+
+			return true;
 		}
 	};
 }
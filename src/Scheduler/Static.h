@@ -0,0 +1,230 @@
+#ifndef _HARMONIC_SCHEDULER_STATIC_h
+#define _HARMONIC_SCHEDULER_STATIC_h
+
+#include "../Platform/Platform.h"
+#include "../Platform/Timestamp.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Entry of a StaticScheduler task table: a task type and its constant period.
+	/// The task type only needs a Run() method, it doesn't have to implement ITask.
+	/// </summary>
+	/// <typeparam name="TaskType">Default constructible task type, owned by the scheduler.</typeparam>
+	/// <typeparam name="Period">Minimum period between runs in time base ticks, 0 to run on every Loop() pass.</typeparam>
+	template<typename TaskType, uint32_t Period = 0>
+	struct StaticTask
+	{
+		static_assert(Period < (uint32_t(1) << 31), "Period must stay below 2^31 ticks.");
+
+		using Type = TaskType;
+		static constexpr uint32_t TaskPeriod = Period;
+	};
+
+	namespace Static
+	{
+		/// <summary>
+		/// Run state of a periodic table task: the timestamp of its last run.
+		/// </summary>
+		template<uint32_t Period>
+		struct TaskState
+		{
+			uint32_t LastRun = Platform::GetTimestamp();
+
+			/// <summary>
+			/// Returns true and moves the schedule forward if the task is due, with the same late bias and resync as TaskTracker.
+			/// </summary>
+			/// <param name="timestamp">Timestamp of the current pass.</param>
+			bool IsDueAndAdvance(const uint32_t timestamp)
+			{
+				const uint32_t elapsed = timestamp - LastRun;
+				if (elapsed > Period)
+				{
+					if (Period > 1 && ((elapsed >> 1) > Period))
+					{
+						// Missed more than one period, resync to now to avoid catch-up runs.
+						LastRun = timestamp;
+					}
+					else
+					{
+						LastRun += Period;
+					}
+
+					return true;
+				}
+
+				return false;
+			}
+
+			uint32_t TimeUntilNextRun(const uint32_t timestamp) const
+			{
+				const uint32_t elapsed = timestamp - LastRun;
+
+				return (elapsed >= Period) ? 0 : Period - elapsed;
+			}
+		};
+
+		/// <summary>
+		/// Run state of a table task with period 0: always due, no storage.
+		/// </summary>
+		template<>
+		struct TaskState<0>
+		{
+			bool IsDueAndAdvance(const uint32_t /*timestamp*/)
+			{
+				return true;
+			}
+
+			uint32_t TimeUntilNextRun(const uint32_t /*timestamp*/) const
+			{
+				return 0;
+			}
+		};
+
+		/// <summary>
+		/// Recursive task table storage, one task object and run state per entry, in entry order.
+		/// </summary>
+		template<typename... Entries>
+		struct TaskTable
+		{
+			static constexpr bool NeedsTimestamp = false;
+
+			void RunDue(const uint32_t /*timestamp*/) {}
+
+			uint32_t GetTimeUntilNextRun(const uint32_t /*timestamp*/) const
+			{
+				return UINT32_MAX;
+			}
+		};
+
+		template<typename Entry, typename... Rest>
+		struct TaskTable<Entry, Rest...> : TaskState<Entry::TaskPeriod>
+		{
+			using State = TaskState<Entry::TaskPeriod>;
+
+			/// <summary>
+			/// A timestamp read is only needed if any task has a period.
+			/// </summary>
+			static constexpr bool NeedsTimestamp = (Entry::TaskPeriod != 0) || TaskTable<Rest...>::NeedsTimestamp;
+
+			typename Entry::Type Task{};
+			TaskTable<Rest...> Next{};
+
+			void RunDue(const uint32_t timestamp)
+			{
+				if (State::IsDueAndAdvance(timestamp))
+				{
+					// Qualified call: never dispatched through a vtable, even if Run() is virtual.
+					Task.Entry::Type::Run();
+				}
+
+				Next.RunDue(timestamp);
+			}
+
+			uint32_t GetTimeUntilNextRun(const uint32_t timestamp) const
+			{
+				const uint32_t own = State::TimeUntilNextRun(timestamp);
+				if (own == 0)
+				{
+					return 0;
+				}
+
+				const uint32_t next = Next.GetTimeUntilNextRun(timestamp);
+
+				return (own < next) ? own : next;
+			}
+		};
+
+		/// <summary>
+		/// Compile-time access to the task at an index of a TaskTable.
+		/// </summary>
+		template<size_t Index, typename... Entries>
+		struct TableElement;
+
+		template<typename Entry, typename... Rest>
+		struct TableElement<0, Entry, Rest...>
+		{
+			using Type = typename Entry::Type;
+
+			static Type& Get(TaskTable<Entry, Rest...>& table)
+			{
+				return table.Task;
+			}
+		};
+
+		template<size_t Index, typename Entry, typename... Rest>
+		struct TableElement<Index, Entry, Rest...>
+		{
+			using Type = typename TableElement<Index - 1, Rest...>::Type;
+
+			static Type& Get(TaskTable<Entry, Rest...>& table)
+			{
+				return TableElement<Index - 1, Rest...>::Get(table.Next);
+			}
+		};
+	}
+
+	/// <summary>
+	/// StaticScheduler runs a task set fixed at compile time, from a table of StaticTask entries.
+	///
+	/// - Tasks are owned by the scheduler and run in entry order, each pass, when their constant period has elapsed.
+	/// - Run() is called directly and can be inlined: no virtual dispatch, no task pointers, no registry.
+	/// - Periods are template constants, only periodic tasks keep a 4 byte last run timestamp. Period 0 tasks cost no RAM.
+	/// - A single timestamp is read per Loop() pass, and none if all tasks have period 0.
+	/// - There is no Attach, Detach, enable or wake: tasks that must pause return early from Run().
+	/// - No built-in idle sleep: GetTimeUntilNextRun() gives the time an application may sleep for.
+	///
+	/// Example:
+	///   Harmonic::StaticScheduler<Harmonic::StaticTask<BlinkTask, 500>, Harmonic::StaticTask<SerialTask>> Runner{};
+	///   Runner.GetTask<0>().Setup();
+	///   Runner.Loop();
+	/// </summary>
+	/// <typeparam name="Entries">StaticTask entries, in run order.</typeparam>
+	template<typename... Entries>
+	class StaticScheduler
+	{
+	private:
+		using Table = Static::TaskTable<Entries...>;
+
+		Table Tasks{};
+
+	public:
+		/// <summary>
+		/// Number of tasks in the table.
+		/// </summary>
+		static constexpr size_t TaskCount = sizeof...(Entries);
+
+		/// <summary>
+		/// Runs every due task once, in entry order.
+		/// </summary>
+		void Loop()
+		{
+			Tasks.RunDue(Table::NeedsTimestamp ? Platform::GetTimestamp() : 0);
+
+#if defined(HARMONIC_HOST_VIRTUAL_TIME)
+			// There is no idle sleep to move the virtual clock, each pass costs 1 us.
+			Platform::Host::AdvanceVirtualMicros(1);
+#endif
+		}
+
+		/// <summary>
+		/// Returns the task at the given table index.
+		/// </summary>
+		template<size_t Index>
+		typename Static::TableElement<Index, Entries...>::Type& GetTask()
+		{
+			static_assert(Index < sizeof...(Entries), "Task index out of range.");
+
+			return Static::TableElement<Index, Entries...>::Get(Tasks);
+		}
+
+		/// <summary>
+		/// Returns the time in time base ticks until the next task is due, UINT32_MAX if the table is empty.
+		/// </summary>
+		uint32_t GetTimeUntilNextRun() const
+		{
+			return Tasks.GetTimeUntilNextRun(Platform::GetTimestamp());
+		}
+	};
+}
+#endif
@@ -5,34 +5,52 @@
 #include "NoProfiling.h"
 #include "BaseProfiling.h"
 #include "FullProfiling.h"
+#include "LatencyProfiling.h"
+#include "Deadline.h"
+#include "../Model/DispatchPolicy.h"
 
 namespace Harmonic
 {
 	namespace Selector
 	{
-		template<task_id_t MaxTaskCount, bool IdleSleepEnabled, ProfileLevelEnum  Level>
-		struct TemplateSchedulerSelector;
+		template<task_id_t MaxTaskCount, bool IdleSleepEnabled, ProfileLevelEnum  Level, DispatchPolicyEnum Dispatch>
+		struct TemplateSchedulerSelector
+		{
+			static_assert(Dispatch == DispatchPolicyEnum::Linear, "Deadline dispatch is only available with ProfileLevelEnum::None.");
+		};
 
 		template<task_id_t MaxTaskCount, bool IdleSleepEnabled>
-		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::None>
+		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::None, DispatchPolicyEnum::Linear>
 		{
 			using Type = SchedulerNoProfiling<MaxTaskCount, IdleSleepEnabled>;
 		};
 
 		template<task_id_t MaxTaskCount, bool IdleSleepEnabled>
-		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::Base>
+		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::Base, DispatchPolicyEnum::Linear>
 		{
 			using Type = SchedulerBaseProfiling<MaxTaskCount, IdleSleepEnabled>;
 		};
 
 		template<task_id_t MaxTaskCount, bool IdleSleepEnabled>
-		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::Full>
+		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::Full, DispatchPolicyEnum::Linear>
 		{
 			using Type = SchedulerFullProfiling<MaxTaskCount, IdleSleepEnabled>;
 		};
+
+		template<task_id_t MaxTaskCount, bool IdleSleepEnabled>
+		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::Latency, DispatchPolicyEnum::Linear>
+		{
+			using Type = SchedulerLatencyProfiling<MaxTaskCount, IdleSleepEnabled>;
+		};
+
+		template<task_id_t MaxTaskCount, bool IdleSleepEnabled>
+		struct TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, ProfileLevelEnum::None, DispatchPolicyEnum::Deadline>
+		{
+			using Type = SchedulerDeadline<MaxTaskCount, IdleSleepEnabled>;
+		};
 	}
 
-	template<task_id_t MaxTaskCount, bool IdleSleepEnabled = false, ProfileLevelEnum  Level = ProfileLevelEnum::None>
-	using TemplateScheduler = typename Selector::TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, Level>::Type;
+	template<task_id_t MaxTaskCount, bool IdleSleepEnabled = false, ProfileLevelEnum  Level = ProfileLevelEnum::None, DispatchPolicyEnum Dispatch = DispatchPolicyEnum::Linear>
+	using TemplateScheduler = typename Selector::TemplateSchedulerSelector<MaxTaskCount, IdleSleepEnabled, Level, Dispatch>::Type;
 }
 #endif
\ No newline at end of file
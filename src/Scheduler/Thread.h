@@ -0,0 +1,88 @@
+#ifndef _HARMONIC_SCHEDULER_THREAD_h
+#define _HARMONIC_SCHEDULER_THREAD_h
+
+#include "../Platform/Platform.h"
+#include "../Platform/IdleSleep.h"
+
+#if defined(HARMONIC_PLATFORM_OS)
+namespace Harmonic
+{
+	/// <summary>
+	/// SchedulerThread runs a scheduler's Loop() in its own RTOS thread, for preemptive scheduler tiers.
+	///
+	/// - Each tier is a separate scheduler, in a thread at its own RTOS priority: a woken task in a higher tier
+	///   preempts whatever a lower tier is running, while tasks within a tier stay cooperative.
+	/// - The scheduler must have idle sleep enabled, so its thread blocks while no task is due and lower tiers get to run.
+	///   #define HARMONIC_RTOS_NOTIFY is recommended, for cheap wakes and blocking without timeout while a tier is idle.
+	/// - Attach and Detach a tier's tasks from its own thread, or before Start().
+	///   SetEnabled, SetPeriod and WakeFromISR may be called from any thread or ISR, to hand work across tiers.
+	/// - Cross-tier calls rely on the global critical section, so don't combine with HARMONIC_MULTI_CORE.
+	///
+	/// Usage:
+	///   Harmonic::TemplateScheduler<4, true> FastTier{};
+	///   Harmonic::SchedulerThread<decltype(FastTier)> FastThread(FastTier);
+	///   FastThread.Start("fast", 3);
+	/// </summary>
+	/// <typeparam name="scheduler_t">Scheduler type, with a Loop() method.</typeparam>
+	template<typename scheduler_t>
+	class SchedulerThread
+	{
+	private:
+		scheduler_t& Scheduler;
+
+		TaskHandle_t Handle = nullptr;
+
+	public:
+		SchedulerThread(scheduler_t& scheduler) : Scheduler(scheduler) {}
+
+		/// <summary>
+		/// Creates the thread, running the scheduler until Stop().
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="name">Thread name, for RTOS debugging.</param>
+		/// <param name="priority">RTOS priority of the tier, higher preempts lower.</param>
+		/// <param name="stackDepth">Thread stack size, in the port's units (bytes on ESP32, words on other FreeRTOS ports).</param>
+		/// <returns>True if the thread was created, false if already running or out of memory.</returns>
+		bool Start(const char* name, const UBaseType_t priority, const uint32_t stackDepth = 2048)
+		{
+			if (Handle != nullptr)
+			{
+				return false;
+			}
+
+			return xTaskCreate(ThreadEntry, name, stackDepth, &Scheduler, priority, &Handle) == pdPASS;
+		}
+
+		/// <summary>
+		/// Deletes the thread. Must not be called from the thread itself, nor from an ISR.
+		/// </summary>
+		void Stop()
+		{
+			if (Handle != nullptr)
+			{
+				vTaskDelete(Handle);
+				Handle = nullptr;
+			}
+		}
+
+		/// <summary>
+		/// Returns the RTOS thread handle, nullptr if not started.
+		/// </summary>
+		TaskHandle_t GetHandle() const
+		{
+			return Handle;
+		}
+
+	private:
+		static void ThreadEntry(void* parameter)
+		{
+			scheduler_t& scheduler = *static_cast<scheduler_t*>(parameter);
+			while (true)
+			{
+				scheduler.Loop();
+			}
+		}
+	};
+}
+#endif
+#endif
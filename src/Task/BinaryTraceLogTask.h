@@ -0,0 +1,352 @@
+#ifndef _HARMONIC_BINARY_TRACE_LOG_TASK_h
+#define _HARMONIC_BINARY_TRACE_LOG_TASK_h
+
+#include "../Model/ITask.h"
+#include "../Model/Profiling.h"
+#include "../Model/TaskRegistry.h"
+
+#include <Print.h>
+
+namespace Harmonic
+{
+	namespace TraceLogging
+	{
+		/// <summary>
+		/// Binary trace frame layout, all fields little-endian:
+		/// - Sync: 0xA5 0x5A
+		/// - Version: uint8_t, BINARY_TRACE_VERSION
+		/// - Sequence: uint16_t, incremented per frame, to detect dropped frames
+		/// - TaskCount: uint8_t
+		/// - Global: Iterations, Scheduling (us), IdleSleep (us), 3 x uint32_t
+		/// - TaskCount x task record: TaskId uint16_t, Duration (us), MaxDuration (us), Iterations, 3 x uint32_t
+		/// - CRC: uint16_t CRC-16/CCITT-FALSE of every byte from Version to the last task record
+		/// Decoded by examples/BinaryTraceLog/decode_trace.py.
+		/// </summary>
+		static constexpr uint8_t BINARY_TRACE_SYNC_0 = 0xA5;
+		static constexpr uint8_t BINARY_TRACE_SYNC_1 = 0x5A;
+		static constexpr uint8_t BINARY_TRACE_VERSION = 1;
+		static constexpr uint8_t BINARY_TRACE_HEADER_SIZE = 6;
+		static constexpr uint8_t BINARY_TRACE_GLOBAL_SIZE = 12;
+		static constexpr uint8_t BINARY_TRACE_TASK_SIZE = 14;
+		static constexpr uint8_t BINARY_TRACE_CRC_SIZE = 2;
+
+		/// <summary>
+		/// Returns the binary trace frame size for a task count.
+		/// </summary>
+		static constexpr uint16_t GetBinaryTraceFrameSize(const uint8_t taskCount)
+		{
+			return BINARY_TRACE_HEADER_SIZE + BINARY_TRACE_GLOBAL_SIZE
+				+ (uint16_t(taskCount) * BINARY_TRACE_TASK_SIZE) + BINARY_TRACE_CRC_SIZE;
+		}
+
+		/// <summary>
+		/// CRC-16/CCITT-FALSE update (polynomial 0x1021, initial value 0xFFFF), bitwise to avoid a table in RAM.
+		/// </summary>
+		static uint16_t UpdateCrc16(uint16_t crc, const uint8_t data)
+		{
+			crc ^= static_cast<uint16_t>(data) << 8;
+			for (uint_fast8_t i = 0; i < 8; i++)
+			{
+				crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+			}
+
+			return crc;
+		}
+	}
+
+	/// <summary>
+	/// Full profiling trace logger, streaming compact binary frames instead of text.
+	///
+	/// - Each LogPeriod, snapshots the profiler trace into one frame (see TraceLogging binary layout).
+	/// - The frame is encoded on the fly and written in chunks of up to ChunkSize bytes, one chunk per Run().
+	///   While a frame is pending the task runs on every pass, then returns to LogPeriod.
+	/// - Writes are capped to the output's availableForWrite(), so they don't block on a full TX buffer.
+	///   Nothing is written while it reports 0, so the output must implement it. Short writes are retried on the next pass.
+	/// - RAM: the trace snapshot, plus ChunkSize bytes. No text formatting or division.
+	/// </summary>
+	/// <typeparam name="MaxTaskCount">Maximum number of task traces per frame, up to 255 (TaskCount is a single byte on the wire).</typeparam>
+	/// <typeparam name="LogPeriod">Frame period in milliseconds.</typeparam>
+	/// <typeparam name="ChunkSize">Maximum bytes written per Run().</typeparam>
+	template<uint8_t MaxTaskCount, uint32_t LogPeriod, uint8_t ChunkSize = 16>
+	class BinaryTraceLogTask : public ITask
+	{
+	private:
+		static_assert(ChunkSize > 0, "ChunkSize must be at least 1.");
+
+		/// <summary>
+		/// A reference to a Print object used for the binary output.
+		/// </summary>
+		Print& Output;
+
+		/// <summary>
+		/// Profiler source reference.
+		/// </summary>
+		Profiling::IFullProfiler& Profiler;
+
+		/// <summary>
+		/// Reference to the registry for managing this task.
+		/// </summary>
+		TaskRegistry& Registry;
+
+		/// <summary>
+		/// Unique identifier for this task within the registry.
+		/// Set during registration; TASK_INVALID_ID if unregistered.
+		/// </summary>
+		volatile task_id_t Id = TASK_INVALID_ID;
+
+	private:
+		Profiling::TaskTrace Traces[MaxTaskCount]{};
+		task_id_t TaskIds[MaxTaskCount]{};
+		Profiling::FullTrace Trace{};
+
+		uint8_t Chunk[ChunkSize]{};
+
+		/// <summary>
+		/// Encoded bytes in Chunk, and how many of them were written.
+		/// </summary>
+		uint8_t ChunkLength = 0;
+		uint8_t ChunkWritten = 0;
+
+		/// <summary>
+		/// Size of the pending frame, 0 when idle.
+		/// </summary>
+		uint16_t FrameSize = 0;
+		uint16_t FrameOffset = 0;
+		uint16_t Sequence = 0;
+		uint16_t Crc = 0;
+
+		/// <summary>
+		/// Task record cursor, avoids a division per encoded byte.
+		/// </summary>
+		uint8_t RecordIndex = 0;
+		uint8_t RecordOffset = 0;
+
+	public:
+		BinaryTraceLogTask(TaskRegistry& registry, Profiling::IFullProfiler& profiler, Print& output)
+			: ITask()
+			, Output(output)
+			, Profiler(profiler)
+			, Registry(registry)
+		{
+		}
+
+		void Run() override
+		{
+			if (FrameSize == 0)
+			{
+				if (!StartFrame())
+				{
+					return;
+				}
+
+				// Stream the chunks on every pass until the frame is complete.
+				Registry.SetPeriod(Id, 0);
+			}
+
+			WriteChunk();
+
+			if (FrameOffset >= FrameSize && ChunkWritten >= ChunkLength)
+			{
+				FrameSize = 0;
+				Sequence++;
+				Registry.SetPeriod(Id, Platform::MillisToTicks(LogPeriod));
+			}
+		}
+
+		bool Start()
+		{
+			FrameSize = 0;
+
+			return Registry.Attach(this, Platform::MillisToTicks(LogPeriod), true);
+		}
+
+		void Stop()
+		{
+			Registry.Detach(Id);
+		}
+
+		void OnTaskIdUpdated(const task_id_t taskId) final
+		{
+			// Store the assigned task ID for later use.
+			Id = taskId;
+		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+
+	private:
+		/// <summary>
+		/// Snapshots the profiler trace into a new frame.
+		/// </summary>
+		/// <returns>True if a frame is ready to stream.</returns>
+		bool StartFrame()
+		{
+			if (!Profiler.GetTrace(Trace, Traces, MaxTaskCount))
+			{
+				return false;
+			}
+
+			if (Trace.TaskCount > MaxTaskCount)
+			{
+				Trace.TaskCount = MaxTaskCount;
+			}
+
+			// Task IDs are snapshot with the traces, attach and detach may shift them while streaming.
+			for (uint_fast8_t i = 0; i < Trace.TaskCount; i++)
+			{
+				TaskIds[i] = Registry.GetTaskIdAt(i);
+			}
+
+			FrameSize = TraceLogging::GetBinaryTraceFrameSize(Trace.TaskCount);
+			FrameOffset = 0;
+			Crc = 0xFFFF;
+			RecordIndex = 0;
+			RecordOffset = 0;
+			ChunkLength = 0;
+			ChunkWritten = 0;
+
+			return true;
+		}
+
+		/// <summary>
+		/// Writes as much of the pending chunk as the output accepts, encoding the next chunk once it is fully written.
+		/// The encoder only moves forward, so bytes the output didn't take stay in Chunk until a later pass.
+		/// </summary>
+		void WriteChunk()
+		{
+			if (ChunkWritten >= ChunkLength)
+			{
+				uint16_t count = FrameSize - FrameOffset;
+				if (count > ChunkSize)
+				{
+					count = ChunkSize;
+				}
+
+				for (uint_fast8_t i = 0; i < count; i++)
+				{
+					Chunk[i] = GetNextByte();
+				}
+				ChunkLength = static_cast<uint8_t>(count);
+				ChunkWritten = 0;
+			}
+
+			const int available = Output.availableForWrite();
+			if (available <= 0)
+			{
+				// TX buffer full, retry on the next pass.
+				return;
+			}
+
+			uint8_t count = ChunkLength - ChunkWritten;
+			if (static_cast<unsigned int>(available) < count)
+			{
+				count = static_cast<uint8_t>(available);
+			}
+
+			ChunkWritten += static_cast<uint8_t>(Output.write(&Chunk[ChunkWritten], count));
+		}
+
+		/// <summary>
+		/// Encodes the byte at FrameOffset and advances, accumulating the CRC.
+		/// </summary>
+		uint8_t GetNextByte()
+		{
+			const uint16_t offset = FrameOffset++;
+			const uint16_t crcOffset = FrameSize - TraceLogging::BINARY_TRACE_CRC_SIZE;
+
+			if (offset >= crcOffset)
+			{
+				return GetByte(Crc, offset - crcOffset);
+			}
+
+			uint8_t value;
+			if (offset < TraceLogging::BINARY_TRACE_HEADER_SIZE)
+			{
+				switch (offset)
+				{
+				case 0:
+					return TraceLogging::BINARY_TRACE_SYNC_0;
+				case 1:
+					return TraceLogging::BINARY_TRACE_SYNC_1;
+				case 2:
+					value = TraceLogging::BINARY_TRACE_VERSION;
+					break;
+				case 3:
+				case 4:
+					value = GetByte(Sequence, offset - 3);
+					break;
+				default:
+					value = Trace.TaskCount;
+					break;
+				}
+			}
+			else if (offset < TraceLogging::BINARY_TRACE_HEADER_SIZE + TraceLogging::BINARY_TRACE_GLOBAL_SIZE)
+			{
+				const uint8_t field = offset - TraceLogging::BINARY_TRACE_HEADER_SIZE;
+				switch (field >> 2)
+				{
+				case 0:
+					value = GetByte(Trace.Iterations, field & 3);
+					break;
+				case 1:
+					value = GetByte(Trace.Scheduling, field & 3);
+					break;
+				default:
+					value = GetByte(Trace.IdleSleep, field & 3);
+					break;
+				}
+			}
+			else
+			{
+				value = GetTaskRecordByte();
+			}
+
+			Crc = TraceLogging::UpdateCrc16(Crc, value);
+
+			return value;
+		}
+
+		uint8_t GetTaskRecordByte()
+		{
+			const Profiling::TaskTrace& trace = Traces[RecordIndex];
+			uint8_t value;
+			if (RecordOffset < 2)
+			{
+				value = GetByte(static_cast<uint16_t>(TaskIds[RecordIndex]), RecordOffset);
+			}
+			else
+			{
+				const uint8_t field = RecordOffset - 2;
+				switch (field >> 2)
+				{
+				case 0:
+					value = GetByte(trace.Duration, field & 3);
+					break;
+				case 1:
+					value = GetByte(trace.MaxDuration, field & 3);
+					break;
+				default:
+					value = GetByte(trace.Iterations, field & 3);
+					break;
+				}
+			}
+
+			if (++RecordOffset >= TraceLogging::BINARY_TRACE_TASK_SIZE)
+			{
+				RecordOffset = 0;
+				RecordIndex++;
+			}
+
+			return value;
+		}
+
+		static uint8_t GetByte(const uint32_t value, const uint8_t index)
+		{
+			return static_cast<uint8_t>(value >> (index * 8));
+		}
+	};
+}
+#endif
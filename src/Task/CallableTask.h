@@ -60,6 +60,49 @@ namespace Harmonic
 			}
 		}
 	};
+
+	/// <summary>
+	/// A DynamicTask bound to a callable type at compile time: a lambda, functor or function pointer.
+	///
+	/// Notes:
+	///  - Run() calls the stored callable directly, no runtime branch. Stateless lambdas inline into Run().
+	///  - Stores only the callable: 1 byte for a stateless lambda, its captures otherwise.
+	///  - Context is captured by the lambda, e.g. [&sensor]() { sensor.Update(); }.
+	///  - Create with MakeTask(registry, callable), as the lambda type can't be named.
+	/// </summary>
+	/// <typeparam name="Callable">Callable type invocable as void().</typeparam>
+	template<typename Callable>
+	class TemplateCallableTask final : public ExposedDynamicTask
+	{
+	private:
+		Callable Run_;
+
+	public:
+		TemplateCallableTask(TaskRegistry& registry, const Callable& runCallable)
+			: ExposedDynamicTask(registry)
+			, Run_(runCallable)
+		{
+		}
+
+		void Run() final
+		{
+			Run_();
+		}
+	};
+
+	/// <summary>
+	/// Creates a TemplateCallableTask for the callable's type.
+	/// Example:
+	///   auto BlinkTask = Harmonic::MakeTask(Runner, []() { digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN)); });
+	/// </summary>
+	/// <param name="registry">TaskRegistry for the task.</param>
+	/// <param name="runCallable">Callable invocable as void(). Function names decay to function pointers.</param>
+	/// <returns>Unattached task, call Attach() before use.</returns>
+	template<typename Callable>
+	TemplateCallableTask<Callable> MakeTask(TaskRegistry& registry, Callable runCallable)
+	{
+		return TemplateCallableTask<Callable>(registry, runCallable);
+	}
 }
 
-#endif
\ No newline at end of file
+#endif
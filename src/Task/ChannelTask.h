@@ -0,0 +1,254 @@
+#ifndef _HARMONIC_CHANNEL_TASK_h
+#define _HARMONIC_CHANNEL_TASK_h
+
+#include "InterruptBufferTask.h"
+
+namespace Harmonic
+{
+	namespace Channel
+	{
+		/// <summary>
+		/// Read-only view of the messages drained in one batch, oldest first.
+		/// Only valid during the OnMessages() call.
+		/// </summary>
+		/// <typeparam name="message_t">Message type.</typeparam>
+		template<typename message_t>
+		using MessageBatch = InterruptBuffer::EventBatch<message_t>;
+
+		/// <summary>
+		/// Interface for receiving channel messages from CallbackTask.
+		/// </summary>
+		/// <typeparam name="message_t">Message type.</typeparam>
+		template<typename message_t>
+		struct ChannelListener
+		{
+			/// <summary>
+			/// Called from main context (loop) with every message posted since the last call.
+			/// </summary>
+			/// <param name="messages">Posted messages, oldest first.</param>
+			/// <param name="droppedCount">Messages dropped since the last call because the channel was full.</param>
+			virtual void OnMessages(const MessageBatch<message_t>& messages, const uint32_t droppedCount) = 0;
+		};
+
+		/// <summary>
+		/// Fixed-capacity message channel, owned by its consumer task.
+		///
+		/// - Post(message) copies the message into the channel and wakes the consumer: no shared globals, no heap.
+		/// - The consumer is disabled while the channel is empty. Only the first message of a batch wakes it,
+		///   later posts just store the message: a pipeline stage runs once per batch, not once per message.
+		/// - Run() hands every pending message to OnMessages() in a single call, then frees the slots.
+		/// - Any number of producers, tasks or ISRs: each post holds a critical section for the message copy only.
+		///   Keep messages small, or post pointers/indices to static storage.
+		/// - When the channel is full, messages are dropped and counted, the count is reported with the next batch.
+		/// - For a single ISR producer with no critical section, see InterruptBuffer::CallbackTask.
+		///
+		/// Thread/ISR Safety:
+		///   - Start, Stop: May be called at any time, but NOT from an ISR.
+		///   - Post, GetPendingCount, GetDroppedCount: Safe to call at any time, including from an ISR.
+		/// </summary>
+		/// <typeparam name="message_t">Message type, copied in and out of the channel.</typeparam>
+		/// <typeparam name="Capacity">Channel capacity in messages, a power of 2 up to 128.</typeparam>
+		template<typename message_t, uint8_t Capacity = 8>
+		class ConsumerTask : public DynamicTask
+		{
+		private:
+			static_assert(Capacity > 0 && Capacity <= 128 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2, up to 128");
+
+			/// <summary>
+			/// Index mask. Head and Tail run freely, wrapping at 256, a multiple of Capacity.
+			/// </summary>
+			static constexpr uint8_t Mask = Capacity - 1;
+
+		private:
+			message_t Buffer[Capacity]{};
+
+			/// <summary>
+			/// Post count, only written by producers, under guard.
+			/// </summary>
+			volatile uint8_t Head = 0;
+
+			/// <summary>
+			/// Drain count, only written by the consumer.
+			/// </summary>
+			volatile uint8_t Tail = 0;
+
+			/// <summary>
+			/// Dropped message count, only written by producers, under guard.
+			/// </summary>
+			volatile uint32_t DroppedCount = 0;
+
+			/// <summary>
+			/// Dropped message count already reported to the consumer.
+			/// </summary>
+			uint32_t ReportedDroppedCount = 0;
+
+		public:
+			ConsumerTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+			/// <summary>
+			/// Attaches the consumer, disabled until the first post.
+			/// Discards any pending messages.
+			/// </summary>
+			/// <param name="priority">Priority class of the consumer.</param>
+			/// <returns>True on success.</returns>
+			bool Start(const TaskPriorityEnum priority = TaskPriorityEnum::Normal)
+			{
+				if (!Attach(0, false, priority))
+				{
+					return false;
+				}
+
+				Platform::AtomicGuard guard;
+				Tail = Head;
+				ReportedDroppedCount = DroppedCount;
+
+				return true;
+			}
+
+			/// <summary>
+			/// Detaches the consumer. Later posts are rejected.
+			/// </summary>
+			void Stop()
+			{
+				Detach();
+			}
+
+			/// <summary>
+			/// Copies a message into the channel and wakes the consumer.
+			/// If the channel is full, the message is dropped and counted.
+			/// </summary>
+			/// <param name="message">Message to post.</param>
+			/// <returns>True if the message was queued, false if dropped or the consumer isn't started.</returns>
+			bool Post(const message_t& message)
+			{
+				if (Id == TASK_INVALID_ID)
+				{
+					return false;
+				}
+
+				bool wake;
+				{
+					Platform::AtomicGuard guard;
+					const uint8_t head = Head;
+					const uint8_t tail = Tail;
+					if ((uint8_t)(head - tail) >= Capacity)
+					{
+						DroppedCount = DroppedCount + 1;
+						return false;
+					}
+
+					Buffer[head & Mask] = message;
+					Head = head + 1;
+					wake = head == tail;
+				}
+
+				// Only the first message of a batch needs to wake the consumer.
+				if (wake)
+				{
+					WakeFromISR();
+				}
+
+				return true;
+			}
+
+			/// <summary>
+			/// Returns the number of messages waiting for the consumer.
+			/// </summary>
+			uint8_t GetPendingCount() const
+			{
+				return (uint8_t)(Head - Tail);
+			}
+
+			/// <summary>
+			/// Returns the total number of messages dropped because the channel was full.
+			/// </summary>
+			uint32_t GetDroppedCount() const
+			{
+				Platform::AtomicGuard guard;
+
+				return DroppedCount;
+			}
+
+		public:
+			/// <summary>
+			/// Called by the scheduler to drain the pending messages to OnMessages().
+			/// </summary>
+			void Run() final
+			{
+				uint8_t head;
+				uint32_t droppedCount;
+				{
+					Platform::AtomicGuard guard;
+					head = Head;
+					droppedCount = DroppedCount;
+				}
+
+				// Slots up to head are only rewritten once Tail is released, no guard needed to read them.
+				const uint8_t tail = Tail;
+				const uint8_t count = head - tail;
+				const uint32_t dropped = droppedCount - ReportedDroppedCount;
+				if (count > 0 || dropped > 0)
+				{
+					OnMessages(MessageBatch<message_t>(Buffer, tail, count, Mask), dropped);
+				}
+				ReportedDroppedCount = droppedCount;
+
+				Platform::MemoryBarrier(); // Release the slots only after the messages were read.
+				Tail = head;
+
+				// Sleep until the next post wakes the consumer, unless one was posted since the drain.
+				SetEnabled(false);
+				if (Head != head)
+				{
+					SetEnabled(true);
+				}
+			}
+
+		protected:
+			/// <summary>
+			/// Consumer body, called with every message posted since the last call.
+			/// </summary>
+			/// <param name="messages">Posted messages, oldest first.</param>
+			/// <param name="droppedCount">Messages dropped since the last call because the channel was full.</param>
+			virtual void OnMessages(const MessageBatch<message_t>& messages, const uint32_t droppedCount) = 0;
+		};
+
+		/// <summary>
+		/// Channel consumer forwarding each batch to a ChannelListener, for composition instead of inheritance.
+		/// </summary>
+		/// <typeparam name="message_t">Message type, copied in and out of the channel.</typeparam>
+		/// <typeparam name="Capacity">Channel capacity in messages, a power of 2 up to 128.</typeparam>
+		template<typename message_t, uint8_t Capacity = 8>
+		class CallbackTask final : public ConsumerTask<message_t, Capacity>
+		{
+		private:
+			ChannelListener<message_t>* Listener = nullptr;
+
+		public:
+			CallbackTask(TaskRegistry& registry) : ConsumerTask<message_t, Capacity>(registry) {}
+
+			/// <summary>
+			/// Sets the listener and starts the consumer.
+			/// </summary>
+			/// <param name="listener">Pointer to the listener implementation.</param>
+			/// <param name="priority">Priority class of the consumer.</param>
+			/// <returns>True on success.</returns>
+			bool AttachListener(ChannelListener<message_t>* listener, const TaskPriorityEnum priority = TaskPriorityEnum::Normal)
+			{
+				Listener = listener;
+
+				return ConsumerTask<message_t, Capacity>::Start(priority);
+			}
+
+		protected:
+			void OnMessages(const MessageBatch<message_t>& messages, const uint32_t droppedCount) final
+			{
+				if (Listener != nullptr)
+				{
+					Listener->OnMessages(messages, droppedCount);
+				}
+			}
+		};
+	}
+}
+#endif
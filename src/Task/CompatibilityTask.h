@@ -8,6 +8,7 @@
 /// Wrapper for TaskScheduler::Scheduler and TaskScheduler::Task, for migration and testing purposes, wrapped in a Harmonic::DynamicTask.
 /// Covers the core scheduling, iteration, and enable/disable logic of the original TaskScheduler::Task.
 /// However, it does not implement features such as chaining, dynamic scheduler assignment, or function - pointer - based callbacks.
+/// Intervals and delays are in milliseconds, as in TaskScheduler, and converted to the scheduler time base.
 /// </summary>
 namespace TS
 {
@@ -21,7 +22,7 @@ namespace TS
 	{
 	private:
 		Harmonic::TaskRegistry& Registry;
-		Harmonic::task_id_t Id = UINT8_MAX;
+		Harmonic::task_id_t Id = Harmonic::TASK_INVALID_ID;
 
 		uint32_t Iterations = 0;
 		int32_t TargetIterations = INT32_MAX;
@@ -44,7 +45,7 @@ namespace TS
 			TargetIterations = aIterations;
 			if (aScheduler)
 			{
-				Registry.Attach(this, aInterval, aEnable);
+				Registry.Attach(this, Harmonic::Platform::MillisToTicks(aInterval), aEnable);
 			}
 		}
 
@@ -54,6 +55,12 @@ namespace TS
 			Id = taskId;
 		}
 
+		bool GetAssignedTaskId(Harmonic::task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+
 		virtual bool Callback() = 0;
 
 		void Run() final
@@ -95,7 +102,7 @@ namespace TS
 			{
 				OnEnable();
 			}
-			Registry.SetPeriodAndEnabled(Id, aDelay, true);
+			Registry.SetPeriodAndEnabled(Id, Harmonic::Platform::MillisToTicks(aDelay), true);
 			return isEnabled();
 		}
 
@@ -120,19 +127,19 @@ namespace TS
 				OnEnable();
 			}
 			Registry.SetPeriodAndEnabled(Id, 0, false);
-			Registry.SetPeriodAndEnabled(Id, aDelay, true);
+			Registry.SetPeriodAndEnabled(Id, Harmonic::Platform::MillisToTicks(aDelay), true);
 			return isEnabled();
 		}
 
 		void delay(unsigned long aDelay = 0)
 		{
-			Registry.SetPeriod(Id, aDelay);
+			Registry.SetPeriod(Id, Harmonic::Platform::MillisToTicks(aDelay));
 		}
 
 		void adjust(long aInterval)
 		{
 			Registry.SetPeriodAndEnabled(Id, 0, false);
-			Registry.SetPeriodAndEnabled(Id, aInterval, true);
+			Registry.SetPeriodAndEnabled(Id, Harmonic::Platform::MillisToTicks(aInterval), true);
 		}
 
 		void forceNextIteration()
@@ -178,24 +185,24 @@ namespace TS
 		void set(unsigned long aInterval, long aIterations)
 		{
 			TargetIterations = aIterations;
-			Registry.SetPeriod(Id, aInterval);
+			Registry.SetPeriod(Id, Harmonic::Platform::MillisToTicks(aInterval));
 		}
 
 		void setInterval(unsigned long aInterval)
 		{
-			Registry.SetPeriod(Id, aInterval);
+			Registry.SetPeriod(Id, Harmonic::Platform::MillisToTicks(aInterval));
 		}
 
 		void setIntervalNodelay(unsigned long aInterval, unsigned int aOption)
 		{
 			const bool enabled = Registry.IsEnabled(Id);
 			Registry.SetPeriodAndEnabled(Id, 0, false);
-			Registry.SetPeriodAndEnabled(Id, aInterval, enabled);
+			Registry.SetPeriodAndEnabled(Id, Harmonic::Platform::MillisToTicks(aInterval), enabled);
 		}
 
 		unsigned long getInterval()
 		{
-			return Registry.GetPeriod(Id);
+			return Harmonic::Platform::TicksToMillis(Registry.GetPeriod(Id));
 		}
 
 		void setIterations(long aIterations)
@@ -0,0 +1,163 @@
+#ifndef _HARMONIC_COROUTINE_TASK_h
+#define _HARMONIC_COROUTINE_TASK_h
+
+#include "DynamicTask.h"
+
+// Starts the coroutine body, inside RunCoroutine(). Resumes from the last yield, sleep or wait.
+#define HARMONIC_COROUTINE_BEGIN() switch (ResumePoint) { case 0:
+
+// Ends the coroutine body: the task is disabled, IsDone() becomes true until Start() again.
+#define HARMONIC_COROUTINE_END() } ResumePoint = Harmonic::CoroutineTask::DonePoint; FinishStep()
+
+// Returns to the scheduler, resuming on the next Loop() pass.
+#define HARMONIC_YIELD() do { ResumePoint = __LINE__; YieldStep(); return; case __LINE__:; } while (0)
+
+// Returns to the scheduler, resuming after the given delay in milliseconds, never early.
+#define HARMONIC_SLEEP_FOR(millis) do { ResumePoint = __LINE__; SleepStep(Harmonic::Platform::MillisToTicks(millis)); return; case __LINE__:; } while (0)
+
+// Marks the resume label fall through as intended, for -Wimplicit-fallthrough.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 7)
+#define HARMONIC_COROUTINE_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define HARMONIC_COROUTINE_FALLTHROUGH
+#endif
+
+// Resumes past this point only once the condition is true. While false, the task is disabled until Notify().
+// The condition is checked again after disabling, so a Notify() racing the check is never lost.
+#define HARMONIC_WAIT_UNTIL(condition) do { ResumePoint = __LINE__; HARMONIC_COROUTINE_FALLTHROUGH; case __LINE__: if (!(condition)) { WaitStep(); if (!(condition)) return; } } while (0)
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Resumable task base, for long jobs written as straight-line code: multi-step init, handshakes, flash writes.
+	///
+	/// - Override RunCoroutine(), with the body between HARMONIC_COROUTINE_BEGIN() and HARMONIC_COROUTINE_END().
+	/// - HARMONIC_YIELD() runs again next pass (period 0), HARMONIC_SLEEP_FOR(ms) sets the period to the delay,
+	///   HARMONIC_WAIT_UNTIL(condition) disables the task until Notify(). Waiting and finished tasks are off the dispatch path,
+	///   skipped a mask word at a time with HARMONIC_ENABLED_MASK.
+	/// - Protothread style (stackless, a switch on the resume line): works on any C++11 toolchain, 2 bytes of state.
+	///   Local variables don't survive a yield, sleep or wait: keep state in members.
+	///   The body can't use switch statements spanning those macros.
+	///
+	/// Thread/ISR Safety:
+	///   - Start, Stop: May be called at any time, but NOT from an ISR.
+	///   - Notify: Safe to call at any time, including from an ISR.
+	/// </summary>
+	class CoroutineTask : public DynamicTask
+	{
+	public:
+		/// <summary>
+		/// Resume point of a finished coroutine, never a source line.
+		/// </summary>
+		static constexpr uint16_t DonePoint = UINT16_MAX;
+
+	protected:
+		/// <summary>
+		/// Source line to resume from, 0 to start from the beginning.
+		/// </summary>
+		uint16_t ResumePoint = 0;
+
+	private:
+		/// <summary>
+		/// Timestamp the current sleep ends at, in time base ticks.
+		/// </summary>
+		uint32_t WakeTime = 0;
+
+		bool Sleeping = false;
+
+	public:
+		CoroutineTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+		/// <summary>
+		/// Starts the coroutine from the beginning on the next pass, attaching it if needed.
+		/// </summary>
+		/// <param name="priority">Priority class, if the task gets attached.</param>
+		/// <returns>True on success.</returns>
+		bool Start(const TaskPriorityEnum priority = TaskPriorityEnum::Normal)
+		{
+			ResumePoint = 0;
+			Sleeping = false;
+			if (Id == TASK_INVALID_ID)
+			{
+				return Attach(0, true, priority);
+			}
+
+			WakeFromISR();
+
+			return true;
+		}
+
+		/// <summary>
+		/// Detaches the coroutine, abandoning it where it is.
+		/// </summary>
+		void Stop()
+		{
+			Detach();
+		}
+
+		/// <summary>
+		/// Resumes a waiting coroutine, to check its condition again.
+		/// Safe to call at any time after registration, including from an ISR.
+		/// </summary>
+		void Notify()
+		{
+			WakeFromISR();
+		}
+
+		/// <summary>
+		/// Returns true once the coroutine reached HARMONIC_COROUTINE_END().
+		/// </summary>
+		bool IsDone() const
+		{
+			return ResumePoint == DonePoint;
+		}
+
+		void Run() final
+		{
+			if (Sleeping)
+			{
+				// Woken early, by Notify() or an earlier due time: sleep for the rest.
+				const int32_t remaining = static_cast<int32_t>(WakeTime - Platform::GetTimestamp());
+				if (remaining > 0)
+				{
+					SleepStep(static_cast<uint32_t>(remaining));
+					return;
+				}
+				Sleeping = false;
+			}
+
+			RunCoroutine();
+		}
+
+	protected:
+		/// <summary>
+		/// Coroutine body, between HARMONIC_COROUTINE_BEGIN() and HARMONIC_COROUTINE_END().
+		/// </summary>
+		virtual void RunCoroutine() = 0;
+
+		void YieldStep()
+		{
+			SetPeriodAndEnabled(0, true);
+		}
+
+		void SleepStep(const uint32_t delay)
+		{
+			WakeTime = Platform::GetTimestamp() + delay;
+			Sleeping = true;
+			SetPeriodAndEnabled(delay, true);
+			SetPhase(delay);
+		}
+
+		void WaitStep()
+		{
+			SetEnabled(false);
+		}
+
+		void FinishStep()
+		{
+			Sleeping = false;
+			SetEnabled(false);
+		}
+	};
+}
+#endif
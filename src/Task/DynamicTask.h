@@ -44,12 +44,14 @@ namespace Harmonic
 		/// Registers this task with the registry and sets its initial schedule.
 		/// May be called at any time, but NOT from an ISR.
 		/// </summary>
-		/// <param name="period">Initial execution period in milliseconds.</param>
+		/// <param name="period">Initial execution period in time base ticks.</param>
 		/// <param name="enabled">Initial enabled state.</param>
+		/// <param name="priority">Priority class of the task.</param>
+		/// <param name="phase">Delay of the first run in time base ticks, clamped to the period. Defaults to a full period.</param>
 		/// <returns>True if registration succeeded, false otherwise.</returns>
-		bool Attach(const uint32_t period = 0, const bool enabled = true)
+		bool Attach(const uint32_t period = 0, const bool enabled = true, const TaskPriorityEnum priority = TaskPriorityEnum::Normal, const uint32_t phase = UINT32_MAX)
 		{
-			return Registry.Attach(this, period, enabled);
+			return Registry.Attach(this, period, enabled, priority, phase);
 		}
 
 		/// <summary>
@@ -73,6 +75,12 @@ namespace Harmonic
 			Id = taskId;
 		}
 
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+
 		/// <summary>
 		/// Returns true if this task is currently enabled in the registry.
 		/// Safe to call at any time after registration.
@@ -93,7 +101,7 @@ namespace Harmonic
 		}
 
 		/// <summary>
-		/// Returns the current period for this task in milliseconds.
+		/// Returns the current period for this task in time base ticks.
 		/// Safe to call at any time after registration.
 		/// </summary>
 		uint32_t GetPeriod() const
@@ -101,11 +109,32 @@ namespace Harmonic
 			return Registry.GetPeriod(Id);
 		}
 
+		/// <summary>
+		/// Returns the priority class of this task.
+		/// Safe to call at any time after registration.
+		/// </summary>
+		TaskPriorityEnum GetPriority() const
+		{
+			return Registry.GetPriority(Id);
+		}
+
+#if defined(HARMONIC_TASK_BUDGET)
+		/// <summary>
+		/// Sets the execution time budget of this task. Overruns are reported to the registry's budget listener.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		/// <param name="budget">Budget per run in microseconds, 0 for no budget.</param>
+		void SetBudget(const uint32_t budget)
+		{
+			Registry.SetBudget(Id, budget);
+		}
+#endif
+
 		/// <summary>
 		/// Sets the execution period for this task.
 		/// Safe to call at any time after registration, including from an ISR.
 		/// </summary>
-		/// <param name="period">New execution period in milliseconds.</param>
+		/// <param name="period">New execution period in time base ticks.</param>
 		void SetPeriod(const uint32_t period)
 		{
 			Registry.SetPeriod(Id, period);
@@ -125,13 +154,23 @@ namespace Harmonic
 		/// Sets both the execution period and enabled state for this task.
 		/// Safe to call at any time after registration, including from an ISR.
 		/// </summary>
-		/// <param name="period">New execution period in milliseconds.</param>
+		/// <param name="period">New execution period in time base ticks.</param>
 		/// <param name="enabled">True to enable, false to disable.</param>
 		void SetPeriodAndEnabled(const uint32_t period, const bool enabled)
 		{
 			Registry.SetPeriodAndEnabled(Id, period, enabled);
 		}
 
+		/// <summary>
+		/// Restarts this task's period so its next run is due phase ticks from now, then every period.
+		/// Safe to call at any time after registration, including from an ISR.
+		/// </summary>
+		/// <param name="phase">Delay of the next run in time base ticks, clamped to the period.</param>
+		void SetPhase(const uint32_t phase)
+		{
+			Registry.SetPhase(Id, phase);
+		}
+
 		/// <summary>
 		/// Wakes the scheduler and sets the task to run immediately.
 		/// Safe to call at any time after registration, including from an ISR.
@@ -31,12 +31,13 @@ namespace Harmonic
 		/// Registers this task with the registry and sets its initial schedule.
 		/// May be called at any time after construction, but NOT from an ISR.
 		/// </summary>
-		/// <param name="period">Initial execution period in milliseconds.</param>
+		/// <param name="period">Initial execution period in time base ticks.</param>
 		/// <param name="enabled">Initial enabled state.</param>
+		/// <param name="priority">Priority class of the task.</param>
 		/// <returns>True if registration succeeded, false otherwise.</returns>
-		bool Attach(const uint32_t period = 0, const bool enabled = true)
+		bool Attach(const uint32_t period = 0, const bool enabled = true, const TaskPriorityEnum priority = TaskPriorityEnum::Normal)
 		{
-			return DynamicTask::Attach(period, enabled);
+			return DynamicTask::Attach(period, enabled, priority);
 		}
 
 		/// <summary>
@@ -70,7 +71,7 @@ namespace Harmonic
 		}
 
 		/// <summary>
-		/// Returns the current period for this task in milliseconds.
+		/// Returns the current period for this task in time base ticks.
 		/// Safe to call at any time after registration.
 		/// </summary>
 		uint32_t GetPeriod() const
@@ -82,7 +83,7 @@ namespace Harmonic
 		/// Sets the execution period for this task.
 		/// Safe to call at any time after registration, including from an ISR.
 		/// </summary>
-		/// <param name="period">New execution period in milliseconds.</param>
+		/// <param name="period">New execution period in time base ticks.</param>
 		void SetPeriod(const uint32_t period)
 		{
 			DynamicTask::SetPeriod(period);
@@ -102,7 +103,7 @@ namespace Harmonic
 		/// Sets both the execution period and enabled state for this task.
 		/// Safe to call at any time after registration, including from an ISR.
 		/// </summary>
-		/// <param name="period">New execution period in milliseconds.</param>
+		/// <param name="period">New execution period in time base ticks.</param>
 		/// <param name="enabled">True to enable, false to disable.</param>
 		void SetPeriodAndEnabled(const uint32_t period, const bool enabled)
 		{
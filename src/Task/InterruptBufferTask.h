@@ -0,0 +1,219 @@
+#ifndef _HARMONIC_INTERRUPT_BUFFER_TASK_h
+#define _HARMONIC_INTERRUPT_BUFFER_TASK_h
+
+#include "DynamicTask.h"
+
+namespace Harmonic
+{
+	namespace InterruptBuffer
+	{
+		/// <summary>
+		/// Read-only view of the events drained in one batch, in the order they were pushed.
+		/// Only valid during the listener call.
+		/// </summary>
+		/// <typeparam name="payload_t">Event payload type.</typeparam>
+		template<typename payload_t>
+		class EventBatch
+		{
+		private:
+			const payload_t* Buffer;
+			const uint8_t Start;
+			const uint8_t Count;
+			const uint8_t Mask;
+
+		public:
+			EventBatch(const payload_t* buffer, const uint8_t start, const uint8_t count, const uint8_t mask)
+				: Buffer(buffer)
+				, Start(start)
+				, Count(count)
+				, Mask(mask)
+			{
+			}
+
+			/// <summary>
+			/// Returns the number of events in the batch.
+			/// </summary>
+			uint8_t GetCount() const
+			{
+				return Count;
+			}
+
+			/// <summary>
+			/// Returns the event at the given position, 0 being the oldest.
+			/// </summary>
+			/// <param name="index">Position in the batch, lower than GetCount().</param>
+			const payload_t& operator[](const uint8_t index) const
+			{
+				return Buffer[(uint8_t)(Start + index) & Mask];
+			}
+		};
+
+		/// <summary>
+		/// Interface for receiving buffered interrupt events from CallbackTask.
+		/// </summary>
+		/// <typeparam name="payload_t">Event payload type.</typeparam>
+		template<typename payload_t>
+		struct InterruptListener
+		{
+			/// <summary>
+			/// Called from main context (loop) with every event pushed since the last call.
+			/// </summary>
+			/// <param name="events">Buffered events, oldest first.</param>
+			/// <param name="overflowCount">Events dropped since the last call because the buffer was full.</param>
+			virtual void OnBufferInterrupt(const EventBatch<payload_t>& events, const uint32_t overflowCount) = 0;
+		};
+
+		/// <summary>
+		/// CallbackTask buffers every interrupt event in a lock-free ring buffer.
+		///
+		/// - Use OnInterrupt(payload) from an ISR to push an event (e.g. a capture timestamp) and wake the scheduler.
+		/// - The Run() method drains all buffered events to the listener in a single call.
+		/// - Single producer (one ISR), single consumer (the task): pushes never disable interrupts.
+		/// - Only the first event of a batch wakes the scheduler, later pushes just store the event.
+		/// - When the buffer is full, events are dropped and counted, the count is reported with the next batch.
+		/// </summary>
+		/// <typeparam name="payload_t">Event payload type, copied in and out of the buffer.</typeparam>
+		/// <typeparam name="Capacity">Buffer capacity in events, a power of 2 up to 128.</typeparam>
+		template<typename payload_t, uint8_t Capacity = 16>
+		class CallbackTask final : public DynamicTask
+		{
+		private:
+			static_assert(Capacity > 0 && Capacity <= 128 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2, up to 128");
+
+			/// <summary>
+			/// Index mask. Head and Tail run freely, wrapping at 256, a multiple of Capacity.
+			/// </summary>
+			static constexpr uint8_t Mask = Capacity - 1;
+
+		private:
+			payload_t Buffer[Capacity]{};
+
+			/// <summary>
+			/// Push count, only written by the ISR.
+			/// </summary>
+			volatile uint8_t Head = 0;
+
+			/// <summary>
+			/// Pop count, only written by the task.
+			/// </summary>
+			volatile uint8_t Tail = 0;
+
+			/// <summary>
+			/// Dropped event count, only written by the ISR.
+			/// </summary>
+			volatile uint32_t OverflowCount = 0;
+
+			/// <summary>
+			/// Dropped event count already reported to the listener.
+			/// </summary>
+			uint32_t ReportedOverflowCount = 0;
+
+		private:
+			InterruptListener<payload_t>* Listener = nullptr;
+
+		public:
+			CallbackTask(TaskRegistry& registry) : DynamicTask(registry) {}
+
+			/// <summary>
+			/// Attaches an InterruptListener to receive buffered events.
+			/// Discards any buffered events. Not safe to call while the ISR may push.
+			/// </summary>
+			/// <param name="listener">Pointer to the listener implementation.</param>
+			/// <returns>True if successfully attached, false otherwise.</returns>
+			bool AttachListener(InterruptListener<payload_t>* listener)
+			{
+				// Registers this task with the scheduler using:
+				//   delay = 0 (run immediately when triggered)
+				//   enabled = false (task starts disabled until an interrupt occurs)
+				if (Attach(0, false))
+				{
+					Listener = listener;
+					Tail = Head;
+					ReportedOverflowCount = GetOverflowCount();
+					return true;
+				}
+				return false;
+			}
+
+			/// <summary>
+			/// Returns the total number of events dropped because the buffer was full.
+			/// </summary>
+			uint32_t GetOverflowCount() const
+			{
+#if defined(HARMONIC_PLATFORM_ATOMIC_NARROW)
+				// Lock-free consistent read: retry if the ISR updated the count mid-read.
+				uint32_t count;
+				do
+				{
+					count = OverflowCount;
+				} while (count != OverflowCount);
+
+				return count;
+#else
+				return OverflowCount;
+#endif
+			}
+
+		public:
+			/// <summary>
+			/// Called by the scheduler to drain the buffered events to the listener.
+			/// </summary>
+			void Run() final
+			{
+				const uint8_t head = Head;
+				Platform::MemoryBarrier(); // Read the events only after the head.
+
+				const uint8_t tail = Tail;
+				const uint8_t count = head - tail;
+				const uint32_t overflowCount = GetOverflowCount();
+				const uint32_t overflows = overflowCount - ReportedOverflowCount;
+
+				if ((count > 0 || overflows > 0) && Listener != nullptr)
+				{
+					Listener->OnBufferInterrupt(EventBatch<payload_t>(Buffer, tail, count, Mask), overflows);
+				}
+				ReportedOverflowCount = overflowCount;
+
+				Platform::MemoryBarrier(); // Release the slots only after the events were read.
+				Tail = head;
+
+				// Sleep until the next push wakes the task, unless one was pushed since the drain.
+				SetEnabled(false);
+				if (Head != head)
+				{
+					SetEnabled(true);
+				}
+			}
+
+			/// <summary>
+			/// Called from an ISR to push an event and wake the scheduler.
+			/// If the buffer is full, the event is dropped and counted.
+			/// </summary>
+			/// <param name="payload">Event to buffer.</param>
+			/// <returns>True if the event was buffered, false if dropped.</returns>
+			bool OnInterrupt(const payload_t& payload)
+			{
+				const uint8_t head = Head;
+				const uint8_t tail = Tail;
+				if ((uint8_t)(head - tail) >= Capacity)
+				{
+					OverflowCount = OverflowCount + 1;
+					return false;
+				}
+
+				Buffer[head & Mask] = payload;
+				Platform::MemoryBarrier(); // Publish the event before the head.
+				Head = head + 1;
+
+				// Only the first event of a batch needs to wake the task.
+				if (head == tail)
+				{
+					WakeFromISR();
+				}
+
+				return true;
+			}
+		};
+	}
+}
+#endif
@@ -2,6 +2,7 @@
 #define _HARMONIC_INTERRUPT_EVENT_TASK_h
 
 #include "DynamicTask.h"
+#include "../Model/InterruptLatency.h"
 
 namespace Harmonic
 {
@@ -50,6 +51,7 @@ namespace Harmonic
 		/// - All accesses to the timestamp and count are guarded for atomicity and ISR safety.
 		/// - Multiple interrupts before Run() are accumulated and reported as a count.
 		/// - The event count saturates at MaxValue; further interrupts are ignored until processed.
+		/// - With HARMONIC_INTERRUPT_TRACE, measures wake-to-run latency, and counts ignored interrupts as dropped.
 		/// </summary>
 		/// <typeparam name="TimestampSource">Type providing a static Get() method returning a timestamp (e.g., MicrosTimestampSource, MillisTimestampSource).</typeparam>
 		/// <typeparam name="interrupt_count_t">Type used for counting interrupts (must be unsigned, e.g., uint8_t, uint16_t).</typeparam>
@@ -72,6 +74,10 @@ namespace Harmonic
 			volatile uint32_t InterruptTimestamp = 0;
 			volatile interrupt_count_t InterruptCount = 0;
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			Profiling::InterruptLatencyMeter Latency{};
+#endif
+
 		private:
 			/// <summary>
 			/// Listener to be notified when the event is processed.
@@ -116,6 +122,9 @@ namespace Harmonic
 					interruptCount = InterruptCount;
 					InterruptCount = 0;
 				}
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				Latency.OnDispatch();
+#endif
 
 				if (interruptCount > 0 && Listener != nullptr)
 				{
@@ -126,6 +135,13 @@ namespace Harmonic
 				SetEnabled(interruptPending);
 			}
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			bool GetInterruptTrace(Profiling::InterruptTrace& trace) final
+			{
+				return Latency.GetTrace(trace);
+			}
+#endif
+
 			/// <summary>
 			/// Called from an ISR to record the timestamp and increment the event count.
 			/// If the count is at MaxValue, further interrupts are ignored until processed.
@@ -134,6 +150,9 @@ namespace Harmonic
 			{
 				if (InterruptCount == 0)
 				{
+#if defined(HARMONIC_INTERRUPT_TRACE)
+					Latency.OnWake();
+#endif
 					{
 						Platform::AtomicGuard guard;
 						InterruptTimestamp = TimestampSource::Get();
@@ -146,6 +165,12 @@ namespace Harmonic
 					Platform::AtomicGuard guard;
 					InterruptCount = InterruptCount + 1;
 				}
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				else
+				{
+					Latency.OnDrop();
+				}
+#endif
 			}
 		};
 	}
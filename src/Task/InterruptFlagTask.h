@@ -2,6 +2,7 @@
 #define _HARMONIC_INTERRUPT_FLAG_TASK_h
 
 #include "DynamicTask.h"
+#include "../Model/InterruptLatency.h"
 
 namespace Harmonic
 {
@@ -23,14 +24,19 @@ namespace Harmonic
 		/// 
 		/// - Use OnInterrupt() from an ISR to set the interrupt flag and wake the scheduler.
 		/// - The Run() method is called by the scheduler to process the event and notify the listener.
-		/// - All accesses to the interrupt flag are guarded for atomicity and ISR safety.
+		/// - All accesses to the interrupt flag are atomic and ISR safe, lock-free with HARMONIC_PLATFORM_ATOMIC_CAS.
 		/// - Only one interrupt event is tracked at a time; repeated interrupts before Run() are coalesced.
+		/// - With HARMONIC_INTERRUPT_TRACE, measures wake-to-run latency, and counts coalesced interrupts as dropped.
 		/// </summary>
 		class CallbackTask final : public DynamicTask
 		{
 		private:
 			volatile bool InterruptFlag = false;
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			Profiling::InterruptLatencyMeter Latency{};
+#endif
+
 		private:
 			InterruptListener* Listener = nullptr;
 
@@ -61,12 +67,10 @@ namespace Harmonic
 		public:
 			void Run() final
 			{
-				bool flag;
-				{
-					Platform::AtomicGuard guard;
-					flag = InterruptFlag;
-					InterruptFlag = false;
-				}
+				const bool flag = Platform::Exchange(InterruptFlag, false);
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				Latency.OnDispatch();
+#endif
 
 				if (flag && Listener != nullptr)
 				{
@@ -77,6 +81,13 @@ namespace Harmonic
 				SetEnabled(interruptPending);
 			}
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			bool GetInterruptTrace(Profiling::InterruptTrace& trace) final
+			{
+				return Latency.GetTrace(trace);
+			}
+#endif
+
 			/// <summary>
 			/// Called from an ISR to set the interrupt flag and wake the scheduler.
 			/// If the flag is already set, does nothing (coalesces repeated interrupts).
@@ -85,9 +96,18 @@ namespace Harmonic
 			{
 				if (!InterruptFlag)
 				{
+#if defined(HARMONIC_INTERRUPT_TRACE)
+					Latency.OnWake();
+#endif
 					InterruptFlag = true;
 					WakeFromISR();
 				}
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				else
+				{
+					Latency.OnDrop();
+				}
+#endif
 			}
 		};
 	}
@@ -2,6 +2,7 @@
 #define _HARMONIC_INTERRUPT_SIGNAL_TASK_h
 
 #include "DynamicTask.h"
+#include "../Model/InterruptLatency.h"
 
 namespace Harmonic
 {
@@ -25,9 +26,10 @@ namespace Harmonic
 		///
 		/// - Use OnInterrupt() from an ISR to increment the signal count and wake the scheduler.
 		/// - The Run() method is called by the scheduler to process the event and notify the listener.
-		/// - All accesses to the signal count are guarded for atomicity and ISR safety.
+		/// - All accesses to the signal count are atomic and ISR safe, lock-free with HARMONIC_PLATFORM_ATOMIC_CAS.
 		/// - Multiple interrupts before Run() are accumulated and reported as a count.
 		/// - The signal count saturates at MaxValue; further interrupts are ignored until processed.
+		/// - With HARMONIC_INTERRUPT_TRACE, measures wake-to-run latency, and counts ignored interrupts as dropped.
 		/// </summary>
 		/// <typeparam name="signal_t">Type used for interrupt signal counting (must be unsigned, e.g., uint8_t, uint16_t).</typeparam>
 		template<typename signal_t = uint8_t>
@@ -47,6 +49,10 @@ namespace Harmonic
 		private:
 			volatile signal_t InterruptSignal = 0;
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			Profiling::InterruptLatencyMeter Latency{};
+#endif
+
 		private:
 			InterruptListener<signal_t>* Listener = nullptr;
 
@@ -81,12 +87,10 @@ namespace Harmonic
 			/// </summary>
 			void Run() final
 			{
-				signal_t signal;
-				{
-					Platform::AtomicGuard guard;
-					signal = InterruptSignal;
-					InterruptSignal = 0;
-				}
+				const signal_t signal = Platform::Exchange(InterruptSignal, signal_t(0));
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				Latency.OnDispatch();
+#endif
 
 				if (signal > 0 && Listener != nullptr)
 				{
@@ -97,17 +101,34 @@ namespace Harmonic
 				SetEnabled(interruptPending);
 			}
 
+#if defined(HARMONIC_INTERRUPT_TRACE)
+			bool GetInterruptTrace(Profiling::InterruptTrace& trace) final
+			{
+				return Latency.GetTrace(trace);
+			}
+#endif
+
 			/// <summary>
 			/// Called from an ISR to increment the signal count and wake the scheduler.
 			/// If the count is at MaxValue, further interrupts are ignored until processed.
 			/// </summary>
 			void OnInterrupt()
 			{
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				Latency.OnWake();
+#endif
+				signal_t signal;
+				do
 				{
-					Platform::AtomicGuard guard;
-					if (InterruptSignal != MaxValue)
-						InterruptSignal = InterruptSignal + 1;
-				}
+					signal = InterruptSignal;
+					if (signal == MaxValue)
+					{
+#if defined(HARMONIC_INTERRUPT_TRACE)
+						Latency.OnDrop();
+#endif
+						break;
+					}
+				} while (!Platform::CompareExchange(InterruptSignal, signal, signal_t(signal + 1)));
 				WakeFromISR();
 			}
 		};
@@ -0,0 +1,131 @@
+#ifndef _HARMONIC_OVERLOAD_TASK_h
+#define _HARMONIC_OVERLOAD_TASK_h
+
+#include "../Model/ITask.h"
+#include "../Model/Profiling.h"
+#include "../Model/TaskRegistry.h"
+
+#if defined(HARMONIC_OVERLOAD)
+namespace Harmonic
+{
+	/// <summary>
+	/// Overload manager: stretches elastic task periods while the loop is saturated, and restores them once load drops.
+	///
+	/// - Each CheckPeriod, reads the Base profiling trace and computes the load, busy time over total time.
+	/// - At or above highLoad, the registry is overloaded: every check stretches elastic periods one step, up to their max.
+	/// - At or below lowLoad, every check restores them one step, down to their min. In between, periods are held.
+	/// - Elastic tasks are tagged with TaskRegistry::SetElastic(). Fixed period tasks are never touched.
+	///
+	/// Consumes the profiler's trace windows: use GetLoad() instead of a trace log task on the same scheduler.
+	/// Requires #define HARMONIC_OVERLOAD and a Base profiling scheduler.
+	/// </summary>
+	/// <typeparam name="CheckPeriod">Load check period in milliseconds.</typeparam>
+	template<uint32_t CheckPeriod>
+	class OverloadTask : public ITask
+	{
+	private:
+		/// <summary>
+		/// Profiler source reference.
+		/// </summary>
+		Profiling::IBaseProfiler& Profiler;
+
+		/// <summary>
+		/// Reference to the registry for managing this task.
+		/// </summary>
+		TaskRegistry& Registry;
+
+		/// <summary>
+		/// Unique identifier for this task within the registry.
+		/// Set during registration; TASK_INVALID_ID if unregistered.
+		/// </summary>
+		volatile task_id_t Id = TASK_INVALID_ID;
+
+	private:
+		Profiling::BaseTrace Trace{};
+
+		const uint8_t HighLoad;
+		const uint8_t LowLoad;
+
+		uint8_t Load = 0;
+		bool Stretched = false;
+
+	public:
+		/// <summary>
+		/// Constructs the overload manager with its load thresholds.
+		/// </summary>
+		/// <param name="highLoad">Load percentage at or above which elastic periods are stretched.</param>
+		/// <param name="lowLoad">Load percentage at or below which elastic periods are restored, lower than highLoad.</param>
+		OverloadTask(TaskRegistry& registry, Profiling::IBaseProfiler& profiler, const uint8_t highLoad = 90, const uint8_t lowLoad = 70)
+			: ITask()
+			, Profiler(profiler)
+			, Registry(registry)
+			, HighLoad(highLoad)
+			, LowLoad(lowLoad)
+		{
+		}
+
+		void Run() override
+		{
+			if (!Profiler.GetTrace(Trace))
+			{
+				return;
+			}
+
+			const uint32_t traceTime = Trace.Scheduling + Trace.IdleSleep;
+			Load = (traceTime > 0)
+				? static_cast<uint8_t>((Trace.Busy * 100) / traceTime) : 0U;
+
+			if (Load >= HighLoad)
+			{
+				Stretched = Registry.ScaleElasticPeriods(true);
+			}
+			else if (Load <= LowLoad)
+			{
+				Stretched = Registry.ScaleElasticPeriods(false);
+			}
+		}
+
+		bool Start()
+		{
+			Load = 0;
+			Stretched = false;
+
+			return Registry.Attach(this, Platform::MillisToTicks(CheckPeriod), true);
+		}
+
+		void Stop()
+		{
+			Registry.Detach(Id);
+		}
+
+		/// <summary>
+		/// Returns the load of the last checked window, in percent.
+		/// </summary>
+		uint8_t GetLoad() const
+		{
+			return Load;
+		}
+
+		/// <summary>
+		/// Returns true while any elastic task runs above its min period.
+		/// </summary>
+		bool IsStretched() const
+		{
+			return Stretched;
+		}
+
+		void OnTaskIdUpdated(const task_id_t taskId) final
+		{
+			// Store the assigned task ID for later use.
+			Id = taskId;
+		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+	};
+}
+#endif
+#endif
@@ -0,0 +1,147 @@
+#ifndef _HARMONIC_TIMELINE_EXPORT_TASK_h
+#define _HARMONIC_TIMELINE_EXPORT_TASK_h
+
+#include "../Model/ITask.h"
+#include "../Model/Timeline.h"
+#include "../Model/TaskRegistry.h"
+
+#include <Print.h>
+
+namespace Harmonic
+{
+	/// <summary>
+	/// Timeline exporter, dumping the recorded task runs as a Chrome trace JSON array.
+	///
+	/// - Each LogPeriod, freezes the recorder and writes its window as one JSON array, opened by a "[" line and closed by a "]" line.
+	///   Save one array to a .json file and open it in ui.perfetto.dev or chrome://tracing.
+	/// - One complete ("X") event per run: ts and dur in microseconds, args.late as the start lateness in microseconds.
+	///   All runs are on a single track, so gaps and back-to-back runs show which task delayed which.
+	/// - ts is relative to the first run of the window, rebuilt from the recorded start deltas.
+	/// - One event line is written per Run(). While a window is pending the task runs on every pass, then returns to LogPeriod.
+	///   The window is frozen while exporting, so the exporter's own runs aren't recorded. It is cleared once written.
+	///
+	/// Requires #define HARMONIC_TIMELINE and a profiling scheduler, with the recorder set with SetTimelineRecorder().
+	/// </summary>
+	/// <typeparam name="LogPeriod">Export period in milliseconds.</typeparam>
+	template<uint32_t LogPeriod>
+	class TimelineExportTask : public ITask
+	{
+	private:
+		/// <summary>
+		/// A reference to a Print object used for the JSON output.
+		/// </summary>
+		Print& Output;
+
+		/// <summary>
+		/// Recorder source reference.
+		/// </summary>
+		TimelineRecorder& Recorder;
+
+		/// <summary>
+		/// Reference to the registry for managing this task.
+		/// </summary>
+		TaskRegistry& Registry;
+
+		/// <summary>
+		/// Unique identifier for this task within the registry.
+		/// Set during registration; TASK_INVALID_ID if unregistered.
+		/// </summary>
+		volatile task_id_t Id = TASK_INVALID_ID;
+
+	private:
+		/// <summary>
+		/// Start time of the last written event, in microseconds since the window's first run.
+		/// </summary>
+		uint32_t Time = 0;
+
+		/// <summary>
+		/// Index of the next event to write.
+		/// </summary>
+		uint16_t EventIndex = 0;
+
+	public:
+		TimelineExportTask(TaskRegistry& registry, TimelineRecorder& recorder, Print& output)
+			: ITask()
+			, Output(output)
+			, Recorder(recorder)
+			, Registry(registry)
+		{
+		}
+
+		void Run() override
+		{
+			if (!Recorder.IsFrozen())
+			{
+				if (Recorder.GetCount() == 0)
+				{
+					return;
+				}
+
+				Recorder.Freeze();
+				EventIndex = 0;
+				Time = 0;
+				Output.println('[');
+
+				// Stream the events on every pass until the window is written.
+				Registry.SetPeriod(Id, 0);
+			}
+			else if (EventIndex < Recorder.GetCount())
+			{
+				WriteEvent(Recorder.GetEvent(EventIndex));
+				EventIndex++;
+			}
+			else
+			{
+				Output.println(']');
+				Recorder.Resume();
+				Registry.SetPeriod(Id, Platform::MillisToTicks(LogPeriod));
+			}
+		}
+
+		bool Start()
+		{
+			Recorder.Resume();
+
+			return Registry.Attach(this, Platform::MillisToTicks(LogPeriod), true);
+		}
+
+		void Stop()
+		{
+			Registry.Detach(Id);
+		}
+
+		void OnTaskIdUpdated(const task_id_t taskId) final
+		{
+			// Store the assigned task ID for later use.
+			Id = taskId;
+		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+
+	private:
+		void WriteEvent(const Timeline::RunEvent& event)
+		{
+			if (EventIndex > 0)
+			{
+				// The first run's delta refers to a run outside the window.
+				Time += Platform::ProfilerTicksToMicros(event.StartDelta);
+				Output.print(',');
+			}
+
+			Output.print(F("{\"name\":\"Task "));
+			Output.print(event.TaskId);
+			Output.print(F("\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"));
+			Output.print(Time);
+			Output.print(F(",\"dur\":"));
+			Output.print(Platform::ProfilerTicksToMicros(event.Duration));
+			Output.print(F(",\"args\":{\"late\":"));
+			Output.print(Platform::TicksToMicros(event.Lateness));
+			Output.println(F("}}"));
+		}
+	};
+}
+#endif
@@ -0,0 +1,457 @@
+#ifndef _HARMONIC_TIMER_SERVICE_TASK_h
+#define _HARMONIC_TIMER_SERVICE_TASK_h
+
+#include "../Model/ITask.h"
+#include "../Model/TaskRegistry.h"
+
+namespace Harmonic
+{
+	/// <summary>
+	/// One-shot timer handle: the entry index in the low byte, and its reuse generation in the high byte,
+	/// so a handle to a fired or cancelled timer never matches a newer timer in the same entry.
+	/// </summary>
+	typedef uint16_t timer_id_t;
+
+	/// <summary>
+	/// Handle of no timer.
+	/// </summary>
+	static constexpr timer_id_t TIMER_INVALID_ID = UINT16_MAX;
+
+	/// <summary>
+	/// Listener for one-shot timers, called from the timer service's Run().
+	/// A listener may start new timers, including its own again.
+	/// </summary>
+	struct ITimerListener
+	{
+		/// <summary>
+		/// Called once the timer is due. The handle is already released.
+		/// </summary>
+		/// <param name="timerId">Handle returned when the timer was started.</param>
+		virtual void OnTimer(const timer_id_t timerId) = 0;
+	};
+
+	namespace Timer
+	{
+		/// <summary>
+		/// End of list marker for entry links.
+		/// </summary>
+		static constexpr uint8_t NoEntry = UINT8_MAX;
+
+		/// <summary>
+		/// Maximum number of entries, as entry indices are bytes and NoEntry is reserved.
+		/// </summary>
+		static constexpr uint8_t MaxCapacity = UINT8_MAX - 1;
+
+		/// <summary>
+		/// Pending one-shot timer, linked in due order, or free.
+		/// </summary>
+		struct Entry
+		{
+			/// <summary>
+			/// Due timestamp in time base ticks.
+			/// </summary>
+			uint32_t Due;
+
+			/// <summary>
+			/// Listener to call, nullptr while the entry is free.
+			/// </summary>
+			ITimerListener* Listener;
+
+			/// <summary>
+			/// Index of the next pending entry in due order, or of the next free entry.
+			/// </summary>
+			uint8_t Next;
+
+			/// <summary>
+			/// Reuse generation, incremented on every release.
+			/// </summary>
+			uint8_t Generation;
+		};
+	}
+
+	/// <summary>
+	/// Timer service: a fixed pool of one-shot timers, multiplexed behind a single scheduler task.
+	///
+	/// - Pending timers are kept in a list sorted by due time, so only the earliest one is ever checked.
+	/// - The service task's period is re-armed to the earliest timer, and it is disabled while none is pending:
+	///   per Loop() pass, the whole pool costs a single tracker check.
+	/// - Starting a timer is O(n) in pending timers, a sorted insert. Firing and re-arming are O(1) per timer.
+	/// - StartTimer, CancelTimer: Safe to call from any context, including from an ISR, e.g. to debounce a pin.
+	///   A timer started from an ISR ahead of the others wakes the service, to re-arm it.
+	///   Both walk the pending list inside a critical section, so interrupts stay masked for up to Capacity steps:
+	///   keep the capacity small (16 or fewer timers) where interrupt latency matters.
+	/// - Delays are in time base ticks, up to 2^31 - 1. Timers fire in due order, never early, as tasks do.
+	///
+	/// Use TemplateTimerServiceTask for a service that owns its storage.
+	/// </summary>
+	class TimerServiceTask : public ITask
+	{
+	private:
+		/// <summary>
+		/// Reference to the registry for managing this task.
+		/// </summary>
+		TaskRegistry& Registry;
+
+		/// <summary>
+		/// Externally allocated timer entries.
+		/// </summary>
+		Timer::Entry* Entries;
+
+		/// <summary>
+		/// Unique identifier for this task within the registry.
+		/// Set during registration; TASK_INVALID_ID if unregistered.
+		/// </summary>
+		volatile task_id_t Id = TASK_INVALID_ID;
+
+	public:
+		/// <summary>
+		/// Maximum number of pending timers.
+		/// </summary>
+		const uint8_t Capacity;
+
+	private:
+		/// <summary>
+		/// Earliest pending entry, NoEntry if none.
+		/// </summary>
+		volatile uint8_t Head = Timer::NoEntry;
+
+		/// <summary>
+		/// First free entry, NoEntry if the pool is exhausted or the service is stopped.
+		/// </summary>
+		volatile uint8_t Free = Timer::NoEntry;
+
+		volatile uint8_t PendingCount = 0;
+
+		/// <summary>
+		/// Incremented whenever a new earliest timer is started, so a concurrent re-arm can detect it.
+		/// </summary>
+		volatile uint8_t HeadChanges = 0;
+
+	public:
+		/// <summary>
+		/// Constructs the service over an external entry array.
+		/// </summary>
+		/// <param name="registry">Registry to run the service task on.</param>
+		/// <param name="entries">Entry array with capacity entries.</param>
+		/// <param name="capacity">Number of entries, up to Timer::MaxCapacity.</param>
+		TimerServiceTask(TaskRegistry& registry, Timer::Entry* entries, const uint8_t capacity)
+			: ITask()
+			, Registry(registry)
+			, Entries(entries)
+			, Capacity((capacity < Timer::MaxCapacity) ? capacity : Timer::MaxCapacity)
+		{
+		}
+
+		/// <summary>
+		/// Attaches the service, disabled until a timer is started, with all timers free.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		bool Start()
+		{
+			ResetTimers();
+
+			return Registry.Attach(this, 0, false);
+		}
+
+		/// <summary>
+		/// Detaches the service. Pending timers are dropped without firing.
+		/// Not safe to call from an ISR.
+		/// </summary>
+		void Stop()
+		{
+			Registry.Detach(Id);
+			ResetTimers();
+
+			Platform::AtomicGuard guard;
+			Free = Timer::NoEntry;
+		}
+
+		/// <summary>
+		/// Starts a one-shot timer.
+		/// Safe to call from any context, including from an ISR.
+		/// The sorted insert runs with interrupts masked, O(n) in pending timers.
+		/// </summary>
+		/// <param name="listener">Listener to call once due.</param>
+		/// <param name="delay">Delay in time base ticks.</param>
+		/// <param name="timerId">Output: handle of the started timer, TIMER_INVALID_ID on failure.</param>
+		/// <returns>True on success, false if the listener is null, the pool is exhausted or the service isn't started.</returns>
+		bool StartTimer(ITimerListener* listener, const uint32_t delay, timer_id_t& timerId)
+		{
+			timerId = TIMER_INVALID_ID;
+			if (listener == nullptr)
+			{
+				return false;
+			}
+
+			bool earliest;
+			{
+				Platform::AtomicGuard guard;
+				const uint8_t index = Free;
+				if (index == Timer::NoEntry || Id == TASK_INVALID_ID)
+				{
+					return false;
+				}
+				Free = Entries[index].Next;
+
+				Timer::Entry& entry = Entries[index];
+				entry.Due = Platform::GetTimestamp() + delay;
+				entry.Listener = listener;
+
+				// Sorted insert, after timers with the same due time.
+				uint8_t previous = Timer::NoEntry;
+				uint8_t next = Head;
+				while (next != Timer::NoEntry
+					&& static_cast<int32_t>(Entries[next].Due - entry.Due) <= 0)
+				{
+					previous = next;
+					next = Entries[next].Next;
+				}
+				entry.Next = next;
+
+				earliest = previous == Timer::NoEntry;
+				if (earliest)
+				{
+					Head = index;
+					HeadChanges++;
+				}
+				else
+				{
+					Entries[previous].Next = index;
+				}
+				PendingCount++;
+
+				timerId = GetTimerId(index);
+			}
+
+			if (earliest)
+			{
+				// Re-armed by the next run.
+				Registry.WakeFromISR(Id);
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Starts a one-shot timer, without keeping its handle.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="listener">Listener to call once due.</param>
+		/// <param name="delay">Delay in time base ticks.</param>
+		/// <returns>True on success.</returns>
+		bool StartTimer(ITimerListener* listener, const uint32_t delay)
+		{
+			timer_id_t timerId;
+
+			return StartTimer(listener, delay, timerId);
+		}
+
+		/// <summary>
+		/// Cancels a pending timer. O(n) in pending timers.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="timerId">Timer handle.</param>
+		/// <returns>True if the timer was pending, false if it already fired, was cancelled, or the handle is invalid.</returns>
+		bool CancelTimer(const timer_id_t timerId)
+		{
+			Platform::AtomicGuard guard;
+			const uint8_t index = GetPendingIndex(timerId);
+			if (index == Timer::NoEntry)
+			{
+				return false;
+			}
+
+			uint8_t previous = Timer::NoEntry;
+			uint8_t current = Head;
+			while (current != index)
+			{
+				previous = current;
+				current = Entries[current].Next;
+			}
+
+			// A cancelled head leaves the service armed, its run only re-arms.
+			if (previous == Timer::NoEntry)
+			{
+				Head = Entries[index].Next;
+			}
+			else
+			{
+				Entries[previous].Next = Entries[index].Next;
+			}
+			Release(index);
+
+			return true;
+		}
+
+		/// <summary>
+		/// Returns true if the timer is still pending.
+		/// Safe to call from any context, including from an ISR.
+		/// </summary>
+		/// <param name="timerId">Timer handle.</param>
+		bool IsTimerPending(const timer_id_t timerId) const
+		{
+			Platform::AtomicGuard guard;
+
+			return GetPendingIndex(timerId) != Timer::NoEntry;
+		}
+
+		/// <summary>
+		/// Returns the number of pending timers.
+		/// </summary>
+		uint8_t GetPendingCount() const
+		{
+			return PendingCount;
+		}
+
+		void Run() final
+		{
+			// The period only applies after this run, so due timers are checked against a fixed timestamp:
+			// timers started by listeners with no delay fire on the next run.
+			const uint32_t timestamp = Platform::GetTimestamp();
+			while (true)
+			{
+				ITimerListener* listener;
+				timer_id_t timerId;
+				{
+					Platform::AtomicGuard guard;
+					const uint8_t index = Head;
+					if (index == Timer::NoEntry
+						|| static_cast<int32_t>(timestamp - Entries[index].Due) <= 0)
+					{
+						break;
+					}
+
+					listener = Entries[index].Listener;
+					timerId = GetTimerId(index);
+					Head = Entries[index].Next;
+					Release(index);
+				}
+
+				listener->OnTimer(timerId);
+			}
+
+			Rearm();
+		}
+
+		void OnTaskIdUpdated(const task_id_t taskId) final
+		{
+			// Store the assigned task ID for later use.
+			Id = taskId;
+		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+
+	private:
+		/// <summary>
+		/// Arms the service task for the earliest pending timer, or disables it if none is pending.
+		/// Repeated if a new earliest timer was started meanwhile, as its wake may have been overwritten.
+		/// </summary>
+		void Rearm()
+		{
+			uint8_t changes;
+			do
+			{
+				bool pending;
+				uint32_t delay = 0;
+				{
+					Platform::AtomicGuard guard;
+					changes = HeadChanges;
+					pending = Head != Timer::NoEntry;
+					if (pending)
+					{
+						const int32_t remaining = static_cast<int32_t>(Entries[Head].Due - Platform::GetTimestamp());
+						delay = (remaining > 0) ? static_cast<uint32_t>(remaining) : 0;
+					}
+				}
+
+				if (pending)
+				{
+					Registry.SetPeriodAndEnabled(Id, delay, true);
+					Registry.SetPhase(Id, delay);
+				}
+				else
+				{
+					Registry.SetEnabled(Id, false);
+				}
+			} while (changes != HeadChanges);
+		}
+
+		/// <summary>
+		/// Links all entries in the free list, invalidating all handles.
+		/// </summary>
+		void ResetTimers()
+		{
+			Platform::AtomicGuard guard;
+			for (uint8_t i = 0; i < Capacity; i++)
+			{
+				Entries[i].Listener = nullptr;
+				Entries[i].Generation++;
+				Entries[i].Next = ((i + 1) < Capacity) ? (i + 1) : Timer::NoEntry;
+			}
+			Head = Timer::NoEntry;
+			Free = (Capacity > 0) ? 0 : Timer::NoEntry;
+			PendingCount = 0;
+		}
+
+		/// <summary>
+		/// Returns an unlinked entry to the free list, invalidating its handle.
+		/// </summary>
+		void Release(const uint8_t index)
+		{
+			Entries[index].Listener = nullptr;
+			Entries[index].Generation++;
+			Entries[index].Next = Free;
+			Free = index;
+			PendingCount--;
+		}
+
+		timer_id_t GetTimerId(const uint8_t index) const
+		{
+			return static_cast<timer_id_t>((uint16_t(Entries[index].Generation) << 8) | index);
+		}
+
+		/// <summary>
+		/// Returns the entry index of a pending timer, NoEntry if the handle is stale or invalid.
+		/// </summary>
+		uint8_t GetPendingIndex(const timer_id_t timerId) const
+		{
+			const uint8_t index = static_cast<uint8_t>(timerId & UINT8_MAX);
+			if (index >= Capacity
+				|| Entries[index].Listener == nullptr
+				|| GetTimerId(index) != timerId)
+			{
+				return Timer::NoEntry;
+			}
+
+			return index;
+		}
+	};
+
+	/// <summary>
+	/// TimerServiceTask with its own storage.
+	/// RAM: TimerCapacity x sizeof(Timer::Entry), 12 bytes on 32-bit targets, 8 on AVR.
+	/// </summary>
+	/// <typeparam name="TimerCapacity">Maximum number of pending timers.</typeparam>
+	template<uint8_t TimerCapacity>
+	class TemplateTimerServiceTask : public TimerServiceTask
+	{
+	private:
+		static_assert(TimerCapacity > 0 && TimerCapacity <= Timer::MaxCapacity, "TimerCapacity must be in [1;254].");
+
+		/// <summary>
+		/// Free list is linked on Start(), the entries need no initialization.
+		/// </summary>
+		Timer::Entry TimerList[TimerCapacity];
+
+	public:
+		TemplateTimerServiceTask(TaskRegistry& registry)
+			: TimerServiceTask(registry, TimerList, TimerCapacity)
+		{
+		}
+	};
+}
+#endif
@@ -16,6 +16,29 @@ namespace Harmonic
 			output.println(F("ID\tCPU(%)\tCALLS\tTIME(us)\tMAX(us)"));
 		}
 
+		/// <summary>
+		/// Jitter columns (J) are in time base ticks.
+		/// </summary>
+		static void PrintLatencyLogHeader(Print& output)
+		{
+			output.println(F("ID\tCALLS\tP50(us)\tP99(us)\tMAX(us)\tJP50\tJP99\tJMAX"));
+		}
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+		/// <summary>
+		/// Interrupt rows (IRQ) follow their task row.
+		/// </summary>
+		static void PrintInterruptLogHeader(Print& output)
+		{
+			output.println(F("IRQ\tWAKES\tMIN(us)\tAVG(us)\tMAX(us)\tDROPPED"));
+		}
+
+		static void PrintTagInterrupt(Print& output)
+		{
+			output.print(F("IRQ"));
+		}
+#endif
+
 		static void PrintTagScheduler(Print& output)
 		{
 			output.print(F("BUSY"));
@@ -46,7 +69,7 @@ namespace Harmonic
 		}
 	}
 
-	template<uint8_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
 	class MockTraceLogTask
 	{
 	public:
@@ -64,7 +87,7 @@ namespace Harmonic
 		}
 	};
 
-	template<uint8_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
 	class BaseTraceLogTask : public ITask
 	{
 	private:
@@ -190,7 +213,7 @@ namespace Harmonic
 
 		bool Start()
 		{
-			return Registry.Attach(this, LogPeriod, true);
+			return Registry.Attach(this, Platform::MillisToTicks(LogPeriod), true);
 		}
 
 		void Stop()
@@ -203,9 +226,15 @@ namespace Harmonic
 			// Store the assigned task ID for later use.
 			Id = taskId;
 		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
 	};
 
-	template<uint8_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
 	class FullTraceLogTask : public ITask
 	{
 	private:
@@ -237,7 +266,7 @@ namespace Harmonic
 		uint32_t GetTracesDuration() const
 		{
 			uint32_t total = 0;
-			for (uint8_t i = 0; i < Trace.TaskCount; i++)
+			for (task_id_t i = 0; i < Trace.TaskCount; i++)
 			{
 				total += Traces[i].Duration;
 			}
@@ -284,6 +313,9 @@ namespace Harmonic
 
 				Output.println();
 				TraceLogging::PrintLogHeader(Output);
+#if defined(HARMONIC_INTERRUPT_TRACE)
+				TraceLogging::PrintInterruptLogHeader(Output);
+#endif
 				TraceLogging::PrintTagScheduler(Output);
 				Output.print('\t');
 				Output.print(cpu);
@@ -308,21 +340,23 @@ namespace Harmonic
 
 				TraceLogging::PrintSeparator(Output);
 
-				for (uint_fast8_t i = 0; i < Trace.TaskCount; i++)
+				for (task_id_t i = 0; i < Trace.TaskCount; i++)
 				{
 					const uint8_t task = (traceTime > 0U)
 						? static_cast<uint8_t>((Traces[i].Duration * 100U) / traceTime)
 						: 0U;
 
+					const task_id_t taskId = Registry.GetTaskIdAt(i);
+
 					Output.println();
-					if (i == Id)
+					if (taskId == Id)
 					{
 						TraceLogging::PrintTagLog(Output);
 					}
 					else
 					{
 						Output.print(F("Task"));
-						Output.print(i);
+						Output.print(taskId);
 					}
 					Output.print('\t');
 					Output.print(task);
@@ -333,6 +367,25 @@ namespace Harmonic
 					Output.print('\t');
 					Output.print('\t');
 					Output.print(Traces[i].MaxDuration);
+
+#if defined(HARMONIC_INTERRUPT_TRACE)
+					Profiling::InterruptTrace interruptTrace;
+					if (Profiler.GetInterruptTrace(i, interruptTrace))
+					{
+						Output.println();
+						TraceLogging::PrintTagInterrupt(Output);
+						Output.print('\t');
+						Output.print(interruptTrace.Wakes);
+						Output.print('\t');
+						Output.print(interruptTrace.MinLatency);
+						Output.print('\t');
+						Output.print((interruptTrace.Wakes > 0) ? (interruptTrace.TotalLatency / interruptTrace.Wakes) : 0U);
+						Output.print('\t');
+						Output.print(interruptTrace.MaxLatency);
+						Output.print('\t');
+						Output.print(interruptTrace.Dropped);
+					}
+#endif
 				}
 				Output.println();
 			}
@@ -340,7 +393,176 @@ namespace Harmonic
 
 		bool Start()
 		{
-			return Registry.Attach(this, LogPeriod, true);
+			return Registry.Attach(this, Platform::MillisToTicks(LogPeriod), true);
+		}
+
+		void Stop()
+		{
+			Registry.Detach(Id);
+		}
+
+		void OnTaskIdUpdated(const task_id_t taskId) final
+		{
+			// Store the assigned task ID for later use.
+			Id = taskId;
+		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
+	};
+
+	template<task_id_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
+	class LatencyTraceLogTask : public ITask
+	{
+	private:
+		/// <summary>
+		/// A reference to a Print object used for serial output.
+		/// </summary>
+		Print& Output;
+
+		/// <summary>
+		/// Profiler source reference.
+		/// </summary>
+		Profiling::ILatencyProfiler& Profiler;
+
+		/// <summary>
+		/// Reference to the registry for managing this task.
+		/// </summary>
+		TaskRegistry& Registry;
+
+		/// <summary>
+		/// Unique identifier for this task within the registry.
+		/// Set during registration; TASK_INVALID_ID if unregistered.
+		/// </summary>
+		volatile task_id_t Id = TASK_INVALID_ID;
+
+	private:
+		Profiling::LatencyTaskTrace Traces[MaxTaskCount]{};
+		Profiling::FullTrace Trace{};
+
+		/// <summary>
+		/// Histogram percentiles are bucket bounds, the observed maximum is tighter when lower.
+		/// </summary>
+		static uint32_t GetPercentile(const Profiling::Histogram& histogram, const uint8_t percent, const uint32_t max)
+		{
+			const uint32_t percentile = Profiling::GetHistogramPercentile(histogram, percent);
+
+			return (percentile < max) ? percentile : max;
+		}
+
+		uint32_t GetTracesDuration() const
+		{
+			uint32_t total = 0;
+			for (task_id_t i = 0; i < Trace.TaskCount; i++)
+			{
+				total += Traces[i].Duration;
+			}
+			return total;
+		}
+
+	public:
+		/// <summary>
+		/// Constructs a latency trace log task with a reference to the registry.
+		/// Per task, prints execution time and start jitter percentiles next to their maximums.
+		/// </summary>
+		LatencyTraceLogTask(TaskRegistry& registry, Profiling::ILatencyProfiler& profiler, Print& output)
+			: ITask()
+			, Output(output)
+			, Profiler(profiler)
+			, Registry(registry)
+		{
+		}
+
+		void Run() override
+		{
+			if (Profiler.GetTrace(Trace, Traces, MaxTaskCount))
+			{
+				// Sum up total task run time.
+				const uint32_t busyTime = GetTracesDuration();
+
+				// Sum up total trace time.
+				const uint32_t traceTime = Trace.Scheduling + Trace.IdleSleep;
+
+				// Calculate idle time.
+				const uint32_t idleTime = Trace.Scheduling - busyTime;
+
+				// Calculate CPU usage percentage.
+				const uint8_t cpu = (traceTime > 0)
+					? static_cast<uint8_t>((busyTime * 100) / traceTime)
+					: 0U;
+
+				const uint8_t sleep = (traceTime > 0)
+					? static_cast<uint8_t>((Trace.IdleSleep * 100) / traceTime)
+					: 0U;
+
+				const uint8_t idle = (traceTime > 0)
+					? static_cast<uint8_t>((idleTime * 100) / traceTime)
+					: 0U;
+
+				Output.println();
+				TraceLogging::PrintLogHeader(Output);
+				TraceLogging::PrintTagScheduler(Output);
+				Output.print('\t');
+				Output.print(cpu);
+				Output.print('\t');
+				Output.print(Trace.Iterations);
+				Output.print('\t');
+				Output.print(busyTime);
+				Output.print('\t');
+				Output.print('\t');
+				Output.println(traceTime);
+
+				TraceLogging::PrintTagIdle(Output);
+				Output.print('\t');
+				Output.println(idle);
+
+				TraceLogging::PrintTagSleep(Output);
+				Output.print('\t');
+				Output.print(sleep);
+				Output.print('\t');
+				Output.print('\t');
+				Output.println(Trace.IdleSleep);
+
+				TraceLogging::PrintSeparator(Output);
+				TraceLogging::PrintLatencyLogHeader(Output);
+
+				for (task_id_t i = 0; i < Trace.TaskCount; i++)
+				{
+					const task_id_t taskId = Registry.GetTaskIdAt(i);
+
+					if (taskId == Id)
+					{
+						TraceLogging::PrintTagLog(Output);
+					}
+					else
+					{
+						Output.print(F("Task"));
+						Output.print(taskId);
+					}
+					Output.print('\t');
+					Output.print(Traces[i].Iterations);
+					Output.print('\t');
+					Output.print(GetPercentile(Traces[i].DurationHistogram, 50, Traces[i].MaxDuration));
+					Output.print('\t');
+					Output.print(GetPercentile(Traces[i].DurationHistogram, 99, Traces[i].MaxDuration));
+					Output.print('\t');
+					Output.print(Traces[i].MaxDuration);
+					Output.print('\t');
+					Output.print(GetPercentile(Traces[i].JitterHistogram, 50, Traces[i].MaxJitter));
+					Output.print('\t');
+					Output.print(GetPercentile(Traces[i].JitterHistogram, 99, Traces[i].MaxJitter));
+					Output.print('\t');
+					Output.println(Traces[i].MaxJitter);
+				}
+			}
+		}
+
+		bool Start()
+		{
+			return Registry.Attach(this, Platform::MillisToTicks(LogPeriod), true);
 		}
 
 		void Stop()
@@ -353,6 +575,12 @@ namespace Harmonic
 			// Store the assigned task ID for later use.
 			Id = taskId;
 		}
+
+		bool GetAssignedTaskId(task_id_t& taskId) const final
+		{
+			taskId = Id;
+			return true;
+		}
 	};
 
 	/// <summary>
@@ -360,34 +588,41 @@ namespace Harmonic
 	/// - None  -> MockTraceLogTask (no-op logger)
 	/// - Base  -> BaseTraceLogTask
 	/// - Full  -> FullTraceLogTask
+	/// - Latency -> LatencyTraceLogTask
 	/// </summary>
-	template<uint8_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
 	struct TraceLogTaskSelector;
 
-	template<uint8_t MaxTaskCount, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, uint32_t LogPeriod>
 	struct TraceLogTaskSelector<MaxTaskCount, ProfileLevelEnum::None, LogPeriod>
 	{
 		using Type = MockTraceLogTask<MaxTaskCount, ProfileLevelEnum::None, LogPeriod>;
 	};
 
-	template<uint8_t MaxTaskCount, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, uint32_t LogPeriod>
 	struct TraceLogTaskSelector<MaxTaskCount, ProfileLevelEnum::Base, LogPeriod>
 	{
 		using Type = BaseTraceLogTask<MaxTaskCount, ProfileLevelEnum::Base, LogPeriod>;
 	};
 
-	template<uint8_t MaxTaskCount, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, uint32_t LogPeriod>
 	struct TraceLogTaskSelector<MaxTaskCount, ProfileLevelEnum::Full, LogPeriod>
 	{
 		using Type = FullTraceLogTask<MaxTaskCount, ProfileLevelEnum::Full, LogPeriod>;
 	};
 
+	template<task_id_t MaxTaskCount, uint32_t LogPeriod>
+	struct TraceLogTaskSelector<MaxTaskCount, ProfileLevelEnum::Latency, LogPeriod>
+	{
+		using Type = LatencyTraceLogTask<MaxTaskCount, ProfileLevelEnum::Latency, LogPeriod>;
+	};
+
 	/// <summary>
 	/// Convenience alias to obtain the trace log task type for a given ProfileLevelEnum.
 	/// Example:
 	///   using TraceLogger = TemplateTraceLogTask<MaxTaskCount, ProfileLevel, 1000>;
 	/// </summary>
-	template<uint8_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
+	template<task_id_t MaxTaskCount, ProfileLevelEnum Level, uint32_t LogPeriod>
 	using TemplateTraceLogTask = typename TraceLogTaskSelector<MaxTaskCount, Level, LogPeriod>::Type;
 }
 #endif
\ No newline at end of file